@@ -5,6 +5,8 @@
 
 #include <AppCUI/include/AppCUI.hpp>
 
+#include <functional>
+
 using namespace AppCUI::Controls;
 using namespace AppCUI::Utils;
 using namespace AppCUI::Graphics;
@@ -110,19 +112,73 @@ namespace Utils
     };
     class CORE_EXPORT DataCache
     {
+      public:
+        static constexpr uint32 MAX_PAGES = 16;
+
+        struct Statistics {
+            uint64 hits;
+            uint64 misses;
+            uint64 prefetched; // misses served by the read-ahead thread
+            uint64 readCalls;
+            uint64 bytesRead;
+        };
+
+      private:
+        struct Page {
+            uint64 start, end;
+            uint64 lastAccess;
+            uint8* data;
+            uint32 capacity;
+        };
+        struct Prefetcher;
+        struct FileLock;
+
         AppCUI::OS::DataObject* fileObj;
+        FileLock* fileLock; // serializes the reads from fileObj (shared with the views and the read-ahead thread)
+        bool isView;
         uint64 fileSize, start, end, currentPos;
-        uint8* cache;
+        uint8* cache; // data of the most recently used page (or the entire file when it is memory mapped)
+        uint8* mappedData;
         uint32 cacheSize;
+        uint32 pageSize;
+        uint32 pagesCount;
+        uint64 cacheBudget, residentSize;
+        uint64 accessTick;
+        Page pages[MAX_PAGES];
+        Statistics stats;
+        Prefetcher* prefetcher;
+        uint64 lastLoadEnd;
 
         bool CopyObject(void* buffer, uint64 offset, uint32 requestedSize);
+        void SetupPages(uint32 cacheSize, uint64 cacheBudget);
+        Page* FindPage(uint64 offset, uint32 size);
+        Page* AcquirePage(uint32 size);
+        Page* LoadPage(uint64 offset, uint32 size);
+        Page* TakePrefetchedPage(uint64 offset, uint32 size);
+        void SetActivePage(Page* page);
 
       public:
         DataCache();
         DataCache(DataCache&& obj);
         ~DataCache();
 
-        bool Init(std::unique_ptr<AppCUI::OS::DataObject> file, uint32 cacheSize);
+        // cacheSize   -> the biggest contiguous block that can be requested via Get
+        // cacheBudget -> total memory used by all resident pages (0 means 4 x cacheSize)
+        bool Init(std::unique_ptr<AppCUI::OS::DataObject> file, uint32 cacheSize, uint64 cacheBudget = 0);
+        // creates a view over the same data as 'parent' with its own pages, that can be used from another thread
+        // (same cacheSize as the parent, reads are serialized with the parent & the other views)
+        // a view must be destroyed before its parent
+        bool InitView(DataCache& parent, uint64 cacheBudget = 0);
+        // maps a regular file in memory (Get will return views straight into the mapping)
+        // if the file can not be mapped, the cache keeps reading it through the DataObject
+        bool MapFile(const std::filesystem::path& path);
+        inline bool IsMemoryMapped() const
+        {
+            return mappedData != nullptr;
+        }
+        // hint that [offset, offset+size) will be requested soon --> it is read on a background thread
+        // (sequential access is detected automatically, so this is only needed for non-sequential patterns)
+        void Prefetch(uint64 offset, uint32 size);
         BufferView Get(uint64 offset, uint32 requestedSize, bool failIfRequestedSizeCanNotBeRead);
         inline BufferView GetEntireFile()
         {
@@ -144,6 +200,18 @@ namespace Utils
         {
             return cacheSize;
         }
+        inline uint64 GetCacheBudget() const
+        {
+            return cacheBudget;
+        }
+        inline const Statistics& GetStatistics() const
+        {
+            return stats;
+        }
+        inline void ResetStatistics()
+        {
+            stats = {};
+        }
 
         inline uint64 GetSize() const
         {
@@ -198,18 +266,26 @@ namespace Utils
         Zone() : interval{ INVALID_OFFSET, INVALID_OFFSET }, color(NoColorPair), name() {};
     };
 
+    // Zones are indexed by an interval tree (rebuilt once, at the first lookup after zones were added)
     class CORE_EXPORT ZonesList
     {
         void* context{ nullptr };
 
       public:
         ZonesList();
+        ZonesList(const ZonesList& other);
+        ZonesList& operator=(const ZonesList& other);
         ~ZonesList();
 
         bool Add(uint64 start, uint64 end, AppCUI::Graphics::ColorPair c, std::string_view txt);
         bool Add(const Zone& zone);
+        bool Add(const std::vector<Zone>& zones);
+        void Reserve(uint32 count);
+        // when several zones contain the offset, the one that starts last (the innermost one) is returned
         std::optional<Zone> OffsetToZone(uint64 offset) const;
-        bool SetCache(const Zone::Interval& interval);
+        // every zone that intersects interval, sorted by start (and for the same start the larger zone first)
+        // callback returns false to stop the enumeration
+        void ForEachInRange(const Zone::Interval& interval, const std::function<bool(const Zone&)>& callback) const;
         void Clear();
         uint32 GetCount() const;
         std::optional<Zone> GetZone(uint32 index) const;
@@ -465,6 +541,60 @@ namespace Hashes
       private:
         char hexDigest[(sizeof(hash) / sizeof(hash[0])) * 2];
     };
+
+    enum class HashKind : uint8 {
+        Adler32,
+        CRC16,
+        CRC32_JAMCRC_0,
+        CRC32_JAMCRC,
+        CRC64_ECMA_182,
+        CRC64_WE,
+        MD5,
+        BLAKE2S256,
+        BLAKE2B512,
+        SHA1,
+        SHA224,
+        SHA256,
+        SHA384,
+        SHA512,
+        SHA512_224,
+        SHA512_256,
+        SHA3_224,
+        SHA3_256,
+        SHA3_384,
+        SHA3_512,
+        SHAKE128,
+        SHAKE256,
+        Count
+    };
+
+    /**
+     * \brief Computes several hashes in a single pass over the data.
+     * Every block is copied once in a shared buffer (from a bounded pool) and each selected algorithm consumes it on
+     * its own worker thread. Workers are started by the first Update and stopped by Final / Cancel.
+     */
+    class CORE_EXPORT MultiHash
+    {
+        void* context;
+
+      public:
+        MultiHash();
+        ~MultiHash();
+
+        bool Add(HashKind kind);
+        bool Update(const uint8* data, uint32 size);
+        /**
+         * \brief Hashes [offset, offset+size) from a data cache.
+         * \param onProgress called after every block with the number of bytes processed so far, returning false cancels the operation
+         */
+        bool Update(Utils::DataCache& cache, uint64 offset, uint64 size, const std::function<bool(uint64)>& onProgress = nullptr);
+        bool Final();
+        void Cancel();
+
+        bool IsSelected(HashKind kind) const;
+        std::string_view GetHexValue(HashKind kind) const;
+        static std::string_view GetName(HashKind kind);
+    };
 } // namespace Hashes
 
 namespace DigitalSignature
@@ -939,12 +1069,108 @@ namespace Regex
 
         bool Match(BufferView buffer, uint64& start, uint64& end);
     };
+
+    // many expressions compiled into a single automaton (RE2::Set) -> the buffer is scanned once for all of them
+    // and the positions are computed afterwards only for the expressions that matched
+    struct CORE_EXPORT MultiMatcher {
+        struct Result {
+            uint32 id;
+            uint64 start;
+            uint64 end;
+        };
+
+      private:
+        void* context{ nullptr };
+
+      public:
+        // anchored -> the expressions must match at the start of the buffer
+        bool Init(bool isCaseSensitive, bool anchored = false);
+        MultiMatcher() = default;
+        ~MultiMatcher();
+
+        // ids are given in the order the expressions are added (0, 1, ...)
+        bool Add(std::string_view expression, uint32& id);
+        bool Compile();
+        uint32 GetCount() const;
+
+        // ids of all the expressions that match somewhere in the buffer (sorted)
+        bool Match(BufferView buffer, std::vector<uint32>& ids);
+        // leftmost match of expression 'id'
+        bool Match(BufferView buffer, uint32 id, uint64& start, uint64& end);
+        // every (non overlapping) match of every expression, sorted by start offset
+        bool FindAll(BufferView buffer, std::vector<Result>& results);
+        // FindAll over [offset, offset + size) read through the cache, chunk by chunk;
+        // consecutive chunks overlap with maxMatchSize bytes -> longer matches that cross a chunk border are truncated
+        // onMatch returns false to stop the scan
+        bool Scan(Utils::DataCache& cache, uint64 offset, uint64 size, uint32 maxMatchSize, const std::function<bool(const Result&)>& onMatch);
+    };
 } // namespace Regex
 
 namespace Entropy
 {
     CORE_EXPORT double ShannonEntropy(const BufferView& buffer);
     CORE_EXPORT double RenyiEntropy(const BufferView& buffer, double alpha);
+
+    // byte frequencies (32 bit counters)
+    struct CORE_EXPORT Histogram {
+        uint32 counts[256]{};
+        uint64 total{ 0 };
+
+        void Clear();
+        void Add(const BufferView& buffer);
+        // merges the frequencies of another histogram (the histogram of the concatenated data)
+        void Add(const Histogram& other);
+        inline void Add(uint8 value)
+        {
+            counts[value]++;
+            total++;
+        }
+        inline void Remove(uint8 value)
+        {
+            counts[value]--;
+            total--;
+        }
+
+        double ShannonEntropy() const;
+        double RenyiEntropy(double alpha) const;
+    };
+
+    // Shannon entropy of a window of fixed size that is moved one byte at a time
+    // (the histogram and the entropy are updated in O(1) for every byte instead of being recomputed)
+    class CORE_EXPORT SlidingWindow
+    {
+        Histogram histogram;
+        std::vector<double> weights; // c * log2(c) for every possible count of a byte in the window
+        double sum{ 0.0 };           // sum of the weights of the current histogram
+        uint32 windowSize{ 0 };
+
+      public:
+        bool Init(uint32 windowSize);
+        // window.GetLength() must be the size of the window
+        bool Reset(const BufferView& window);
+        inline void Slide(uint8 removed, uint8 added)
+        {
+            if (removed == added)
+                return;
+            sum -= weights[histogram.counts[removed]] + weights[histogram.counts[added]];
+            histogram.counts[removed]--;
+            histogram.counts[added]++;
+            sum += weights[histogram.counts[removed]] + weights[histogram.counts[added]];
+        }
+        double GetShannonEntropy() const;
+        inline const Histogram& GetHistogram() const
+        {
+            return histogram;
+        }
+    };
+
+    // entropy of every block of blockSize bytes from [offset, offset + size) (the last block may be smaller)
+    // alpha == 1.0 means Shannon entropy, any other value Renyi entropy of order alpha
+    CORE_EXPORT bool ComputeBlocks(
+          Utils::DataCache& cache, uint64 offset, uint64 size, uint32 blockSize, std::vector<double>& entropies, double alpha = 1.0);
+    // Shannon entropy of a window of windowSize bytes placed every step bytes in [offset, offset + size)
+    CORE_EXPORT bool ComputeSlidingWindow(
+          Utils::DataCache& cache, uint64 offset, uint64 size, uint32 windowSize, uint32 step, std::vector<double>& entropies);
 } // namespace Entropy
 
 /*
@@ -1027,6 +1253,9 @@ namespace View
 
     struct CORE_EXPORT BufferColorInterface {
         virtual bool GetColorForByteAt(uint64 offset, const ViewData& vd, ColorPair& cp) = 0;
+        // colors for all the bytes of buffer (found at offset) at once: colors[i] is set to NoColorPair if no color is provided for offset + i
+        // returns false if no byte is colored (the default implementation calls GetColorForByteAt for every byte)
+        virtual bool GetColorsForRange(uint64 offset, BufferView buffer, const ViewData& vd, ColorPair* colors);
     };
 
     struct CORE_EXPORT OnStartViewMoveInterface {
@@ -1109,6 +1338,33 @@ namespace View
             virtual uint64_t TranslateFromFileOffset(uint64 value, uint32 toTranslationIndex) = 0;
         };
 
+        // zones computed on demand (instead of adding them one by one with Settings::AddZone)
+        struct CORE_EXPORT ZonesProviderInterface {
+            // the innermost zone that contains the offset
+            virtual std::optional<GView::Utils::Zone> OffsetToZone(uint64 offset) = 0;
+            // every zone that intersects interval, sorted by start (callback returns false to stop the enumeration)
+            virtual void ForEachZoneInRange(
+                  const GView::Utils::Zone::Interval& interval, const std::function<bool(const GView::Utils::Zone&)>& callback) = 0;
+        };
+
+        // one zone per line (named after the line index); the line offsets are indexed lazily, only up to the last
+        // requested offset
+        class CORE_EXPORT LineZonesProvider : public ZonesProviderInterface
+        {
+            void* context;
+
+          public:
+            LineZonesProvider();
+            LineZonesProvider(const LineZonesProvider&)            = delete;
+            LineZonesProvider& operator=(const LineZonesProvider&) = delete;
+            ~LineZonesProvider();
+
+            void Init(GView::Utils::DataCache& cache, ColorPair color);
+            std::optional<GView::Utils::Zone> OffsetToZone(uint64 offset) override;
+            void ForEachZoneInRange(
+                  const GView::Utils::Zone::Interval& interval, const std::function<bool(const GView::Utils::Zone&)>& callback) override;
+        };
+
         struct CORE_EXPORT Settings {
             void* data;
 
@@ -1119,6 +1375,7 @@ namespace View
             void AddBookmark(uint8 bookmarkID, uint64 fileOffset);
             void SetOffsetTranslationList(std::initializer_list<std::string_view> list, Reference<OffsetTranslateInterface> cbk);
             void SetPositionToColorCallback(Reference<PositionToColorInterface> cbk);
+            void SetZonesProvider(Reference<ZonesProviderInterface> provider);
             void SetEntryPointOffset(uint64 offset);
             bool SetName(std::string_view name);
 
@@ -1596,6 +1853,12 @@ namespace View
              */
             void SetDefaultDisassemblyLanguage(DisassemblyLanguage lang);
             void AddDisassemblyZone(uint64 zoneStart, uint64 zoneSize, uint64 zoneDissasmStartPoint, DisassemblyLanguage lang = DisassemblyLanguage::Default);
+            /**
+             * \brief Adds a known function start (for example an exported function) that the control flow analysis of the disassembly zones
+             * will follow besides the zone entry point and the discovered call targets.
+             * \param offset The file offset of the function.
+             */
+            void AddCodeEntryPoint(uint64 offset);
 
             void AddMemoryMapping(uint64 address, std::string_view name, MemoryMappingType mappingType);
             void AddCollapsibleZone(uint64 offset, uint64 size);
@@ -14,7 +14,8 @@ using namespace AppCUI::Utils;
 
 GView::App::Instance* gviewAppInstance = nullptr;
 
-constexpr uint32 DEFAULT_CACHE_SIZE = 0xA00000; // 10 MB // sync this with the one from App/Instance.cpp
+constexpr uint32 DEFAULT_CACHE_SIZE   = 0xA00000;  // 10 MB // sync this with the one from App/Instance.cpp
+constexpr uint64 DEFAULT_CACHE_BUDGET = 0x2800000; // 40 MB // sync this with the one from App/Instance.cpp
 
 bool UpdateSettingsForTypePlugin(AppCUI::Utils::IniObject& ini, const std::filesystem::path& pluginPath)
 {
@@ -100,7 +101,9 @@ bool GView::App::ResetConfiguration()
     }
 
     // generic GView settings
-    ini["GView"]["CacheSize"]        = DEFAULT_CACHE_SIZE;
+    ini["GView"]["CacheSize"]          = DEFAULT_CACHE_SIZE;
+    ini["GView"]["Config.CacheBudget"] = DEFAULT_CACHE_BUDGET;
+    ini["GView"]["Config.MemoryMappedFiles"] = true;
 
     const std::array<std::reference_wrapper<KeyboardControl>, 6> localKeys = {
         InstanceCommands::INSTANCE_CHANGE_VIEW,     InstanceCommands::INSTANCE_SWITCH_TO_VIEW, InstanceCommands::INSTANCE_COMMAND_GOTO,
@@ -10,10 +10,12 @@ using namespace AppCUI::Utils;
 
 constexpr uint32 DEFAULT_CACHE_SIZE    = 0xA00000; // 10 MB
 constexpr uint32 MIN_CACHE_SIZE        = 0x10000;  // 64 K
+constexpr uint64 DEFAULT_CACHE_BUDGET  = 0x2800000; // 40 MB
 constexpr uint32 GENERIC_PLUGINS_CMDID = 40000000;
 constexpr uint32 GENERIC_PLUGINS_FRAME = 100;
 
-constexpr uint32 CACHE_SIZE_PROPERTY_ID = 1;
+constexpr uint32 CACHE_SIZE_PROPERTY_ID   = 1;
+constexpr uint32 CACHE_BUDGET_PROPERTY_ID = 2;
 
 struct GViewMenuCommand {
     std::string_view name;
@@ -73,6 +75,8 @@ bool AddMenuCommands(Menu* mnu, const GViewMenuCommand* list, size_t count)
 Instance::Instance()
 {
     this->defaultCacheSize         = DEFAULT_CACHE_SIZE;
+    this->defaultCacheBudget       = DEFAULT_CACHE_BUDGET;
+    this->useMemoryMappedFiles     = true;
     this->mnuWindow                = nullptr;
     this->mnuHelp                  = nullptr;
     this->mnuFile                  = nullptr;
@@ -110,6 +114,8 @@ bool Instance::LoadSettings()
     // read instance settings
     auto sect                                  = ini->GetSection("GView");
     this->defaultCacheSize                     = std::max<>(sect.GetValue("Config.CacheSize").ToUInt32(DEFAULT_CACHE_SIZE), MIN_CACHE_SIZE);
+    this->defaultCacheBudget                   = std::max<uint64>(sect.GetValue("Config.CacheBudget").ToUInt64(DEFAULT_CACHE_BUDGET), this->defaultCacheSize);
+    this->useMemoryMappedFiles                 = sect.GetValue("Config.MemoryMappedFiles").ToBool(true);
 
     LocalString<64> keyCommand;
     for (auto& k : GViewCommands) {
@@ -366,11 +372,14 @@ bool Instance::Add(
       const ConstString& creationProcess)
 {
     GView::Utils::DataCache cache;
-    CHECK(cache.Init(std::move(data), this->defaultCacheSize), false, "Fail to instantiate cache object");
+    CHECK(cache.Init(std::move(data), this->defaultCacheSize, this->defaultCacheBudget), false, "Fail to instantiate cache object");
 
     // extract extension
     LocalUnicodeStringBuilder<256> temp;
     CHECK(temp.Set(path), false, "Fail to get path object");
+    // regular files are mapped in memory (if this fails, the cache will read them through the data object)
+    if ((objType == GView::Object::Type::File) && (this->useMemoryMappedFiles))
+        cache.MapFile(std::filesystem::path(temp.ToStringView()));
     // search for the last "."
     auto pos = temp.ToStringView().find_last_of('.');
     auto extHash =
@@ -596,6 +605,10 @@ bool Instance::GetPropertyValue(uint32 propertyID, PropertyValue& value)
         value = this->defaultCacheSize;
         return true;
     }
+    if (propertyID == CACHE_BUDGET_PROPERTY_ID) {
+        value = this->defaultCacheBudget;
+        return true;
+    }
     for (const auto& key : GViewCommands) {
         if (key->CommandId == propertyID) {
             value = key->Key;
@@ -616,6 +629,15 @@ bool Instance::SetPropertyValue(uint32 propertyID, const PropertyValue& value, S
         this->defaultCacheSize = newCacheSize;
         return true;
     }
+    if (propertyID == CACHE_BUDGET_PROPERTY_ID) {
+        const uint64 newCacheBudget = std::get<uint64>(value);
+        if (newCacheBudget < this->defaultCacheSize) {
+            error.SetFormat("Cache budget must be at least as big as the cache size (%u bytes)", this->defaultCacheSize);
+            return false;
+        }
+        this->defaultCacheBudget = newCacheBudget;
+        return true;
+    }
     for (const auto& key : GViewCommands) {
         if (key->CommandId == propertyID) {
             key->Key = std::get<Key>(value);
@@ -635,6 +657,7 @@ const vector<Property> Instance::GetPropertiesList()
 {
     std::vector<Property> properties = {
         { CACHE_SIZE_PROPERTY_ID, "Config", "CacheSize", PropertyType::UInt32 },
+        { CACHE_BUDGET_PROPERTY_ID, "Config", "CacheBudget", PropertyType::UInt64 },
     };
 
     properties.reserve(properties.size() + GViewCommands.size());
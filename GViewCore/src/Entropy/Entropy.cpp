@@ -2,18 +2,64 @@
 
 #include <math.h>
 #include <array>
+#include <cstring>
 
-constexpr uint32 MAX_NUMBER_OF_BYTES = 256;
+constexpr uint32 MAX_NUMBER_OF_BYTES  = 256;
+constexpr uint32 MULTI_TABLE_COUNT    = 4;
+constexpr uint32 MULTI_TABLE_MIN_SIZE = 256; // smaller buffers are counted directly
 
 namespace GView::Entropy
 {
-void SetFrequencies(const BufferView& buffer, std::array<char, MAX_NUMBER_OF_BYTES>& frequency)
+void Histogram::Clear()
 {
-    // Count frequency of each byte in the buffer
-    for (uint32 i = 0; i < buffer.GetLength(); i++) {
-        const auto c = buffer[i];
-        frequency[c]++;
+    memset(counts, 0, sizeof(counts));
+    total = 0;
+}
+
+void Histogram::Add(const BufferView& buffer)
+{
+    const auto* data  = buffer.GetData();
+    const auto length = buffer.GetLength();
+    total += length;
+
+    if (length < MULTI_TABLE_MIN_SIZE) {
+        for (size_t i = 0; i < length; i++) {
+            counts[data[i]]++;
+        }
+        return;
     }
+
+    // runs of the same byte are common (padding, zeroes) -> consecutive bytes go to different tables
+    // so that the increments do not wait for each other (store to load forwarding on the same counter)
+    uint32 tables[MULTI_TABLE_COUNT][MAX_NUMBER_OF_BYTES]{};
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64 v;
+        memcpy(&v, data + i, sizeof(v));
+        tables[0][static_cast<uint8>(v)]++;
+        tables[1][static_cast<uint8>(v >> 8)]++;
+        tables[2][static_cast<uint8>(v >> 16)]++;
+        tables[3][static_cast<uint8>(v >> 24)]++;
+        tables[0][static_cast<uint8>(v >> 32)]++;
+        tables[1][static_cast<uint8>(v >> 40)]++;
+        tables[2][static_cast<uint8>(v >> 48)]++;
+        tables[3][static_cast<uint8>(v >> 56)]++;
+    }
+    for (; i < length; i++) {
+        tables[0][data[i]]++;
+    }
+
+    for (uint32 j = 0; j < MAX_NUMBER_OF_BYTES; j++) {
+        counts[j] += tables[0][j] + tables[1][j] + tables[2][j] + tables[3][j];
+    }
+}
+
+void Histogram::Add(const Histogram& other)
+{
+    for (uint32 i = 0; i < MAX_NUMBER_OF_BYTES; i++) {
+        counts[i] += other.counts[i];
+    }
+    total += other.total;
 }
 
 /*
@@ -27,14 +73,18 @@ void SetFrequencies(const BufferView& buffer, std::array<char, MAX_NUMBER_OF_BYT
     The joint entropy of variables X_1, ..., X_n is then defined by
     H(X_1, ..., X_n) congruent - sum_(x_1) ... sum_(x_n) P(x_1, ..., x_n) log_2[P(x_1, ..., x_n)].
 */
-double ShannonEntropy_private(const BufferView& buffer, std::array<char, MAX_NUMBER_OF_BYTES>& frequency)
+double Histogram::ShannonEntropy() const
 {
+    if (total == 0) {
+        return 0.0;
+    }
+
     double entropy = 0.0;
-    for (auto f : frequency) {
+    for (auto f : counts) {
         if (f == 0) {
             continue;
         }
-        double probability = static_cast<double>(f) / buffer.GetLength();
+        double probability = static_cast<double>(f) / total;
         entropy -= probability * log2(probability);
     }
 
@@ -43,9 +93,9 @@ double ShannonEntropy_private(const BufferView& buffer, std::array<char, MAX_NUM
 
 double ShannonEntropy(const BufferView& buffer)
 {
-    std::array<char, MAX_NUMBER_OF_BYTES> frequency{};
-    SetFrequencies(buffer, frequency);
-    return ShannonEntropy_private(buffer, frequency);
+    Histogram histogram;
+    histogram.Add(buffer);
+    return histogram.ShannonEntropy();
 }
 
 /*
@@ -56,19 +106,19 @@ double ShannonEntropy(const BufferView& buffer)
     H_α(p_1, p_2, ..., p_n)<=H_α'(p_1, p_2, ..., p_n)
     for α<=α'.
 */
-double RenyiEntropy(const BufferView& buffer, double alpha)
+double Histogram::RenyiEntropy(double alpha) const
 {
-    std::array<char, MAX_NUMBER_OF_BYTES> frequency{};
-    SetFrequencies(buffer, frequency);
-
     if (alpha == 1.0) {
-        return ShannonEntropy_private(buffer, frequency);
+        return ShannonEntropy();
+    }
+    if (total == 0) {
+        return 0.0;
     }
 
     double sum = 0.0;
-    for (auto f : frequency) {
+    for (auto f : counts) {
         if (f > 0) {
-            const double probability = static_cast<double>(f) / buffer.GetLength();
+            const double probability = static_cast<double>(f) / total;
             sum += pow(probability, alpha);
         }
     }
@@ -77,4 +127,138 @@ double RenyiEntropy(const BufferView& buffer, double alpha)
     // return std::max(((1.0 / (1.0 - alpha)) * log(sum)) / log(2), 0.0);
     return ((1.0 / (1.0 - alpha)) * log(sum)) / log(2);
 }
+
+double RenyiEntropy(const BufferView& buffer, double alpha)
+{
+    Histogram histogram;
+    histogram.Add(buffer);
+    return histogram.RenyiEntropy(alpha);
+}
+
+/*
+    For a window of n bytes where byte x appears c_x times:
+    H = - sum_x (c_x / n) log2(c_x / n) = log2(n) - (1 / n) sum_x c_x log2(c_x)
+    so moving the window only changes the terms of the byte that leaves and of the byte that enters.
+*/
+bool SlidingWindow::Init(uint32 _windowSize)
+{
+    CHECK(_windowSize > 0, false, "");
+
+    windowSize = _windowSize;
+    weights.resize(static_cast<size_t>(windowSize) + 1);
+    weights[0] = 0.0;
+    for (uint32 c = 1; c <= windowSize; c++) {
+        weights[c] = c * log2(static_cast<double>(c));
+    }
+    histogram.Clear();
+    sum = 0.0;
+
+    return true;
+}
+
+bool SlidingWindow::Reset(const BufferView& window)
+{
+    CHECK(windowSize > 0, false, "Init was not called !");
+    CHECK(window.GetLength() == windowSize, false, "");
+
+    histogram.Clear();
+    histogram.Add(window);
+    sum = 0.0;
+    for (auto c : histogram.counts) {
+        sum += weights[c];
+    }
+
+    return true;
+}
+
+double SlidingWindow::GetShannonEntropy() const
+{
+    CHECK(windowSize > 0, 0.0, "");
+    return std::max<double>(0.0, log2(static_cast<double>(windowSize)) - sum / windowSize);
+}
+
+static bool AddRange(Utils::DataCache& cache, uint64 offset, uint64 size, Histogram& histogram)
+{
+    // blocks larger than the cache are read in several steps
+    while (size > 0) {
+        const auto buffer = cache.Get(offset, static_cast<uint32>(std::min<uint64>(size, cache.GetCacheSize())), false);
+        CHECK(buffer.GetLength() > 0, false, "");
+        histogram.Add(buffer);
+        offset += buffer.GetLength();
+        size -= buffer.GetLength();
+    }
+    return true;
+}
+
+bool ComputeBlocks(Utils::DataCache& cache, uint64 offset, uint64 size, uint32 blockSize, std::vector<double>& entropies, double alpha)
+{
+    CHECK(blockSize > 0, false, "");
+    CHECK(offset <= cache.GetSize(), false, "");
+
+    const auto end = offset + std::min<uint64>(size, cache.GetSize() - offset);
+    entropies.clear();
+    entropies.reserve(static_cast<size_t>((end - offset + blockSize - 1) / blockSize));
+
+    Histogram histogram;
+    for (auto pos = offset; pos < end; pos += blockSize) {
+        histogram.Clear();
+        CHECK(AddRange(cache, pos, std::min<uint64>(blockSize, end - pos), histogram), false, "");
+        entropies.push_back(histogram.RenyiEntropy(alpha));
+    }
+
+    return true;
+}
+
+bool ComputeSlidingWindow(Utils::DataCache& cache, uint64 offset, uint64 size, uint32 windowSize, uint32 step, std::vector<double>& entropies)
+{
+    CHECK(windowSize > 0 && step > 0, false, "");
+    CHECK(offset <= cache.GetSize(), false, "");
+
+    const auto end = offset + std::min<uint64>(size, cache.GetSize() - offset);
+    entropies.clear();
+    CHECK(end - offset >= windowSize, false, "");
+    const auto last = end - windowSize; // start of the last window
+    entropies.reserve(static_cast<size_t>((last - offset) / step + 1));
+
+    // windows that do not overlap (or that do not fit twice in the cache) are counted from scratch
+    if (step >= windowSize || windowSize > cache.GetCacheSize() / 2) {
+        Histogram histogram;
+        for (auto pos = offset; pos <= last; pos += step) {
+            histogram.Clear();
+            CHECK(AddRange(cache, pos, windowSize, histogram), false, "");
+            entropies.push_back(histogram.ShannonEntropy());
+        }
+        return true;
+    }
+
+    SlidingWindow window;
+    CHECK(window.Init(windowSize), false, "");
+    auto buffer = cache.Get(offset, windowSize, true);
+    CHECK(buffer.IsValid(), false, "");
+    CHECK(window.Reset(buffer), false, "");
+    entropies.push_back(window.GetShannonEntropy());
+
+    // every chunk holds the bytes that leave the window ([pos, pos + count)) and the ones that enter it
+    uint32 untilNext = step;
+    for (auto pos = offset; pos < last;) {
+        const auto count = static_cast<size_t>(std::min<uint64>(cache.GetCacheSize() - windowSize, last - pos));
+        buffer           = cache.Get(pos, static_cast<uint32>(count + windowSize), true);
+        CHECK(buffer.IsValid(), false, "");
+
+        const auto* data = buffer.GetData();
+        for (size_t i = 0; i < count; i++) {
+            window.Slide(data[i], data[i + windowSize]);
+            if (--untilNext == 0) {
+                entropies.push_back(window.GetShannonEntropy());
+                untilNext = step;
+            }
+        }
+
+        // recompute the sum from the histogram -> the rounding errors do not accumulate over the entire range
+        CHECK(window.Reset(BufferView(data + count, windowSize)), false, "");
+        pos += count;
+    }
+
+    return true;
+}
 } // namespace GView::Entropy
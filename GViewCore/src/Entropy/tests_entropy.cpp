@@ -0,0 +1,92 @@
+#include <catch.hpp>
+#include "Internal.hpp"
+#include <random>
+#include <vector>
+
+using namespace GView::Entropy;
+
+static std::vector<uint8> CreateBuffer(size_t size, uint32 alphabet)
+{
+    std::mt19937 gen(0x454E5452);
+    std::vector<uint8> buffer(size);
+    for (auto& b : buffer)
+        b = static_cast<uint8>(gen() % alphabet);
+    return buffer;
+}
+
+static double NaiveEntropy(const uint8* data, size_t size)
+{
+    std::vector<uint64> counts(256);
+    for (size_t i = 0; i < size; i++)
+        counts[data[i]]++;
+    double entropy = 0.0;
+    for (auto c : counts)
+    {
+        if (c > 0)
+        {
+            const double p = static_cast<double>(c) / size;
+            entropy -= p * log2(p);
+        }
+    }
+    return entropy;
+}
+
+TEST_CASE("EntropyValues", "[Entropy]Histogram")
+{
+    // more than 127 occurrences of the same byte
+    std::vector<uint8> zeroes(0x10000, 0);
+    REQUIRE(ShannonEntropy(BufferView{ zeroes.data(), zeroes.size() }) == Approx(0.0));
+
+    std::vector<uint8> uniform(256 * 1000);
+    for (size_t i = 0; i < uniform.size(); i++)
+        uniform[i] = static_cast<uint8>(i);
+    REQUIRE(ShannonEntropy(BufferView{ uniform.data(), uniform.size() }) == Approx(8.0));
+    REQUIRE(RenyiEntropy(BufferView{ uniform.data(), uniform.size() }, 2.0) == Approx(8.0));
+
+    std::vector<uint8> halves(1000, 'A');
+    std::fill(halves.begin() + 500, halves.end(), 'B');
+    REQUIRE(ShannonEntropy(BufferView{ halves.data(), halves.size() }) == Approx(1.0));
+
+    const auto random = CreateBuffer(100003, 37);
+    Histogram histogram;
+    histogram.Add(BufferView{ random.data(), random.size() });
+    REQUIRE(histogram.total == random.size());
+    REQUIRE(histogram.ShannonEntropy() == Approx(NaiveEntropy(random.data(), random.size())));
+    REQUIRE(histogram.RenyiEntropy(1.0) == histogram.ShannonEntropy());
+
+    // histogram of two halves == histogram of the whole buffer
+    Histogram left, right;
+    left.Add(BufferView{ random.data(), 50000 });
+    right.Add(BufferView{ random.data() + 50000, random.size() - 50000 });
+    left.Add(right);
+    REQUIRE(left.total == histogram.total);
+    REQUIRE(std::equal(std::begin(left.counts), std::end(left.counts), std::begin(histogram.counts)));
+}
+
+TEST_CASE("EntropySlidingWindow", "[Entropy]SlidingWindow")
+{
+    auto data = CreateBuffer(0x30000, 256);
+    std::fill(data.begin() + 0x8000, data.begin() + 0x9000, 0); // low entropy area
+
+    auto memoryFile = std::make_unique<AppCUI::OS::MemoryFile>();
+    REQUIRE(memoryFile->Create(data.data(), data.size()));
+    GView::Utils::DataCache cache;
+    REQUIRE(cache.Init(std::move(memoryFile), 0x10000));
+
+    constexpr uint32 windowSize = 1000;
+    constexpr uint32 step       = 7;
+    std::vector<double> entropies;
+    REQUIRE(ComputeSlidingWindow(cache, 5, data.size() - 5, windowSize, step, entropies));
+    REQUIRE(entropies.size() == (data.size() - 5 - windowSize) / step + 1);
+    for (size_t i = 0; i < entropies.size(); i++)
+        REQUIRE(entropies[i] == Approx(NaiveEntropy(data.data() + 5 + i * step, windowSize)).margin(1e-9));
+
+    std::vector<double> blocks;
+    REQUIRE(ComputeBlocks(cache, 0, data.size(), 0x1800, blocks));
+    REQUIRE(blocks.size() == (data.size() + 0x17FF) / 0x1800);
+    for (size_t i = 0; i < blocks.size(); i++)
+    {
+        const auto size = std::min<size_t>(0x1800, data.size() - i * 0x1800);
+        REQUIRE(blocks[i] == Approx(NaiveEntropy(data.data() + i * 0x1800, size)));
+    }
+}
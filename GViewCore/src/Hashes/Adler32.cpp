@@ -1,9 +1,12 @@
-#include "Internal.hpp"
+#include "HashKernels.hpp"
+#include "CpuFeatures.hpp"
 
 namespace GView::Hashes
 {
-constexpr uint32 ADLER32_BASE         = 65521;
-constexpr uint32 ADLER32_MODULO_VALUE = 8;
+constexpr uint32 ADLER32_BASE            = 65521;
+constexpr uint32 ADLER32_MODULO_VALUE    = 8;
+constexpr uint32 ADLER32_NMAX            = 5552; // largest n such that 255n(n+1)/2 + (n+1)(BASE-1) <= 2^32-1
+constexpr uint32 ADLER32_SIMD_BLOCK_SIZE = 32;
 
 bool Adler32::Init()
 {
@@ -15,57 +18,190 @@ bool Adler32::Init()
     return true;
 }
 
-bool Adler32::Update(const unsigned char* input, uint32 length)
+namespace Kernels
 {
-    CHECK(input != nullptr, false, "");
+    uint32 Adler32_Scalar(uint32 adler, const uint8* input, size_t length)
+    {
+        uint32 s1 = adler & 0xFFFF;
+        uint32 s2 = adler >> 16;
+
+        // the modulo is applied only once every ADLER32_NMAX bytes (the largest block for which s2 can not overflow)
+        while (length > 0)
+        {
+            auto n = std::min<size_t>(length, ADLER32_NMAX);
+            length -= n;
+
+            while (n >= ADLER32_MODULO_VALUE)
+            {
+                s1 += input[0];
+                s2 += s1;
+                s1 += input[1];
+                s2 += s1;
+                s1 += input[2];
+                s2 += s1;
+                s1 += input[3];
+                s2 += s1;
+                s1 += input[4];
+                s2 += s1;
+                s1 += input[5];
+                s2 += s1;
+                s1 += input[6];
+                s2 += s1;
+                s1 += input[7];
+                s2 += s1;
+
+                n -= ADLER32_MODULO_VALUE;
+                input += ADLER32_MODULO_VALUE;
+            }
+            while (n > 0)
+            {
+                s1 += *input++;
+                s2 += s1;
+                n--;
+            }
+
+            s1 %= ADLER32_BASE;
+            s2 %= ADLER32_BASE;
+        }
 
-    uint32 s1 = a;
-    uint32 s2 = b;
+        return (s2 << 16) | s1;
+    }
 
-    if (length % ADLER32_MODULO_VALUE != 0)
+    bool Adler32_HasSSSE3()
     {
-        do
-        {
-            s1 += *input++;
-            s2 += s1;
-            length--;
-        } while (length % ADLER32_MODULO_VALUE != 0);
+        return Utils::CPU::GetFeatures().ssse3;
+    }
+
+    bool Adler32_HasAVX2()
+    {
+        return Utils::CPU::GetFeatures().avx2;
+    }
 
-        if (s1 >= ADLER32_BASE)
+#if defined(GVIEW_X86_SIMD)
+    // every 32 bytes block adds to s2: 32 * s1 (s1 from before the block) + 32 * p[0] + 31 * p[1] + ... + 1 * p[31]
+    // the sum of the s1 values before each block is kept in 'ps' and multiplied by 32 only when the modulo is applied
+    GVIEW_TARGET("ssse3") uint32 Adler32_SSSE3(uint32 adler, const uint8* input, size_t length)
+    {
+        uint32 s1 = adler & 0xFFFF;
+        uint32 s2 = adler >> 16;
+
+        auto blocks = length / ADLER32_SIMD_BLOCK_SIZE;
+        length -= blocks * ADLER32_SIMD_BLOCK_SIZE;
+
+        const __m128i tap1 = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17);
+        const __m128i tap2 = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i ones = _mm_set1_epi16(1);
+
+        while (blocks > 0)
         {
-            s1 -= ADLER32_BASE;
+            auto n = std::min<size_t>(blocks, ADLER32_NMAX / ADLER32_SIMD_BLOCK_SIZE);
+            blocks -= n;
+
+            __m128i ps = _mm_cvtsi32_si128(static_cast<int>(s1 * n));
+            __m128i v2 = _mm_cvtsi32_si128(static_cast<int>(s2));
+            __m128i v1 = zero;
+
+            do
+            {
+                const __m128i bytes1 = _mm_loadu_si128((const __m128i*) (input));
+                const __m128i bytes2 = _mm_loadu_si128((const __m128i*) (input + 16));
+
+                ps = _mm_add_epi32(ps, v1);
+                v1 = _mm_add_epi32(v1, _mm_sad_epu8(bytes1, zero));
+                v2 = _mm_add_epi32(v2, _mm_madd_epi16(_mm_maddubs_epi16(bytes1, tap1), ones));
+                v1 = _mm_add_epi32(v1, _mm_sad_epu8(bytes2, zero));
+                v2 = _mm_add_epi32(v2, _mm_madd_epi16(_mm_maddubs_epi16(bytes2, tap2), ones));
+
+                input += ADLER32_SIMD_BLOCK_SIZE;
+            } while (--n);
+
+            v2 = _mm_add_epi32(v2, _mm_slli_epi32(ps, 5));
+
+            v1 = _mm_add_epi32(v1, _mm_shuffle_epi32(v1, _MM_SHUFFLE(2, 3, 0, 1)));
+            v1 = _mm_add_epi32(v1, _mm_shuffle_epi32(v1, _MM_SHUFFLE(1, 0, 3, 2)));
+            v2 = _mm_add_epi32(v2, _mm_shuffle_epi32(v2, _MM_SHUFFLE(2, 3, 0, 1)));
+            v2 = _mm_add_epi32(v2, _mm_shuffle_epi32(v2, _MM_SHUFFLE(1, 0, 3, 2)));
+
+            s1 = (s1 + static_cast<uint32>(_mm_cvtsi128_si32(v1))) % ADLER32_BASE;
+            s2 = static_cast<uint32>(_mm_cvtsi128_si32(v2)) % ADLER32_BASE;
         }
-        s2 %= ADLER32_BASE;
+
+        return Adler32_Scalar((s2 << 16) | s1, input, length);
     }
 
-    while (length > 0)
+    GVIEW_TARGET("avx2") uint32 Adler32_AVX2(uint32 adler, const uint8* input, size_t length)
     {
-        s1 += input[0];
-        s2 += s1;
-        s1 += input[1];
-        s2 += s1;
-        s1 += input[2];
-        s2 += s1;
-        s1 += input[3];
-        s2 += s1;
-        s1 += input[4];
-        s2 += s1;
-        s1 += input[5];
-        s2 += s1;
-        s1 += input[6];
-        s2 += s1;
-        s1 += input[7];
-        s2 += s1;
-
-        length -= ADLER32_MODULO_VALUE;
-        input += ADLER32_MODULO_VALUE;
-
-        if (s1 >= ADLER32_BASE)
+        uint32 s1 = adler & 0xFFFF;
+        uint32 s2 = adler >> 16;
+
+        auto blocks = length / ADLER32_SIMD_BLOCK_SIZE;
+        length -= blocks * ADLER32_SIMD_BLOCK_SIZE;
+
+        const __m256i tap = _mm256_setr_epi8(
+              32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i ones = _mm256_set1_epi16(1);
+
+        while (blocks > 0)
         {
-            s1 -= ADLER32_BASE;
+            auto n = std::min<size_t>(blocks, ADLER32_NMAX / ADLER32_SIMD_BLOCK_SIZE);
+            blocks -= n;
+
+            __m256i ps = _mm256_setr_epi32(static_cast<int>(s1 * n), 0, 0, 0, 0, 0, 0, 0);
+            __m256i v2 = _mm256_setr_epi32(static_cast<int>(s2), 0, 0, 0, 0, 0, 0, 0);
+            __m256i v1 = zero;
+
+            do
+            {
+                const __m256i bytes = _mm256_loadu_si256((const __m256i*) input);
+
+                ps = _mm256_add_epi32(ps, v1);
+                v1 = _mm256_add_epi32(v1, _mm256_sad_epu8(bytes, zero));
+                v2 = _mm256_add_epi32(v2, _mm256_madd_epi16(_mm256_maddubs_epi16(bytes, tap), ones));
+
+                input += ADLER32_SIMD_BLOCK_SIZE;
+            } while (--n);
+
+            v2 = _mm256_add_epi32(v2, _mm256_slli_epi32(ps, 5));
+
+            __m128i h1 = _mm_add_epi32(_mm256_castsi256_si128(v1), _mm256_extracti128_si256(v1, 1));
+            __m128i h2 = _mm_add_epi32(_mm256_castsi256_si128(v2), _mm256_extracti128_si256(v2, 1));
+            h1         = _mm_add_epi32(h1, _mm_shuffle_epi32(h1, _MM_SHUFFLE(2, 3, 0, 1)));
+            h1         = _mm_add_epi32(h1, _mm_shuffle_epi32(h1, _MM_SHUFFLE(1, 0, 3, 2)));
+            h2         = _mm_add_epi32(h2, _mm_shuffle_epi32(h2, _MM_SHUFFLE(2, 3, 0, 1)));
+            h2         = _mm_add_epi32(h2, _mm_shuffle_epi32(h2, _MM_SHUFFLE(1, 0, 3, 2)));
+
+            s1 = (s1 + static_cast<uint32>(_mm_cvtsi128_si32(h1))) % ADLER32_BASE;
+            s2 = static_cast<uint32>(_mm_cvtsi128_si32(h2)) % ADLER32_BASE;
         }
-        s2 %= ADLER32_BASE;
+
+        return Adler32_Scalar((s2 << 16) | s1, input, length);
     }
+#else
+    uint32 Adler32_SSSE3(uint32 adler, const uint8* input, size_t length)
+    {
+        return Adler32_Scalar(adler, input, length);
+    }
+
+    uint32 Adler32_AVX2(uint32 adler, const uint8* input, size_t length)
+    {
+        return Adler32_Scalar(adler, input, length);
+    }
+#endif
+} // namespace Kernels
+
+bool Adler32::Update(const unsigned char* input, uint32 length)
+{
+    CHECK(input != nullptr, false, "");
+
+    static const auto kernel = Kernels::Adler32_HasAVX2()    ? Kernels::Adler32_AVX2
+                               : Kernels::Adler32_HasSSSE3() ? Kernels::Adler32_SSSE3
+                                                             : Kernels::Adler32_Scalar;
+
+    const auto adler = kernel((static_cast<uint32>(b) << 16) | a, input, length);
+    const auto s1    = adler & 0xFFFF;
+    const auto s2    = adler >> 16;
 
     CHECK(s1 < ADLER32_BASE, false, "");
     CHECK(s2 < ADLER32_BASE, false, "");
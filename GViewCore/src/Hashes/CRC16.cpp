@@ -1,8 +1,8 @@
-#include "Internal.hpp"
+#include "HashKernels.hpp"
 
 namespace GView::Hashes
 {
-static const uint16_t CRC16FalseTable[] = {
+static constexpr uint16_t CRC16FalseTable[] = {
     0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7, 0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
     0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6, 0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
     0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485, 0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
@@ -29,15 +29,48 @@ bool CRC16::Init()
     return true;
 }
 
-bool CRC16::Update(const unsigned char* input, uint32 length)
+// CRC16SliceTable[k][i] = CRC of byte i followed by k zero bytes (row 0 is the classic table)
+static constexpr auto CRC16SliceTable = []() {
+    std::array<std::array<uint16, 256>, 8> t{};
+    for (uint32 i = 0; i < 256; i++)
+        t[0][i] = CRC16FalseTable[i];
+    for (uint32 k = 1; k < 8; k++)
+        for (uint32 i = 0; i < 256; i++)
+            t[k][i] = static_cast<uint16>((t[k - 1][i] << 8) ^ t[0][t[k - 1][i] >> 8]);
+    return t;
+}();
+
+namespace Kernels
 {
-    CHECK(input != nullptr, false, "");
+    uint16 CRC16_Bytewise(uint16 crc, const uint8* input, size_t length)
+    {
+        while (length--)
+        {
+            const uint16 j = crc >> 8 ^ *input++;
+            crc            = (uint16) (crc << 8 ^ CRC16FalseTable[j]);
+        }
+        return crc;
+    }
 
-    for (auto i = 0U; i < length; i++)
+    uint16 CRC16_Slicing8(uint16 crc, const uint8* input, size_t length)
     {
-        const uint16 j = value >> 8 ^ input[i];
-        value          = (uint16) (value << 8 ^ CRC16FalseTable[j]);
+        const auto& t = CRC16SliceTable;
+        while (length >= 8)
+        {
+            crc = t[7][input[0] ^ (crc >> 8)] ^ t[6][input[1] ^ (crc & 0xFF)] ^ t[5][input[2]] ^ t[4][input[3]] ^ t[3][input[4]] ^
+                  t[2][input[5]] ^ t[1][input[6]] ^ t[0][input[7]];
+            input += 8;
+            length -= 8;
+        }
+        return CRC16_Bytewise(crc, input, length);
     }
+} // namespace Kernels
+
+bool CRC16::Update(const unsigned char* input, uint32 length)
+{
+    CHECK(input != nullptr, false, "");
+
+    value = Kernels::CRC16_Slicing8(static_cast<uint16>(value), input, length);
 
     return true;
 }
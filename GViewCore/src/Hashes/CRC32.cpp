@@ -1,8 +1,11 @@
-#include "Internal.hpp"
+#include "HashKernels.hpp"
+#include "CpuFeatures.hpp"
+
+#include <bit>
 
 namespace GView::Hashes
 {
-static const uint32 CRC32Table[] = {
+static constexpr uint32 CRC32Table[256] = {
     0x00000000L, 0x77073096L, 0xee0e612cL, 0x990951baL, 0x076dc419L, 0x706af48fL, 0xe963a535L, 0x9e6495a3L, 0x0edb8832L, 0x79dcb8a4L,
     0xe0d5e91eL, 0x97d2d988L, 0x09b64c2bL, 0x7eb17cbdL, 0xe7b82d07L, 0x90bf1d91L, 0x1db71064L, 0x6ab020f2L, 0xf3b97148L, 0x84be41deL,
     0x1adad47dL, 0x6ddde4ebL, 0xf4d4b551L, 0x83d385c7L, 0x136c9856L, 0x646ba8c0L, 0xfd62f97aL, 0x8a65c9ecL, 0x14015c4fL, 0x63066cd9L,
@@ -40,15 +43,163 @@ bool CRC32::Init(CRC32Type type)
     return true;
 }
 
+// CRC32SliceTable[k][i] = CRC of byte i followed by k zero bytes (row 0 is the classic table)
+static constexpr auto CRC32SliceTable = []() {
+    std::array<std::array<uint32, 256>, 8> t{};
+    for (uint32 i = 0; i < 256; i++)
+        t[0][i] = CRC32Table[i];
+    for (uint32 k = 1; k < 8; k++)
+        for (uint32 i = 0; i < 256; i++)
+            t[k][i] = (t[k - 1][i] >> 8) ^ t[0][t[k - 1][i] & 0xFF];
+    return t;
+}();
+
+namespace Kernels
+{
+    uint32 CRC32_Bytewise(uint32 crc, const uint8* input, size_t length)
+    {
+        while (length--)
+        {
+            crc = CRC32Table[(crc & 0xff) ^ *input++] ^ (crc >> 8);
+        }
+        return crc;
+    }
+
+    uint32 CRC32_Slicing8(uint32 crc, const uint8* input, size_t length)
+    {
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            const auto& t = CRC32SliceTable;
+            while (length >= 8)
+            {
+                uint32 lo, hi;
+                memcpy(&lo, input, sizeof(lo));
+                memcpy(&hi, input + 4, sizeof(hi));
+                lo ^= crc;
+                crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^ t[3][hi & 0xFF] ^
+                      t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+                input += 8;
+                length -= 8;
+            }
+        }
+        return CRC32_Bytewise(crc, input, length);
+    }
+
+    bool CRC32_HasCarrylessMultiply()
+    {
+        const auto& f = Utils::CPU::GetFeatures();
+        return f.pclmul && f.sse41;
+    }
+
+#if defined(GVIEW_X86_SIMD)
+    // folding with carry-less multiplication (Intel - "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ")
+    // the constants are x^(4*128+32), x^(4*128-32), x^(128+32), x^(128-32), x^64 mod P and the Barrett constants (bit reflected)
+    GVIEW_TARGET("pclmul,sse4.1") uint32 CRC32_CarrylessMultiply(uint32 crc, const uint8* input, size_t length)
+    {
+        alignas(16) static const uint64 k1k2[] = { 0x0154442bd4, 0x01c6e41596 };
+        alignas(16) static const uint64 k3k4[] = { 0x01751997d0, 0x00ccaa009e };
+        alignas(16) static const uint64 k5k0[] = { 0x0163cd6124, 0x0000000000 };
+        alignas(16) static const uint64 poly[] = { 0x01db710641, 0x01f7011641 };
+
+        __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+
+        x1 = _mm_loadu_si128((const __m128i*) (input + 0x00));
+        x2 = _mm_loadu_si128((const __m128i*) (input + 0x10));
+        x3 = _mm_loadu_si128((const __m128i*) (input + 0x20));
+        x4 = _mm_loadu_si128((const __m128i*) (input + 0x30));
+        x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int) crc));
+        x0 = _mm_load_si128((const __m128i*) k1k2);
+        input += 64;
+        length -= 64;
+
+        // fold 4 x 128 bits at a time
+        while (length >= 64)
+        {
+            x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+            x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+            x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+            x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+            x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+            x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+            x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+            x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+            y5 = _mm_loadu_si128((const __m128i*) (input + 0x00));
+            y6 = _mm_loadu_si128((const __m128i*) (input + 0x10));
+            y7 = _mm_loadu_si128((const __m128i*) (input + 0x20));
+            y8 = _mm_loadu_si128((const __m128i*) (input + 0x30));
+            x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+            x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+            x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+            x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+            input += 64;
+            length -= 64;
+        }
+
+        // fold into 128 bits
+        x0 = _mm_load_si128((const __m128i*) k3k4);
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+        // fold the remaining 128 bit blocks
+        while (length >= 16)
+        {
+            x2 = _mm_loadu_si128((const __m128i*) input);
+            x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+            x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+            x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+            input += 16;
+            length -= 16;
+        }
+
+        // fold 128 bits to 64 bits
+        x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+        x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+        x1 = _mm_srli_si128(x1, 8);
+        x1 = _mm_xor_si128(x1, x2);
+        x0 = _mm_loadl_epi64((const __m128i*) k5k0);
+        x2 = _mm_srli_si128(x1, 4);
+        x1 = _mm_and_si128(x1, x3);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_xor_si128(x1, x2);
+
+        // Barrett reduction to 32 bits
+        x0 = _mm_load_si128((const __m128i*) poly);
+        x2 = _mm_and_si128(x1, x3);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+        x2 = _mm_and_si128(x2, x3);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x1 = _mm_xor_si128(x1, x2);
+        return (uint32) _mm_extract_epi32(x1, 1);
+    }
+#else
+    uint32 CRC32_CarrylessMultiply(uint32 crc, const uint8* input, size_t length)
+    {
+        return CRC32_Slicing8(crc, input, length);
+    }
+#endif
+} // namespace Kernels
+
 bool CRC32::Update(const unsigned char* input, uint32 length)
 {
     CHECK(input != nullptr, false, "");
     uint32 crc = value;
 
-    while (length--)
+    static const bool useCarrylessMultiply = Kernels::CRC32_HasCarrylessMultiply();
+    if ((useCarrylessMultiply) && (length >= 64))
     {
-        crc = CRC32Table[(crc & 0xff) ^ *input++] ^ (crc >> 8);
+        const auto blocks = length & (~15U);
+        crc               = Kernels::CRC32_CarrylessMultiply(crc, input, blocks);
+        input += blocks;
+        length -= blocks;
     }
+    crc = Kernels::CRC32_Slicing8(crc, input, length);
 
     value = crc;
 
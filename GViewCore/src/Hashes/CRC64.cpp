@@ -1,8 +1,13 @@
-#include "Internal.hpp"
+#include "HashKernels.hpp"
+#include "CpuFeatures.hpp"
+
+#include <bit>
 
 namespace GView::Hashes
 {
-static const uint64 CRC64Table[256] = {
+static constexpr uint64 CRC64_POLY = 0x42F0E1EBA9EA3693;
+
+static constexpr uint64 CRC64Table[256] = {
     0x0000000000000000, 0x42F0E1EBA9EA3693, 0x85E1C3D753D46D26, 0xC711223CFA3E5BB5, 0x493366450E42ECDF, 0x0BC387AEA7A8DA4C,
     0xCCD2A5925D9681F9, 0x8E224479F47CB76A, 0x9266CC8A1C85D9BE, 0xD0962D61B56FEF2D, 0x17870F5D4F51B498, 0x5577EEB6E6BB820B,
     0xDB55AACF12C73561, 0x99A54B24BB2D03F2, 0x5EB4691841135847, 0x1C4488F3E8F96ED4, 0x663D78FF90E185EF, 0x24CD9914390BB37C,
@@ -65,16 +70,149 @@ bool CRC64::Init(CRC64Type type)
     return true;
 }
 
+// CRC64SliceTable[k][i] = CRC of byte i followed by k zero bytes (row 0 is the classic table)
+static constexpr auto CRC64SliceTable = []() {
+    std::array<std::array<uint64, 256>, 8> t{};
+    for (uint32 i = 0; i < 256; i++)
+        t[0][i] = CRC64Table[i];
+    for (uint32 k = 1; k < 8; k++)
+        for (uint32 i = 0; i < 256; i++)
+            t[k][i] = (t[k - 1][i] << 8) ^ t[0][t[k - 1][i] >> 56];
+    return t;
+}();
+
+// x^n mod P (used as folding constants)
+static constexpr uint64 CRC64_XPowModP(uint32 n)
+{
+    uint64 r = 1;
+    while (n--)
+        r = (r << 1) ^ ((r >> 63) ? CRC64_POLY : 0);
+    return r;
+}
+
+namespace Kernels
+{
+    uint64 CRC64_Bytewise(uint64 crc, const uint8* input, size_t length)
+    {
+        while (length--)
+        {
+            uint64 i = ((uint64) (crc >> 56) ^ *input++) & 0xFF;
+            crc      = CRC64Table[i] ^ (crc << 8);
+        }
+        return crc;
+    }
+
+    uint64 CRC64_Slicing8(uint64 crc, const uint8* input, size_t length)
+    {
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            const auto& t = CRC64SliceTable;
+            while (length >= 8)
+            {
+                uint64 v;
+                memcpy(&v, input, sizeof(v));
+                // the first byte from the input is the most significant one
+                v = ((v & 0x00000000000000FFULL) << 56) | ((v & 0x000000000000FF00ULL) << 40) | ((v & 0x0000000000FF0000ULL) << 24) |
+                    ((v & 0x00000000FF000000ULL) << 8) | ((v & 0x000000FF00000000ULL) >> 8) | ((v & 0x0000FF0000000000ULL) >> 24) |
+                    ((v & 0x00FF000000000000ULL) >> 40) | ((v & 0xFF00000000000000ULL) >> 56);
+                v ^= crc;
+                crc = t[7][v >> 56] ^ t[6][(v >> 48) & 0xFF] ^ t[5][(v >> 40) & 0xFF] ^ t[4][(v >> 32) & 0xFF] ^ t[3][(v >> 24) & 0xFF] ^
+                      t[2][(v >> 16) & 0xFF] ^ t[1][(v >> 8) & 0xFF] ^ t[0][v & 0xFF];
+                input += 8;
+                length -= 8;
+            }
+        }
+        return CRC64_Bytewise(crc, input, length);
+    }
+
+    bool CRC64_HasCarrylessMultiply()
+    {
+        const auto& f = Utils::CPU::GetFeatures();
+        return f.pclmul && f.ssse3;
+    }
+
+#if defined(GVIEW_X86_SIMD)
+    // folding with carry-less multiplication for a non reflected CRC
+    // every 128 bit block (loaded in big endian order) is split in hi * x^64 + lo and moved 'd' bits forward by
+    // multiplying hi with x^(d+64) mod P and lo with x^d mod P (both products fit in 128 bits)
+    // the last 128 bits are reduced with the table kernel (crc = 0 followed by those 16 bytes)
+    GVIEW_TARGET("ssse3") static inline __m128i CRC64_LoadBigEndian(const uint8* p, __m128i reverse)
+    {
+        return _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) p), reverse);
+    }
+    GVIEW_TARGET("pclmul") static inline __m128i CRC64_Fold(__m128i x, __m128i k, __m128i next)
+    {
+        return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x11), _mm_clmulepi64_si128(x, k, 0x00)), next);
+    }
+    GVIEW_TARGET("pclmul,ssse3") uint64 CRC64_CarrylessMultiply(uint64 crc, const uint8* input, size_t length)
+    {
+        static constexpr uint64 K_512_HI = CRC64_XPowModP(512 + 64);
+        static constexpr uint64 K_512_LO = CRC64_XPowModP(512);
+        static constexpr uint64 K_128_HI = CRC64_XPowModP(128 + 64);
+        static constexpr uint64 K_128_LO = CRC64_XPowModP(128);
+
+        const __m128i reverse = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+        const __m128i k512    = _mm_set_epi64x((long long) K_512_HI, (long long) K_512_LO);
+        const __m128i k128    = _mm_set_epi64x((long long) K_128_HI, (long long) K_128_LO);
+
+        __m128i x1 = _mm_xor_si128(CRC64_LoadBigEndian(input + 0x00, reverse), _mm_set_epi64x((long long) crc, 0));
+        __m128i x2 = CRC64_LoadBigEndian(input + 0x10, reverse);
+        __m128i x3 = CRC64_LoadBigEndian(input + 0x20, reverse);
+        __m128i x4 = CRC64_LoadBigEndian(input + 0x30, reverse);
+        input += 64;
+        length -= 64;
+
+        // fold 4 x 128 bits at a time
+        while (length >= 64)
+        {
+            x1 = CRC64_Fold(x1, k512, CRC64_LoadBigEndian(input + 0x00, reverse));
+            x2 = CRC64_Fold(x2, k512, CRC64_LoadBigEndian(input + 0x10, reverse));
+            x3 = CRC64_Fold(x3, k512, CRC64_LoadBigEndian(input + 0x20, reverse));
+            x4 = CRC64_Fold(x4, k512, CRC64_LoadBigEndian(input + 0x30, reverse));
+            input += 64;
+            length -= 64;
+        }
+
+        // fold into 128 bits
+        x1 = CRC64_Fold(x1, k128, x2);
+        x1 = CRC64_Fold(x1, k128, x3);
+        x1 = CRC64_Fold(x1, k128, x4);
+
+        // fold the remaining 128 bit blocks
+        while (length >= 16)
+        {
+            x1 = CRC64_Fold(x1, k128, CRC64_LoadBigEndian(input, reverse));
+            input += 16;
+            length -= 16;
+        }
+
+        // reduce the last 128 bits
+        alignas(16) uint8 last[16];
+        _mm_store_si128((__m128i*) last, _mm_shuffle_epi8(x1, reverse));
+        return CRC64_Slicing8(0, last, sizeof(last));
+    }
+#else
+    uint64 CRC64_CarrylessMultiply(uint64 crc, const uint8* input, size_t length)
+    {
+        return CRC64_Slicing8(crc, input, length);
+    }
+#endif
+} // namespace Kernels
+
 bool CRC64::Update(const unsigned char* input, uint32 length)
 {
     CHECK(input != nullptr, false, "");
     uint64 crc = value;
 
-    while (length--)
+    static const bool useCarrylessMultiply = Kernels::CRC64_HasCarrylessMultiply();
+    if ((useCarrylessMultiply) && (length >= 64))
     {
-        uint64 i = ((uint64) (crc >> 56) ^ *input++) & 0xFF;
-        crc      = CRC64Table[i] ^ (crc << 8);
+        const auto blocks = length & (~15U);
+        crc               = Kernels::CRC64_CarrylessMultiply(crc, input, blocks);
+        input += blocks;
+        length -= blocks;
     }
+    crc = Kernels::CRC64_Slicing8(crc, input, length);
 
     value = crc;
 
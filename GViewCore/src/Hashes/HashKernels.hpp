@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Internal.hpp"
+
+// Update kernels used by the hash classes. They are exposed so that the vectorised paths can be checked against the
+// scalar ones (the public classes always pick the fastest kernel supported by the current CPU).
+namespace GView::Hashes::Kernels
+{
+// Adler32 - 'adler' is (s2 << 16) | s1
+uint32 Adler32_Scalar(uint32 adler, const uint8* input, size_t length);
+bool Adler32_HasSSSE3();
+uint32 Adler32_SSSE3(uint32 adler, const uint8* input, size_t length);
+bool Adler32_HasAVX2();
+uint32 Adler32_AVX2(uint32 adler, const uint8* input, size_t length);
+
+// CRC16 (CCITT, 0x1021, MSB first)
+uint16 CRC16_Bytewise(uint16 crc, const uint8* input, size_t length);
+uint16 CRC16_Slicing8(uint16 crc, const uint8* input, size_t length);
+
+// CRC32 (reflected, 0xEDB88320) - 'crc' is the internal state (no pre/post inversion)
+uint32 CRC32_Bytewise(uint32 crc, const uint8* input, size_t length);
+uint32 CRC32_Slicing8(uint32 crc, const uint8* input, size_t length);
+bool CRC32_HasCarrylessMultiply();
+uint32 CRC32_CarrylessMultiply(uint32 crc, const uint8* input, size_t length); // length >= 64 and multiple of 16
+
+// CRC64 (ECMA-182, 0x42F0E1EBA9EA3693, MSB first)
+uint64 CRC64_Bytewise(uint64 crc, const uint8* input, size_t length);
+uint64 CRC64_Slicing8(uint64 crc, const uint8* input, size_t length);
+bool CRC64_HasCarrylessMultiply();
+uint64 CRC64_CarrylessMultiply(uint64 crc, const uint8* input, size_t length); // length >= 64 and multiple of 16
+} // namespace GView::Hashes::Kernels
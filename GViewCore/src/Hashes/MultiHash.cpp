@@ -0,0 +1,325 @@
+#include "Internal.hpp"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace GView::Hashes
+{
+constexpr uint32 MULTIHASH_BLOCK_SIZE     = 0x100000; // 1 MB
+constexpr uint32 MULTIHASH_PIPELINE_DEPTH = 8;        // blocks that can be in flight at the same time
+
+struct HashWorker
+{
+    HashKind kind;
+    Adler32 adler32;
+    CRC16 crc16;
+    CRC32 crc32;
+    CRC64 crc64;
+    std::unique_ptr<OpenSSLHash> openssl;
+    std::thread thread;
+    uint64 next{ 0 }; // index of the next block to be processed
+    bool failed{ false };
+
+    HashWorker(HashKind kind) : kind(kind)
+    {
+    }
+    bool Init()
+    {
+        switch (kind)
+        {
+        case HashKind::Adler32:
+            return adler32.Init();
+        case HashKind::CRC16:
+            return crc16.Init();
+        case HashKind::CRC32_JAMCRC_0:
+            return crc32.Init(CRC32Type::JAMCRC_0);
+        case HashKind::CRC32_JAMCRC:
+            return crc32.Init(CRC32Type::JAMCRC);
+        case HashKind::CRC64_ECMA_182:
+            return crc64.Init(CRC64Type::ECMA_182);
+        case HashKind::CRC64_WE:
+            return crc64.Init(CRC64Type::WE);
+        default:
+            // OpenSSLHashKind follows the same order (starting with MD5)
+            openssl = std::make_unique<OpenSSLHash>(
+                  static_cast<OpenSSLHashKind>(static_cast<uint8>(kind) - static_cast<uint8>(HashKind::MD5)));
+            return true;
+        }
+    }
+    bool Update(const uint8* data, uint32 size)
+    {
+        switch (kind)
+        {
+        case HashKind::Adler32:
+            return adler32.Update(data, size);
+        case HashKind::CRC16:
+            return crc16.Update(data, size);
+        case HashKind::CRC32_JAMCRC_0:
+        case HashKind::CRC32_JAMCRC:
+            return crc32.Update(data, size);
+        case HashKind::CRC64_ECMA_182:
+        case HashKind::CRC64_WE:
+            return crc64.Update(data, size);
+        default:
+            return openssl->Update(data, size);
+        }
+    }
+    std::string_view GetHexValue()
+    {
+        switch (kind)
+        {
+        case HashKind::Adler32:
+            return adler32.GetHexValue();
+        case HashKind::CRC16:
+            return crc16.GetHexValue();
+        case HashKind::CRC32_JAMCRC_0:
+        case HashKind::CRC32_JAMCRC:
+            return crc32.GetHexValue();
+        case HashKind::CRC64_ECMA_182:
+        case HashKind::CRC64_WE:
+            return crc64.GetHexValue();
+        default:
+            return openssl->GetHexValue();
+        }
+    }
+};
+
+struct SharedBlock
+{
+    std::unique_ptr<uint8[]> data;
+    uint32 size{ 0 };
+    uint32 pending{ 0 }; // number of workers that did not process this block yet
+};
+
+struct MultiHashContext
+{
+    std::vector<std::unique_ptr<HashWorker>> workers;
+    SharedBlock blocks[MULTIHASH_PIPELINE_DEPTH];
+    uint64 published{ 0 }; // number of blocks sent to workers
+    std::mutex lock;
+    std::condition_variable cvWork;
+    std::condition_variable cvFree;
+    bool started{ false };
+    bool finished{ false };
+    bool stop{ false };
+    bool canceled{ false };
+
+    void Run(HashWorker* w)
+    {
+        std::unique_lock<std::mutex> l(lock);
+        while (true)
+        {
+            cvWork.wait(l, [&] { return canceled || stop || published > w->next; });
+            if (canceled)
+                break;
+            if (published <= w->next)
+                break; // stop requested and all blocks were processed
+            auto& b = blocks[w->next % MULTIHASH_PIPELINE_DEPTH];
+            l.unlock();
+            if (!w->failed)
+                w->failed = !w->Update(b.data.get(), b.size);
+            l.lock();
+            w->next++;
+            if (--b.pending == 0)
+                cvFree.notify_all();
+        }
+    }
+    void Start()
+    {
+        for (auto& w : workers)
+            w->thread = std::thread(&MultiHashContext::Run, this, w.get());
+        started = true;
+    }
+    void Stop(bool cancel)
+    {
+        if (!started)
+            return;
+        {
+            std::lock_guard<std::mutex> l(lock);
+            stop = true;
+            canceled |= cancel;
+        }
+        cvWork.notify_all();
+        for (auto& w : workers)
+        {
+            if (w->thread.joinable())
+                w->thread.join();
+        }
+        started = false;
+    }
+    bool Push(const uint8* data, uint32 size)
+    {
+        auto& b = blocks[published % MULTIHASH_PIPELINE_DEPTH];
+        {
+            // wait until every worker is done with the previous content of this slot
+            std::unique_lock<std::mutex> l(lock);
+            cvFree.wait(l, [&] { return b.pending == 0 || canceled; });
+            if (canceled)
+                return false;
+        }
+        if (!b.data)
+            b.data = std::make_unique<uint8[]>(MULTIHASH_BLOCK_SIZE);
+        memcpy(b.data.get(), data, size);
+        b.size = size;
+        {
+            std::lock_guard<std::mutex> l(lock);
+            b.pending = (uint32) workers.size();
+            published++;
+        }
+        cvWork.notify_all();
+        return true;
+    }
+};
+
+MultiHash::MultiHash()
+{
+    this->context = new MultiHashContext();
+}
+MultiHash::~MultiHash()
+{
+    auto ctx = reinterpret_cast<MultiHashContext*>(this->context);
+    ctx->Stop(true);
+    delete ctx;
+    this->context = nullptr;
+}
+bool MultiHash::Add(HashKind kind)
+{
+    auto ctx = reinterpret_cast<MultiHashContext*>(this->context);
+    CHECK(kind < HashKind::Count, false, "Invalid hash kind: %u", static_cast<uint32>(kind));
+    CHECK(!ctx->started && !ctx->finished, false, "Hashes can not be added after the computation started !");
+    if (IsSelected(kind))
+        return true;
+    auto w = std::make_unique<HashWorker>(kind);
+    CHECK(w->Init(), false, "Fail to initialize %s", GetName(kind).data());
+    ctx->workers.push_back(std::move(w));
+    return true;
+}
+bool MultiHash::Update(const uint8* data, uint32 size)
+{
+    auto ctx = reinterpret_cast<MultiHashContext*>(this->context);
+    CHECK(data != nullptr, false, "");
+    CHECK(!ctx->finished, false, "Final was already called !");
+    CHECK(!ctx->canceled, false, "Operation was canceled !");
+    if (!ctx->started)
+        ctx->Start();
+    while (size > 0)
+    {
+        const auto sz = std::min<>(size, MULTIHASH_BLOCK_SIZE);
+        CHECK(ctx->Push(data, sz), false, "");
+        data += sz;
+        size -= sz;
+    }
+    return true;
+}
+bool MultiHash::Update(Utils::DataCache& cache, uint64 offset, uint64 size, const std::function<bool(uint64)>& onProgress)
+{
+    const auto block = std::min<>(cache.GetCacheSize(), MULTIHASH_BLOCK_SIZE);
+    uint64 processed = 0;
+    while (processed < size)
+    {
+        const auto sz = static_cast<uint32>(std::min<uint64>(size - processed, block));
+        auto bv       = cache.Get(offset + processed, sz, true);
+        CHECK(bv.IsValid(), false, "Unable to read %u bytes from %llu offset", sz, offset + processed);
+        CHECK(Update(bv.GetData(), sz), false, "");
+        processed += sz;
+        if ((onProgress) && (!onProgress(processed)))
+        {
+            Cancel();
+            return false;
+        }
+    }
+    return true;
+}
+bool MultiHash::Final()
+{
+    auto ctx = reinterpret_cast<MultiHashContext*>(this->context);
+    CHECK(!ctx->canceled, false, "Operation was canceled !");
+    ctx->Stop(false);
+    ctx->finished = true;
+    for (auto& w : ctx->workers)
+    {
+        CHECK(!w->failed, false, "Fail to compute %s", GetName(w->kind).data());
+    }
+    return true;
+}
+void MultiHash::Cancel()
+{
+    auto ctx = reinterpret_cast<MultiHashContext*>(this->context);
+    ctx->Stop(true);
+    ctx->canceled = true;
+}
+bool MultiHash::IsSelected(HashKind kind) const
+{
+    auto ctx = reinterpret_cast<MultiHashContext*>(this->context);
+    for (auto& w : ctx->workers)
+    {
+        if (w->kind == kind)
+            return true;
+    }
+    return false;
+}
+std::string_view MultiHash::GetHexValue(HashKind kind) const
+{
+    auto ctx = reinterpret_cast<MultiHashContext*>(this->context);
+    CHECK(ctx->finished, std::string_view(), "Final must be called first !");
+    for (auto& w : ctx->workers)
+    {
+        if (w->kind == kind)
+            return w->GetHexValue();
+    }
+    return {};
+}
+std::string_view MultiHash::GetName(HashKind kind)
+{
+    switch (kind)
+    {
+    case HashKind::Adler32:
+        return Adler32::GetName();
+    case HashKind::CRC16:
+        return CRC16::GetName();
+    case HashKind::CRC32_JAMCRC_0:
+        return CRC32::GetName(CRC32Type::JAMCRC_0);
+    case HashKind::CRC32_JAMCRC:
+        return CRC32::GetName(CRC32Type::JAMCRC);
+    case HashKind::CRC64_ECMA_182:
+        return CRC64::GetName(CRC64Type::ECMA_182);
+    case HashKind::CRC64_WE:
+        return CRC64::GetName(CRC64Type::WE);
+    case HashKind::MD5:
+        return "MD5";
+    case HashKind::BLAKE2S256:
+        return "BLAKE2S256";
+    case HashKind::BLAKE2B512:
+        return "BLAKE2B512";
+    case HashKind::SHA1:
+        return "SHA1";
+    case HashKind::SHA224:
+        return "SHA224";
+    case HashKind::SHA256:
+        return "SHA256";
+    case HashKind::SHA384:
+        return "SHA384";
+    case HashKind::SHA512:
+        return "SHA512";
+    case HashKind::SHA512_224:
+        return "SHA512_224";
+    case HashKind::SHA512_256:
+        return "SHA512_256";
+    case HashKind::SHA3_224:
+        return "SHA3_224";
+    case HashKind::SHA3_256:
+        return "SHA3_256";
+    case HashKind::SHA3_384:
+        return "SHA3_384";
+    case HashKind::SHA3_512:
+        return "SHA3_512";
+    case HashKind::SHAKE128:
+        return "SHAKE128";
+    case HashKind::SHAKE256:
+        return "SHAKE256";
+    default:
+        return "";
+    }
+}
+} // namespace GView::Hashes
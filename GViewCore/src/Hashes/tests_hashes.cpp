@@ -0,0 +1,111 @@
+#include <catch.hpp>
+#include "HashKernels.hpp"
+#include <random>
+#include <vector>
+
+using namespace GView::Hashes;
+
+static std::vector<uint8> CreateRandomBuffer(size_t size)
+{
+    std::mt19937 gen(0x47566965);
+    std::vector<uint8> buffer(size);
+    for (auto& b : buffer)
+        b = static_cast<uint8>(gen());
+    return buffer;
+}
+
+TEST_CASE("CRCCheckValues", "[Hashes]CRC")
+{
+    const auto* input = reinterpret_cast<const uint8*>("123456789");
+
+    CRC32 crc32;
+    REQUIRE(crc32.Init(CRC32Type::JAMCRC));
+    REQUIRE(crc32.Update(input, 9));
+    REQUIRE(crc32.GetHexValue() == "CBF43926");
+
+    REQUIRE(crc32.Init(CRC32Type::JAMCRC_0));
+    REQUIRE(crc32.Update(input, 9));
+    REQUIRE(crc32.GetHexValue() == "340BC6D9");
+
+    CRC64 crc64;
+    REQUIRE(crc64.Init(CRC64Type::ECMA_182));
+    REQUIRE(crc64.Update(input, 9));
+    REQUIRE(crc64.GetHexValue() == "6C40DF5F0B497347");
+
+    REQUIRE(crc64.Init(CRC64Type::WE));
+    REQUIRE(crc64.Update(input, 9));
+    REQUIRE(crc64.GetHexValue() == "62EC59E3F1A4F00A");
+}
+
+TEST_CASE("CRCKernels", "[Hashes]CRC")
+{
+    const auto buffer = CreateRandomBuffer(0x10000);
+    const size_t lengths[] = { 0, 1, 7, 8, 15, 63, 64, 65, 127, 128, 1000, 4096, 0xFFF0 };
+
+    for (size_t offset = 0; offset < 16; offset += 3)
+    {
+        for (auto length : lengths)
+        {
+            const auto* p = buffer.data() + offset;
+
+            const auto crc32 = Kernels::CRC32_Bytewise(0xFFFFFFFF, p, length);
+            REQUIRE(Kernels::CRC32_Slicing8(0xFFFFFFFF, p, length) == crc32);
+
+            const auto crc64 = Kernels::CRC64_Bytewise(0xFFFFFFFFFFFFFFFF, p, length);
+            REQUIRE(Kernels::CRC64_Slicing8(0xFFFFFFFFFFFFFFFF, p, length) == crc64);
+
+            if (length < 64)
+                continue;
+            const auto blocks = length & (~static_cast<size_t>(15));
+            if (Kernels::CRC32_HasCarrylessMultiply())
+            {
+                auto value = Kernels::CRC32_CarrylessMultiply(0xFFFFFFFF, p, blocks);
+                REQUIRE(Kernels::CRC32_Slicing8(value, p + blocks, length - blocks) == crc32);
+            }
+            if (Kernels::CRC64_HasCarrylessMultiply())
+            {
+                auto value = Kernels::CRC64_CarrylessMultiply(0xFFFFFFFFFFFFFFFF, p, blocks);
+                REQUIRE(Kernels::CRC64_Slicing8(value, p + blocks, length - blocks) == crc64);
+            }
+        }
+    }
+}
+
+TEST_CASE("Adler32CRC16CheckValues", "[Hashes]Checksums")
+{
+    const auto* input = reinterpret_cast<const uint8*>("123456789");
+
+    Adler32 adler32;
+    REQUIRE(adler32.Init());
+    REQUIRE(adler32.Update(input, 9));
+    REQUIRE(adler32.GetHexValue() == "091E01DE");
+
+    CRC16 crc16;
+    REQUIRE(crc16.Init());
+    REQUIRE(crc16.Update(input, 9));
+    REQUIRE(crc16.GetHexValue() == "000031C3");
+}
+
+TEST_CASE("Adler32CRC16Kernels", "[Hashes]Checksums")
+{
+    auto buffer = CreateRandomBuffer(0x20000);
+    // a run of 0xFF bytes is the worst case for the deferred modulo
+    std::fill(buffer.begin() + 0x10000, buffer.end(), 0xFF);
+    const size_t lengths[] = { 0, 1, 7, 8, 31, 32, 33, 100, 5552, 5553, 0x8000, 0x10000 };
+
+    for (size_t offset = 0; offset < 0x10010; offset += 0x3FFF)
+    {
+        for (auto length : lengths)
+        {
+            const auto* p = buffer.data() + offset;
+
+            const auto adler = Kernels::Adler32_Scalar(1, p, length);
+            if (Kernels::Adler32_HasSSSE3())
+                REQUIRE(Kernels::Adler32_SSSE3(1, p, length) == adler);
+            if (Kernels::Adler32_HasAVX2())
+                REQUIRE(Kernels::Adler32_AVX2(1, p, length) == adler);
+
+            REQUIRE(Kernels::CRC16_Slicing8(0x1D0F, p, length) == Kernels::CRC16_Bytewise(0x1D0F, p, length));
+        }
+    }
+}
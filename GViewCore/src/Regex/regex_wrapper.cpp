@@ -2,6 +2,8 @@
 
 #include <string>
 #include <re2/re2.h>
+#include <re2/set.h>
+#include <algorithm>
 
 namespace GView::Regex
 {
@@ -55,4 +57,218 @@ bool Matcher::Match(BufferView buffer, uint64& start, uint64& end)
 
     return false;
 }
+
+struct MultiContext {
+    RE2::Options options;
+    RE2::Anchor anchor;
+    RE2::Set set;
+    std::vector<std::unique_ptr<RE2>> expressions; // used only to locate the matches found by the set
+    bool compiled{ false };
+
+    MultiContext(const RE2::Options& o, RE2::Anchor a) : options(o), anchor(a), set(o, a)
+    {
+    }
+};
+
+static void FindMatches(MultiContext* ctx, absl::string_view text, uint32 id, size_t from, std::vector<MultiMatcher::Result>& results)
+{
+    const auto& expression = *ctx->expressions[id];
+    re2::StringPiece match;
+    while (from <= text.size()) {
+        if (!expression.Match(text, from, text.size(), ctx->anchor, &match, 1)) {
+            break;
+        }
+
+        const size_t start = match.data() - text.data();
+        const size_t end   = start + match.size();
+        results.push_back({ .id = id, .start = start, .end = end });
+        if (ctx->anchor == RE2::ANCHOR_START) {
+            break;
+        }
+        from = end > start ? end : start + 1; // empty matches -> move forward
+    }
+}
+
+bool MultiMatcher::Init(bool isCaseSensitive, bool anchored)
+{
+    CHECK(this->context == nullptr, false, "");
+
+    RE2::Options options;
+    options.set_case_sensitive(isCaseSensitive);
+    options.set_longest_match(false);
+    options.set_log_errors(false);
+
+    this->context = new MultiContext(options, anchored ? RE2::ANCHOR_START : RE2::UNANCHORED);
+
+    return true;
+}
+
+MultiMatcher::~MultiMatcher()
+{
+    if (this->context != nullptr) {
+        delete reinterpret_cast<MultiContext*>(this->context);
+    }
+}
+
+bool MultiMatcher::Add(std::string_view expression, uint32& id)
+{
+    auto ctx = reinterpret_cast<MultiContext*>(this->context);
+    CHECK(ctx != nullptr, false, "");
+    CHECK(ctx->compiled == false, false, "Expressions can not be added after Compile !");
+
+    absl::string_view asv{ expression.data(), expression.size() };
+
+    auto re = std::make_unique<RE2>(asv, ctx->options);
+    CHECK(re->ok(), false, "Invalid expression: %s", re->error().c_str());
+
+    std::string error;
+    const auto index = ctx->set.Add(asv, &error);
+    CHECK(index >= 0, false, "Invalid expression: %s", error.c_str());
+    CHECK(static_cast<size_t>(index) == ctx->expressions.size(), false, "");
+
+    ctx->expressions.push_back(std::move(re));
+    id = static_cast<uint32>(index);
+
+    return true;
+}
+
+bool MultiMatcher::Compile()
+{
+    auto ctx = reinterpret_cast<MultiContext*>(this->context);
+    CHECK(ctx != nullptr, false, "");
+    CHECK(ctx->compiled == false, false, "Already compiled !");
+    CHECK(ctx->expressions.empty() == false, false, "No expressions were added !");
+    CHECK(ctx->set.Compile(), false, "Fail to compile the expressions (out of memory) !");
+
+    ctx->compiled = true;
+
+    return true;
+}
+
+uint32 MultiMatcher::GetCount() const
+{
+    auto ctx = reinterpret_cast<MultiContext*>(this->context);
+    CHECK(ctx != nullptr, 0, "");
+
+    return static_cast<uint32>(ctx->expressions.size());
+}
+
+bool MultiMatcher::Match(BufferView buffer, std::vector<uint32>& ids)
+{
+    auto ctx = reinterpret_cast<MultiContext*>(this->context);
+    CHECK(ctx != nullptr, false, "");
+    CHECK(ctx->compiled, false, "Compile was not called !");
+
+    ids.clear();
+
+    absl::string_view sv{ reinterpret_cast<const char*>(buffer.GetData()), buffer.GetLength() };
+    std::vector<int> matches;
+    if (!ctx->set.Match(sv, &matches)) {
+        return false;
+    }
+
+    std::sort(matches.begin(), matches.end());
+    ids.reserve(matches.size());
+    for (const auto m : matches) {
+        ids.push_back(static_cast<uint32>(m));
+    }
+
+    return true;
+}
+
+bool MultiMatcher::Match(BufferView buffer, uint32 id, uint64& start, uint64& end)
+{
+    auto ctx = reinterpret_cast<MultiContext*>(this->context);
+    CHECK(ctx != nullptr, false, "");
+    CHECK(id < ctx->expressions.size(), false, "");
+
+    absl::string_view sv{ reinterpret_cast<const char*>(buffer.GetData()), buffer.GetLength() };
+    re2::StringPiece result;
+    if (ctx->expressions[id]->Match(sv, 0, sv.size(), ctx->anchor, &result, 1)) {
+        start = result.data() - sv.data();
+        end   = start + result.size();
+        return true;
+    }
+
+    return false;
+}
+
+bool MultiMatcher::FindAll(BufferView buffer, std::vector<Result>& results)
+{
+    results.clear();
+
+    std::vector<uint32> ids;
+    if (!Match(buffer, ids)) {
+        return false;
+    }
+
+    auto ctx = reinterpret_cast<MultiContext*>(this->context);
+    absl::string_view sv{ reinterpret_cast<const char*>(buffer.GetData()), buffer.GetLength() };
+    for (const auto id : ids) {
+        FindMatches(ctx, sv, id, 0, results);
+    }
+    std::stable_sort(results.begin(), results.end(), [](const Result& a, const Result& b) { return a.start < b.start; });
+
+    return results.empty() == false;
+}
+
+bool MultiMatcher::Scan(Utils::DataCache& cache, uint64 offset, uint64 size, uint32 maxMatchSize, const std::function<bool(const Result&)>& onMatch)
+{
+    auto ctx = reinterpret_cast<MultiContext*>(this->context);
+    CHECK(ctx != nullptr, false, "");
+    CHECK(ctx->compiled, false, "Compile was not called !");
+    CHECK(onMatch, false, "");
+    CHECK(maxMatchSize < cache.GetCacheSize() / 2, false, "Matches must be smaller than half of the cache !");
+
+    const auto end = std::min<uint64>(offset + size, cache.GetSize());
+
+    // next offset where an expression is allowed to match -> a match found in a previous chunk that continues
+    // in the overlap is not reported twice (and the next chunk continues exactly from where it ended)
+    std::vector<uint64> nextStart(ctx->expressions.size(), offset);
+    std::vector<int> matches;
+    std::vector<Result> results;
+
+    auto pos = offset;
+    while (pos < end) {
+        auto buffer = cache.Get(pos, static_cast<uint32>(std::min<uint64>(cache.GetCacheSize(), end - pos)), false);
+        CHECK(buffer.GetLength() > 0, false, "");
+
+        const auto isLast   = pos + buffer.GetLength() >= end;
+        const auto chunkEnd = isLast ? end : pos + buffer.GetLength() - maxMatchSize;
+
+        absl::string_view sv{ reinterpret_cast<const char*>(buffer.GetData()), buffer.GetLength() };
+        matches.clear();
+        results.clear();
+        if (ctx->set.Match(sv, &matches)) {
+            std::sort(matches.begin(), matches.end());
+            for (const auto m : matches) {
+                const auto id = static_cast<uint32>(m);
+                FindMatches(ctx, sv, id, static_cast<size_t>(nextStart[id] - pos), results);
+            }
+            std::stable_sort(results.begin(), results.end(), [](const Result& a, const Result& b) { return a.start < b.start; });
+
+            for (auto& r : results) {
+                r.start += pos;
+                r.end += pos;
+                if (r.start >= chunkEnd) {
+                    continue; // found again (from its start) by the next chunk
+                }
+                nextStart[r.id] = std::max<uint64>(r.end, r.start + 1);
+                if (!onMatch(r)) {
+                    return true;
+                }
+            }
+        }
+
+        if (ctx->anchor == RE2::ANCHOR_START) {
+            break; // only the first chunk can match
+        }
+        for (auto& n : nextStart) {
+            n = std::max<uint64>(n, chunkEnd);
+        }
+        pos = chunkEnd;
+    }
+
+    return true;
+}
 } // namespace GView::Regex
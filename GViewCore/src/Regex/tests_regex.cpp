@@ -0,0 +1,88 @@
+#include <catch.hpp>
+#include "Internal.hpp"
+#include <random>
+#include <algorithm>
+#include <string>
+
+using namespace GView::Regex;
+
+TEST_CASE("MultiMatcherIds", "[Regex]MultiMatcher")
+{
+    MultiMatcher matcher;
+    REQUIRE(matcher.Init(false));
+
+    uint32 url = 0, email = 0, ip = 0;
+    REQUIRE(matcher.Add(R"(https?://[a-z0-9_\.]+)", url));
+    REQUIRE(matcher.Add(R"([a-z0-9_\.]+@[a-z0-9_]+\.[a-z]+)", email));
+    REQUIRE(matcher.Add(R"([0-9]{1,3}\.[0-9]{1,3}\.[0-9]{1,3}\.[0-9]{1,3})", ip));
+    REQUIRE(matcher.GetCount() == 3);
+    REQUIRE(matcher.Compile());
+
+    const std::string_view text{ "contact: John.Doe@Mail.com, see HTTP://example.org" };
+    BufferView buffer{ text.data(), text.size() };
+
+    std::vector<uint32> ids;
+    REQUIRE(matcher.Match(buffer, ids));
+    REQUIRE(ids == std::vector<uint32>{ url, email });
+
+    uint64 start = 0, end = 0;
+    REQUIRE(matcher.Match(buffer, email, start, end));
+    REQUIRE(text.substr(start, end - start) == "John.Doe@Mail.com");
+    REQUIRE(matcher.Match(buffer, ip, start, end) == false);
+
+    std::vector<MultiMatcher::Result> results;
+    REQUIRE(matcher.FindAll(buffer, results));
+    REQUIRE(results.size() == 2);
+    REQUIRE(results[0].id == email);
+    REQUIRE(results[1].id == url);
+    REQUIRE(text.substr(results[1].start, results[1].end - results[1].start) == "HTTP://example.org");
+}
+
+TEST_CASE("MultiMatcherScan", "[Regex]MultiMatcher")
+{
+    // data larger than the cache -> matches crossing the chunk borders
+    std::mt19937 gen(0x52453253);
+    std::string data(0x50000, ' ');
+    for (auto& c : data)
+        c = "ab01. \n"[gen() % 7];
+    const char* objects[] = { "http://www.example.com", "1.2.3.4", "abba@baba.com" };
+    for (uint32 i = 0; i < 2000; i++) {
+        const std::string_view o = objects[gen() % 3];
+        data.replace(gen() % (data.size() - o.size()), o.size(), o);
+    }
+
+    MultiMatcher matcher;
+    REQUIRE(matcher.Init(true));
+    uint32 id = 0;
+    REQUIRE(matcher.Add(R"(https?://[a-z0-9_\.]+)", id));
+    REQUIRE(matcher.Add(R"([0-9]{1,3}\.[0-9]{1,3}\.[0-9]{1,3}\.[0-9]{1,3})", id));
+    REQUIRE(matcher.Add(R"([a-z0-9_\.]+@[a-z0-9_]+\.[a-z]+)", id));
+    REQUIRE(matcher.Add(R"(b+a)", id));
+    REQUIRE(matcher.Compile());
+
+    std::vector<MultiMatcher::Result> expected;
+    REQUIRE(matcher.FindAll(BufferView{ data.data(), data.size() }, expected));
+
+    auto memoryFile = std::make_unique<AppCUI::OS::MemoryFile>();
+    REQUIRE(memoryFile->Create(data.data(), data.size()));
+    GView::Utils::DataCache cache;
+    REQUIRE(cache.Init(std::move(memoryFile), 0x10000));
+
+    std::vector<MultiMatcher::Result> results;
+    REQUIRE(matcher.Scan(cache, 0, cache.GetSize(), 256, [&results](const MultiMatcher::Result& r) {
+        results.push_back(r);
+        return true;
+    }));
+
+    const auto byPosition = [](const MultiMatcher::Result& a, const MultiMatcher::Result& b) {
+        return a.start != b.start ? a.start < b.start : a.id < b.id;
+    };
+    std::sort(expected.begin(), expected.end(), byPosition);
+    std::sort(results.begin(), results.end(), byPosition);
+    REQUIRE(results.size() == expected.size());
+    for (size_t i = 0; i < results.size(); i++) {
+        REQUIRE(results[i].id == expected[i].id);
+        REQUIRE(results[i].start == expected[i].start);
+        REQUIRE(results[i].end == expected[i].end);
+    }
+}
@@ -1,50 +1,246 @@
 #include "GView.hpp"
 
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#if defined(BUILD_FOR_UNIX) || defined(BUILD_FOR_OSX)
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
 using namespace GView::Utils;
 
-constexpr uint32 MAX_CACHE_SIZE = 0x20000000U; // 16 M
+constexpr uint32 MAX_CACHE_SIZE     = 0x20000000U; // 512 M
+constexpr uint32 PAGE_ALIGNMENT     = 0x10000U;    // 64 K
+constexpr uint64 CACHE_BUDGET_RATIO = 4;           // default budget = 4 x cacheSize
+
+struct DataCache::FileLock
+{
+    std::mutex lock;
+};
+
+// Read-ahead worker (one per DataCache, started the first time a prefetch is requested).
+// It owns one extra page sized buffer that is swapped with a resident page once the data is requested.
+struct DataCache::Prefetcher
+{
+    enum class State : uint8
+    {
+        Idle,
+        Pending,
+        Reading,
+        Ready,
+        Failed
+    };
+
+    std::thread worker;
+    std::mutex lock;      // guards the state of the prefetcher
+    std::mutex& fileLock; // guards the access to the data object (SetCurrentPos + Read)
+    std::condition_variable cv;
+    AppCUI::OS::DataObject* file;
+    uint8* buffer;
+    uint32 capacity;
+    uint64 start, end;
+    State state;
+    bool stop;
+
+    Prefetcher(AppCUI::OS::DataObject* fileObj, std::mutex& fileObjLock)
+        : fileLock(fileObjLock), file(fileObj), buffer(nullptr), capacity(0), start(0), end(0), state(State::Idle), stop(false)
+    {
+        worker = std::thread(&Prefetcher::Run, this);
+    }
+    ~Prefetcher()
+    {
+        {
+            std::lock_guard<std::mutex> l(lock);
+            stop = true;
+        }
+        cv.notify_all();
+        worker.join();
+        delete[] buffer;
+    }
+    void Run()
+    {
+        std::unique_lock<std::mutex> l(lock);
+        while (true)
+        {
+            cv.wait(l, [this] { return stop || state == State::Pending; });
+            if (stop)
+                break;
+            state         = State::Reading;
+            const auto s  = start;
+            const auto sz = (uint32) (end - start);
+            l.unlock();
+            bool result;
+            {
+                std::lock_guard<std::mutex> f(fileLock);
+                result = file->SetCurrentPos(s) && file->Read(buffer, sz);
+            }
+            l.lock();
+            state = result ? State::Ready : State::Failed;
+            cv.notify_all();
+        }
+    }
+    void Schedule(uint64 _start, uint64 _end)
+    {
+        std::lock_guard<std::mutex> l(lock);
+        if ((state == State::Reading) || ((state == State::Ready) && (_start >= start) && (_end <= end)))
+            return; // busy or already available
+        const auto sz = (uint32) (_end - _start);
+        if (capacity < sz)
+        {
+            delete[] buffer;
+            buffer   = new uint8[sz];
+            capacity = sz;
+        }
+        start = _start;
+        end   = _end;
+        state = State::Pending;
+        cv.notify_all();
+    }
+    // waits until [offset, offset+size) is read (if it was scheduled) and returns the size of the prefetched area
+    uint32 WaitFor(uint64 offset, uint32 size)
+    {
+        std::unique_lock<std::mutex> l(lock);
+        if ((state == State::Idle) || (offset < start) || (offset + size > end))
+            return 0;
+        cv.wait(l, [this] { return (state != State::Pending) && (state != State::Reading); });
+        return state == State::Ready ? (uint32) (end - start) : 0;
+    }
+    // swaps the prefetched buffer with the buffer of a page (the page must be big enough)
+    void MoveTo(Page& page)
+    {
+        std::lock_guard<std::mutex> l(lock);
+        std::swap(buffer, page.data);
+        std::swap(capacity, page.capacity);
+        page.start = start;
+        page.end   = end;
+        state      = State::Idle;
+    }
+};
 
 DataCache::DataCache()
 {
-    this->fileObj    = nullptr;
-    this->cache      = nullptr;
-    this->cacheSize  = 0;
-    this->start      = 0;
-    this->end        = 0;
-    this->fileSize   = 0;
-    this->currentPos = 0;
+    this->fileObj      = nullptr;
+    this->fileLock     = nullptr;
+    this->isView       = false;
+    this->cache        = nullptr;
+    this->mappedData   = nullptr;
+    this->cacheSize    = 0;
+    this->pageSize     = 0;
+    this->pagesCount   = 0;
+    this->cacheBudget  = 0;
+    this->residentSize = 0;
+    this->accessTick   = 0;
+    this->start        = 0;
+    this->end          = 0;
+    this->fileSize     = 0;
+    this->currentPos   = 0;
+    this->stats        = {};
+    this->prefetcher   = nullptr;
+    this->lastLoadEnd  = INVALID_OFFSET;
 }
 DataCache::DataCache(DataCache&& obj)
 {
-    fileObj        = obj.fileObj;
-    fileSize       = obj.fileSize;
-    start          = obj.start;
-    end            = obj.end;
-    currentPos     = obj.currentPos;
-    cache          = obj.cache;
-    cacheSize      = obj.cacheSize;
-    obj.fileObj    = nullptr;
-    obj.fileSize   = 0;
-    obj.start      = 0;
-    obj.end        = 0;
-    obj.currentPos = 0;
-    obj.cache      = nullptr;
-    obj.cacheSize  = 0;
+    fileObj      = obj.fileObj;
+    fileLock     = obj.fileLock;
+    isView       = obj.isView;
+    fileSize     = obj.fileSize;
+    start        = obj.start;
+    end          = obj.end;
+    currentPos   = obj.currentPos;
+    cache        = obj.cache;
+    mappedData   = obj.mappedData;
+    cacheSize    = obj.cacheSize;
+    pageSize     = obj.pageSize;
+    pagesCount   = obj.pagesCount;
+    cacheBudget  = obj.cacheBudget;
+    residentSize = obj.residentSize;
+    accessTick   = obj.accessTick;
+    stats        = obj.stats;
+    prefetcher   = obj.prefetcher;
+    lastLoadEnd  = obj.lastLoadEnd;
+    for (uint32 i = 0; i < obj.pagesCount; i++)
+        pages[i] = obj.pages[i];
+
+    obj.fileObj      = nullptr;
+    obj.fileLock     = nullptr;
+    obj.isView       = false;
+    obj.fileSize     = 0;
+    obj.start        = 0;
+    obj.end          = 0;
+    obj.currentPos   = 0;
+    obj.cache        = nullptr;
+    obj.mappedData   = nullptr;
+    obj.cacheSize    = 0;
+    obj.pageSize     = 0;
+    obj.pagesCount   = 0;
+    obj.cacheBudget  = 0;
+    obj.residentSize = 0;
+    obj.accessTick   = 0;
+    obj.stats        = {};
+    obj.prefetcher   = nullptr;
+    obj.lastLoadEnd  = INVALID_OFFSET;
 }
 DataCache::~DataCache()
 {
+    // stop the read-ahead thread before the data object is closed
+    delete this->prefetcher;
+    this->prefetcher = nullptr;
+    for (uint32 i = 0; i < this->pagesCount; i++)
+        delete[] this->pages[i].data;
+    this->pagesCount   = 0;
+    this->residentSize = 0;
+    this->cache        = nullptr;
+    if (this->isView)
+    {
+        // the data object, its lock and the mapping belong to the parent
+        this->fileObj    = nullptr;
+        this->fileLock   = nullptr;
+        this->mappedData = nullptr;
+        return;
+    }
     if (this->fileObj)
     {
         this->fileObj->Close();
         delete this->fileObj;
     }
     this->fileObj = nullptr;
-    if (this->cache)
-        delete[] this->cache;
-    this->cache = nullptr;
+    delete this->fileLock;
+    this->fileLock = nullptr;
+#if defined(BUILD_FOR_UNIX) || defined(BUILD_FOR_OSX)
+    if (this->mappedData)
+        munmap(this->mappedData, (size_t) this->fileSize);
+#endif
+    this->mappedData = nullptr;
 }
 
-bool DataCache::Init(std::unique_ptr<AppCUI::OS::DataObject> file, uint32 _cacheSize)
+void DataCache::SetupPages(uint32 _cacheSize, uint64 _cacheBudget)
+{
+    // the budget must be able to hold at least one block of maximum size
+    if (_cacheBudget == 0)
+        _cacheBudget = CACHE_BUDGET_RATIO * _cacheSize;
+    _cacheBudget = std::max<uint64>(_cacheBudget, _cacheSize);
+
+    // pages are loaded on demand (no memory is allocated up-front)
+    // default page size is computed so that MAX_PAGES pages fill up the entire budget
+    auto _pageSize = std::min<uint64>(_cacheBudget / MAX_PAGES, _cacheSize);
+    _pageSize      = std::max<uint64>(_pageSize & (~((uint64) PAGE_ALIGNMENT - 1)), PAGE_ALIGNMENT);
+
+    this->cacheSize    = _cacheSize;
+    this->cacheBudget  = _cacheBudget;
+    this->pageSize     = (uint32) _pageSize;
+    this->pagesCount   = 0;
+    this->residentSize = 0;
+    this->accessTick   = 0;
+    this->cache        = nullptr;
+    this->start        = 0;
+    this->end          = 0;
+    this->stats        = {};
+}
+bool DataCache::Init(std::unique_ptr<AppCUI::OS::DataObject> file, uint32 _cacheSize, uint64 _cacheBudget)
 {
     CHECK(this->cacheSize == 0, false, "Cache object already initialized !");
     this->fileObj = file.release(); // take ownership of the pointer
@@ -54,41 +250,131 @@ bool DataCache::Init(std::unique_ptr<AppCUI::OS::DataObject> file, uint32 _cache
         _cacheSize = MAX_CACHE_SIZE;
     _cacheSize     = std::min(_cacheSize, MAX_CACHE_SIZE);
     this->fileSize = fileObj->GetSize();
+    this->fileLock = new FileLock();
+    this->isView   = false;
 
-    this->cache = new uint8[_cacheSize];
-    CHECK(this->cache, false, "Fail to allocate: %u bytes", _cacheSize);
-    this->cacheSize = _cacheSize;
-    this->start     = 0;
-    this->end       = 0;
+    SetupPages(_cacheSize, _cacheBudget);
 
     return true;
 }
-BufferView DataCache::Get(uint64 offset, uint32 requestedSize, bool failIfRequestedSizeCanNotBeRead)
+bool DataCache::InitView(DataCache& parent, uint64 _cacheBudget)
 {
-    CHECK(this->fileObj, BufferView(), "File was not properly initialized !");
-    CHECK(requestedSize > 0, BufferView(), "'requestedSize' has to be bigger than 0 ");
+    CHECK(this->cacheSize == 0, false, "Cache object already initialized !");
+    CHECK(parent.fileObj, false, "Parent cache object was not initialized !");
 
-    if (offset >= this->start)
+    this->fileObj    = parent.fileObj;
+    this->fileLock   = parent.fileLock;
+    this->isView     = true;
+    this->fileSize   = parent.fileSize;
+    this->mappedData = parent.mappedData;
+
+    SetupPages(parent.cacheSize, _cacheBudget);
+
+    if (this->mappedData)
     {
-        // data is cached --> return from here
-        if ((offset + requestedSize) <= this->end)
+        this->cache = this->mappedData;
+        this->start = 0;
+        this->end   = this->fileSize;
+    }
+
+    return true;
+}
+bool DataCache::MapFile(const std::filesystem::path& path)
+{
+    CHECK(this->fileObj, false, "Cache object was not initialized !");
+    CHECK(this->mappedData == nullptr, false, "File is already mapped !");
+    CHECK(this->isView == false, false, "Views are using the mapping of their parent !");
+#if defined(BUILD_FOR_UNIX) || defined(BUILD_FOR_OSX)
+    auto fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    CHECK(fd >= 0, false, "Fail to open: %s", path.string().c_str());
+
+    struct stat st;
+    auto res = fstat(fd, &st);
+    if ((res != 0) || (!S_ISREG(st.st_mode)) || (st.st_size <= 0) || ((uint64) st.st_size != this->fileSize))
+    {
+        // pipes, devices, empty files or files that changed since they were opened are read through the DataObject
+        close(fd);
+        return false;
+    }
+    auto m = mmap(nullptr, (size_t) this->fileSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // the mapping keeps its own reference to the file
+    CHECK(m != MAP_FAILED, false, "Fail to map %llu bytes from %s", this->fileSize, path.string().c_str());
+
+    // pages are no longer needed --> the kernel page cache is used directly
+    for (uint32 i = 0; i < this->pagesCount; i++)
+        delete[] this->pages[i].data;
+    this->pagesCount   = 0;
+    this->residentSize = 0;
+
+    this->mappedData = reinterpret_cast<uint8*>(m);
+    this->cache      = this->mappedData;
+    this->start      = 0;
+    this->end        = this->fileSize;
+    return true;
+#else
+    return false;
+#endif
+}
+DataCache::Page* DataCache::FindPage(uint64 offset, uint32 size)
+{
+    const auto endOffset = offset + size;
+    for (uint32 i = 0; i < this->pagesCount; i++)
+    {
+        auto& p = this->pages[i];
+        if ((offset >= p.start) && (endOffset <= p.end))
+            return &p;
+    }
+    return nullptr;
+}
+DataCache::Page* DataCache::AcquirePage(uint32 size)
+{
+    while (true)
+    {
+        // enough room for a new page
+        if ((this->pagesCount < MAX_PAGES) && (this->residentSize + size <= this->cacheBudget))
         {
-            this->currentPos = offset + requestedSize;
-            return BufferView(&this->cache[offset - this->start], requestedSize);
+            auto& p = this->pages[this->pagesCount];
+            p.data  = new uint8[size];
+            CHECK(p.data, nullptr, "Fail to allocate: %u bytes", size);
+            p.capacity = size;
+            p.start    = 0;
+            p.end      = 0;
+            this->pagesCount++;
+            this->residentSize += size;
+            return &p;
         }
-        if (this->end == this->fileSize)
+        // find the least recently used page
+        uint32 lru = 0;
+        for (uint32 i = 1; i < this->pagesCount; i++)
         {
-            // data is not cache (and we are at the end of the file with the case)
-            if (failIfRequestedSizeCanNotBeRead)
-                return BufferView();
-            this->currentPos = this->fileSize;
-            return BufferView(&this->cache[offset - this->start], (uint32) (this->end - offset));
+            if (this->pages[i].lastAccess < this->pages[lru].lastAccess)
+                lru = i;
+        }
+        auto& victim = this->pages[lru];
+        if (victim.data == this->cache)
+        {
+            this->cache = nullptr;
+            this->start = 0;
+            this->end   = 0;
         }
+        // reuse its buffer if it is large enough
+        if (victim.capacity >= size)
+        {
+            victim.start = 0;
+            victim.end   = 0;
+            return &victim;
+        }
+        // otherwise release it and try again
+        this->residentSize -= victim.capacity;
+        delete[] victim.data;
+        this->pagesCount--;
+        if (lru != this->pagesCount)
+            victim = this->pages[this->pagesCount];
     }
-    // request outside file
-    if (offset >= this->fileSize)
-        return BufferView();
-    // data is not available in cache ==> read it
+}
+DataCache::Page* DataCache::LoadPage(uint64 offset, uint32 size)
+{
+    // compute the area to be read
     uint64 _start, _end;
     if (this->fileSize <= this->cacheSize)
     {
@@ -98,48 +384,152 @@ BufferView DataCache::Get(uint64 offset, uint32 requestedSize, bool failIfReques
     }
     else
     {
-        // compute the new buffer to read
-        auto sz = requestedSize;
-        if ((offset + sz) > this->fileSize)
-            sz = (uint32) (this->fileSize - offset);
-        if (sz > this->cacheSize)
-            sz = this->cacheSize;
-        auto diff = this->cacheSize - sz;
-        if (diff <= offset)
-            _start = offset - diff;
-        else
-            _start = 0;
-        _end = _start + this->cacheSize;
-        if (_end > this->fileSize)
-            _end = this->fileSize;
-    }
-    // read new data in cache
-    if (this->fileObj->SetCurrentPos(_start) == false)
-        return BufferView();
-    if (this->fileObj->Read(this->cache, (uint32) (_end - _start)) == false)
+        // page aligned area that contains the requested block (and at least one page)
+        _start = offset & (~((uint64) PAGE_ALIGNMENT - 1));
+        _end   = std::max<uint64>(offset + size, _start + this->pageSize);
+        _end   = (_end + PAGE_ALIGNMENT - 1) & (~((uint64) PAGE_ALIGNMENT - 1));
+        _end   = std::min<uint64>(_end, this->fileSize);
+        if (_end - _start > this->cacheSize)
+        {
+            // alignment made the area too big --> end the area where the requested block ends
+            _end   = std::min<uint64>(std::max<uint64>(offset + size, this->cacheSize), this->fileSize);
+            _start = _end - this->cacheSize;
+        }
+    }
+    const auto sz = (uint32) (_end - _start);
+    auto p        = AcquirePage(sz);
+    CHECK(p, nullptr, "");
+
+    // read new data in the page
+    this->stats.readCalls++;
+    bool result;
     {
-        this->start = 0;
-        this->end   = 0;
-        return BufferView();
+        std::lock_guard<std::mutex> f(this->fileLock->lock);
+        result = this->fileObj->SetCurrentPos(_start) && this->fileObj->Read(p->data, sz);
     }
-    // return new pointer
-    this->start = _start;
-    this->end   = _end;
-    if ((offset + requestedSize) <= this->end)
+    if (!result)
+        return nullptr;
+    this->stats.bytesRead += sz;
+    p->start = _start;
+    p->end   = _end;
+    return p;
+}
+DataCache::Page* DataCache::TakePrefetchedPage(uint64 offset, uint32 size)
+{
+    if (this->prefetcher == nullptr)
+        return nullptr;
+    const auto sz = this->prefetcher->WaitFor(offset, size);
+    if (sz == 0)
+        return nullptr;
+    auto p = AcquirePage(sz);
+    CHECK(p, nullptr, "");
+    this->residentSize -= p->capacity;
+    this->prefetcher->MoveTo(*p);
+    this->residentSize += p->capacity;
+    this->stats.readCalls++;
+    this->stats.bytesRead += sz;
+    this->stats.prefetched++;
+    return p;
+}
+void DataCache::Prefetch(uint64 offset, uint32 size)
+{
+    CHECKRET(this->fileObj, "File was not properly initialized !");
+    if ((offset >= this->fileSize) || (size == 0))
+        return;
+    size = (uint32) std::min<uint64>({ (uint64) size, this->fileSize - offset, (uint64) this->cacheSize });
+    if (this->mappedData)
     {
+#if defined(BUILD_FOR_UNIX) || defined(BUILD_FOR_OSX)
+        // let the kernel read the pages in advance
+        const auto alignedOffset = offset & (~((uint64) PAGE_ALIGNMENT - 1));
+        madvise(this->mappedData + alignedOffset, (size_t) (offset + size - alignedOffset), MADV_WILLNEED);
+#endif
+        return;
+    }
+    if (FindPage(offset, size))
+        return; // already resident
+    if (this->prefetcher == nullptr)
+        this->prefetcher = new Prefetcher(this->fileObj, this->fileLock->lock);
+    this->prefetcher->Schedule(offset, offset + size);
+}
+void DataCache::SetActivePage(Page* page)
+{
+    page->lastAccess = ++this->accessTick;
+    this->cache      = page->data;
+    this->start      = page->start;
+    this->end        = page->end;
+}
+BufferView DataCache::Get(uint64 offset, uint32 requestedSize, bool failIfRequestedSizeCanNotBeRead)
+{
+    CHECK(this->fileObj, BufferView(), "File was not properly initialized !");
+    CHECK(requestedSize > 0, BufferView(), "'requestedSize' has to be bigger than 0 ");
+
+    // fast path --> data is in the most recently used page
+    if ((offset >= this->start) && ((offset + requestedSize) <= this->end))
+    {
+        this->stats.hits++;
         this->currentPos = offset + requestedSize;
         return BufferView(&this->cache[offset - this->start], requestedSize);
     }
-    // the entire data is not in our cache
-    if (failIfRequestedSizeCanNotBeRead)
+    // request outside file
+    if (offset >= this->fileSize)
         return BufferView();
-    if (this->end == this->fileSize)
+
+    // the size that can actually be provided (limited by the end of the file and the size of a block)
+    auto sz = requestedSize;
+    if ((offset + sz) > this->fileSize)
+        sz = (uint32) (this->fileSize - offset);
+    if (sz > this->cacheSize)
+        sz = this->cacheSize;
+
+    Page* p = nullptr;
+    if (this->mappedData)
+    {
+        // the entire file is available
+        this->stats.hits++;
+    }
+    else if ((p = FindPage(offset, sz)) != nullptr)
     {
-        this->currentPos = this->fileSize;
-        return BufferView(&this->cache[offset - this->start], (uint32) (this->end - offset));
+        this->stats.hits++;
     }
-    this->currentPos = this->end;
-    return BufferView(&this->cache[offset - this->start], (uint32) (this->end - offset));
+    else
+    {
+        this->stats.misses++;
+        // sequential access --> the request starts close to the end of the previous loaded area
+        const bool sequential = (this->lastLoadEnd != INVALID_OFFSET) && (offset + sz > this->lastLoadEnd) &&
+                                (offset < this->lastLoadEnd + PAGE_ALIGNMENT);
+        if ((p = TakePrefetchedPage(offset, sz)) == nullptr)
+            p = LoadPage(offset, sz);
+        if (p == nullptr)
+        {
+            this->cache = nullptr;
+            this->start = 0;
+            this->end   = 0;
+            return BufferView();
+        }
+        if ((sequential) && (p->end < this->fileSize))
+        {
+            // read the next area (of the same size) in background
+            // areas overlap with a 64K block so that small requests that cross the end of a page are also covered
+            const auto len = p->end - p->start;
+            const auto pos = ((len >= PAGE_ALIGNMENT) && (len + PAGE_ALIGNMENT <= this->cacheSize)) ? p->end - PAGE_ALIGNMENT : p->end;
+            Prefetch(pos, (uint32) len + (uint32) (p->end - pos));
+        }
+        this->lastLoadEnd = p->end;
+    }
+    if (p)
+        SetActivePage(p);
+
+    if (sz == requestedSize)
+    {
+        this->currentPos = offset + requestedSize;
+        return BufferView(&this->cache[offset - this->start], requestedSize);
+    }
+    // the entire data is not available
+    if (failIfRequestedSizeCanNotBeRead)
+        return BufferView();
+    this->currentPos = offset + sz;
+    return BufferView(&this->cache[offset - this->start], sz);
 }
 bool DataCache::CopyObject(void* buffer, uint64 offset, uint32 requestedSize)
 {
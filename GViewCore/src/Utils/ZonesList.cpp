@@ -3,9 +3,83 @@
 using namespace GView::Utils;
 using namespace AppCUI::Graphics;
 
+// The zones are sorted by (start, end descending) and a segment tree keeps the biggest end of every range of sorted zones.
+// A query for [low, high] only looks at the zones that start before high and skips every node whose biggest end is below low
+// -> every visited node leads to a result, O((k + 1) * log n) for k results.
 struct ZonesListContext {
-    std::vector<Zone> zones{};
-    std::vector<Zone> cache{};
+    struct Entry {
+        uint64 low, high;
+        uint32 index; // in zones
+    };
+
+    std::vector<Zone> zones{}; // in the order they were added
+    std::vector<Entry> sorted{};
+    std::vector<uint64> maxHigh{};
+    size_t leaves{ 0 };
+    bool dirty{ false };
+
+    void Build()
+    {
+        sorted.clear();
+        sorted.reserve(zones.size());
+        for (uint32 i = 0; i < zones.size(); i++) {
+            const auto& interval = zones[i].interval;
+            if (interval.low <= interval.high) {
+                sorted.push_back({ interval.low, interval.high, i });
+            }
+        }
+        std::sort(sorted.begin(), sorted.end(), [](const Entry& a, const Entry& b) {
+            if (a.low == b.low) {
+                return a.high > b.high;
+            }
+            return a.low < b.low;
+        });
+
+        leaves = 1;
+        while (leaves < sorted.size()) {
+            leaves <<= 1;
+        }
+        maxHigh.assign(leaves * 2, 0);
+        for (size_t i = 0; i < sorted.size(); i++) {
+            maxHigh[leaves + i] = sorted[i].high;
+        }
+        for (size_t i = leaves - 1; i > 0; i--) {
+            maxHigh[i] = std::max<>(maxHigh[i * 2], maxHigh[i * 2 + 1]);
+        }
+        dirty = false;
+    }
+
+    template <typename T>
+    bool Visit(size_t node, size_t left, size_t right, size_t count, uint64 low, T& callback) const
+    {
+        if (left >= count || maxHigh[node] < low) {
+            return true;
+        }
+        if (right - left == 1) {
+            return callback(sorted[left]);
+        }
+        const auto middle = (left + right) / 2;
+        if (!Visit(node * 2, left, middle, count, low, callback)) {
+            return false;
+        }
+        return Visit(node * 2 + 1, middle, right, count, low, callback);
+    }
+
+    // callback(const Entry&) for every zone that intersects [low, high], sorted by start
+    template <typename T>
+    void Query(uint64 low, uint64 high, T&& callback)
+    {
+        if (dirty) {
+            Build();
+        }
+        if (sorted.empty() || low > high) {
+            return;
+        }
+        // only the zones that start before high
+        const auto count = static_cast<size_t>(
+              std::upper_bound(sorted.begin(), sorted.end(), high, [](uint64 value, const Entry& e) { return value < e.low; }) - sorted.begin());
+        Visit(1, 0, leaves, count, low, callback);
+    }
 };
 
 ZonesList::ZonesList()
@@ -13,6 +87,19 @@ ZonesList::ZonesList()
     context = new ZonesListContext;
 }
 
+ZonesList::ZonesList(const ZonesList& other)
+{
+    context = new ZonesListContext(*reinterpret_cast<ZonesListContext*>(other.context));
+}
+
+ZonesList& ZonesList::operator=(const ZonesList& other)
+{
+    if (this != &other) {
+        *reinterpret_cast<ZonesListContext*>(context) = *reinterpret_cast<ZonesListContext*>(other.context);
+    }
+    return *this;
+}
+
 ZonesList::~ZonesList()
 {
     if (context != nullptr) {
@@ -25,6 +112,7 @@ bool ZonesList::Add(uint64 s, uint64 e, ColorPair c, std::string_view txt)
     CHECK(context != nullptr, false, "");
     auto ctx = reinterpret_cast<ZonesListContext*>(this->context);
     ctx->zones.emplace_back(s, e, c, txt);
+    ctx->dirty = true;
     return true;
 }
 
@@ -33,45 +121,49 @@ bool ZonesList::Add(const Zone& zone)
     CHECK(context != nullptr, false, "");
     auto ctx = reinterpret_cast<ZonesListContext*>(this->context);
     ctx->zones.emplace_back(zone);
+    ctx->dirty = true;
     return true;
 }
 
-std::optional<Zone> ZonesList::OffsetToZone(uint64 position) const
+bool ZonesList::Add(const std::vector<Zone>& zones)
 {
-    CHECK(context != nullptr, std::nullopt, "");
+    CHECK(context != nullptr, false, "");
     auto ctx = reinterpret_cast<ZonesListContext*>(this->context);
-
-    for (const auto& zone : ctx->cache) {
-        if (zone.interval.low <= position && position <= zone.interval.high) {
-            return zone;
-        }
-    }
-
-    return std::nullopt;
+    ctx->zones.insert(ctx->zones.end(), zones.begin(), zones.end());
+    ctx->dirty = true;
+    return true;
 }
 
-bool ZonesList::SetCache(const Zone::Interval& interval)
+void ZonesList::Reserve(uint32 count)
 {
-    CHECK(context != nullptr, false, "");
+    CHECKRET(context != nullptr, "");
     auto ctx = reinterpret_cast<ZonesListContext*>(this->context);
+    ctx->zones.reserve(count);
+}
 
-    ctx->cache.clear();
+std::optional<Zone> ZonesList::OffsetToZone(uint64 position) const
+{
+    CHECK(context != nullptr, std::nullopt, "");
+    auto ctx = reinterpret_cast<ZonesListContext*>(this->context);
 
-    for (const auto& zone : ctx->zones) {
-        if ((zone.interval.low >= interval.low && zone.interval.low <= interval.high) ||
-            interval.low >= zone.interval.low && interval.low <= zone.interval.high) {
-            ctx->cache.push_back(zone);
-        }
+    // the last zone (in the sorted order) that contains the position starts last and it is the smallest one for that start
+    const ZonesListContext::Entry* result = nullptr;
+    ctx->Query(position, position, [&result](const ZonesListContext::Entry& e) {
+        result = &e;
+        return true;
+    });
+    if (result == nullptr) {
+        return std::nullopt;
     }
+    return ctx->zones[result->index];
+}
 
-    std::sort(ctx->cache.begin(), ctx->cache.end(), [](const Zone& a, const Zone& b) {
-        if (a.interval.low == b.interval.low) {
-            return a.interval.high < b.interval.high;
-        }
-        return a.interval.low > b.interval.low;
-    });
+void ZonesList::ForEachInRange(const Zone::Interval& interval, const std::function<bool(const Zone&)>& callback) const
+{
+    CHECKRET(context != nullptr, "");
+    auto ctx = reinterpret_cast<ZonesListContext*>(this->context);
 
-    return true;
+    ctx->Query(interval.low, interval.high, [ctx, &callback](const ZonesListContext::Entry& e) { return callback(ctx->zones[e.index]); });
 }
 
 void ZonesList::Clear()
@@ -80,7 +172,10 @@ void ZonesList::Clear()
     auto ctx = reinterpret_cast<ZonesListContext*>(this->context);
 
     ctx->zones.clear();
-    ctx->cache.clear();
+    ctx->sorted.clear();
+    ctx->maxHigh.clear();
+    ctx->leaves = 0;
+    ctx->dirty  = false;
 }
 
 uint32 ZonesList::GetCount() const
@@ -0,0 +1,76 @@
+#include <catch.hpp>
+#include "Internal.hpp"
+#include <random>
+
+using namespace GView::Utils;
+
+TEST_CASE("ZonesListQueries", "[Utils]ZonesList")
+{
+    // nested & overlapping zones (some of them with the same start)
+    std::mt19937 gen(0x5A4F4E45);
+    std::vector<Zone> zones;
+    for (uint32 i = 0; i < 3000; i++)
+    {
+        const uint64 low  = gen() % 100000;
+        const uint64 size = (i % 10 == 0) ? gen() % 20000 : gen() % 200;
+        zones.emplace_back(low, low + size);
+        if (i % 7 == 0)
+            zones.emplace_back(low, low + size / 2);
+    }
+
+    ZonesList list;
+    for (uint32 i = 0; i < 100; i++)
+        REQUIRE(list.Add(zones[i]));
+    REQUIRE(list.Add(std::vector<Zone>(zones.begin() + 100, zones.end())));
+    REQUIRE(list.GetCount() == zones.size());
+    REQUIRE(list.GetZone(5)->interval.low == zones[5].interval.low);
+
+    for (uint32 i = 0; i < 2000; i++)
+    {
+        const uint64 offset = gen() % 130000;
+
+        // innermost zone: the biggest start, then the smallest end
+        std::optional<Zone> expected;
+        for (const auto& z : zones)
+        {
+            if (z.interval.low <= offset && offset <= z.interval.high)
+            {
+                if (!expected || z.interval.low > expected->interval.low ||
+                    (z.interval.low == expected->interval.low && z.interval.high < expected->interval.high))
+                    expected = z;
+            }
+        }
+        const auto zone = list.OffsetToZone(offset);
+        REQUIRE(zone.has_value() == expected.has_value());
+        if (zone)
+        {
+            REQUIRE(zone->interval.low == expected->interval.low);
+            REQUIRE(zone->interval.high == expected->interval.high);
+        }
+
+        const uint64 high = offset + gen() % 3000;
+        size_t count      = 0;
+        for (const auto& z : zones)
+            count += (z.interval.low <= high && offset <= z.interval.high) ? 1 : 0;
+
+        size_t found  = 0;
+        uint64 last   = 0;
+        bool inOrder  = true;
+        list.ForEachInRange({ offset, high }, [&](const Zone& z) {
+            inOrder &= z.interval.low >= last && z.interval.low <= high && z.interval.high >= offset;
+            last = z.interval.low;
+            found++;
+            return true;
+        });
+        REQUIRE(inOrder);
+        REQUIRE(found == count);
+    }
+
+    // copies are independent
+    ZonesList copy = list;
+    list.Clear();
+    REQUIRE(list.GetCount() == 0);
+    REQUIRE(list.OffsetToZone(zones[0].interval.low).has_value() == false);
+    REQUIRE(copy.GetCount() == zones.size());
+    REQUIRE(copy.OffsetToZone(zones[0].interval.low).has_value());
+}
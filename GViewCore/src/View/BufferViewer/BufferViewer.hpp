@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Internal.hpp"
+#include "SearchEngine.hpp"
+#include "ColorSpans.hpp"
 
 namespace GView::View::BufferViewer
 {
@@ -27,6 +29,7 @@ struct SettingsData {
     uint32 translationMethodsCount;
     Reference<OffsetTranslateInterface> offsetTranslateCallback{ nullptr };
     Reference<PositionToColorInterface> positionToColorCallback{ nullptr };
+    Reference<ZonesProviderInterface> zonesProvider{ nullptr };
     Reference<BufferColorInterface> bufferColorCallback{ nullptr };
     Reference<OnStartViewMoveInterface> onStartViewMoveCallback{ nullptr };
     Reference<BufferColorInterface> codeExecutionColorCallback{ nullptr };
@@ -98,8 +101,9 @@ class FindDialog : public Window, public Handlers::OnCheckInterface
 
     UnicodeStringBuilder usb;
     std::pair<uint64, uint64> match;
-    bool newRequest{ true };
-    bool ProcessInput(uint64 end = GView::Utils::INVALID_OFFSET, bool last = false);
+    SearchEngine engine;
+    bool ProcessInput(); // validates the input & compiles the pattern
+    bool Search(uint64 offset, bool backward);
 
   public:
     FindDialog();
@@ -270,6 +274,19 @@ class Instance : public View::ViewControl, public GView::Utils::SelectionZoneInt
         }
     } CurrentSelection;
 
+    struct UnicodeString {
+        uint64 start, middle, end; // the characters are shown compacted in [start, middle]
+    };
+    struct {
+        ColorSpans colors;
+        std::vector<ColorSpans::Span> layer;
+        std::vector<uint8> bytes; // copy of the visible bytes (and of the bytes around them needed by the layers)
+        uint64 bytesStart{ 0 };
+        std::vector<ColorPair> rangeColors;
+        std::vector<UnicodeString> unicodeStrings;
+        size_t unicodeIndex{ 0 };
+    } ViewColors;
+
     bool showSyncCompare{ false };
     bool moveInSync{ false };
     bool showTypeObjects{ true };
@@ -282,7 +299,6 @@ class Instance : public View::ViewControl, public GView::Utils::SelectionZoneInt
     CharacterBuffer chars;
     uint32 currentAdrressMode{ 0 };
     String addressModesList;
-    BufferColor bufColor;
     bool showColorNotFocused{ true };
 
     static Config config;
@@ -319,7 +335,15 @@ class Instance : public View::ViewControl, public GView::Utils::SelectionZoneInt
     bool SetStringAsciiMask(string_view stringRepresentation);
 
     ColorPair OffsetToColorZone(uint64 offset);
-    ColorPair OffsetToColor(uint64 offset);
+    std::optional<GView::Utils::Zone> OffsetToTypeZone(uint64 offset);
+    void ColorizeView(uint64 start, uint64 end);
+    void AddZonesLayer(const GView::Utils::ZonesList& zones, uint64 start, uint64 end);
+    void AddStringsLayer(uint64 start, uint64 end);
+    void AddTypeObjectsLayer(uint64 start, uint64 end);
+    void AddBufferColorLayer(uint64 start, uint64 end);
+    void AddSimilarTextLayer(uint64 start, uint64 end);
+    uint8 GetViewByte(uint64 offset);
+    char16 OffsetToCharacter(uint64 offset, uint8 value);
 
     void AnalyzeMousePosition(int x, int y, MousePositionInfo& mpInfo);
 
@@ -410,14 +434,7 @@ class Instance : public View::ViewControl, public GView::Utils::SelectionZoneInt
 
     bool SetZones(const GView::Utils::ZonesList& zones) override
     {
-        this->settings->zListObjects.Clear();
-
-        for (uint32 i = 0; i < zones.GetCount(); i++) {
-            const auto zone = zones.GetZone(i);
-            CHECK(zone.has_value(), false, "");
-            CHECK(this->settings->zListObjects.Add(*zone), false, "");
-        }
-
+        this->settings->zListObjects = zones;
         return true;
     }
 
@@ -0,0 +1,99 @@
+#include "ColorSpans.hpp"
+
+namespace GView::View::BufferViewer
+{
+static inline bool SameColor(const ColorPair& a, const ColorPair& b)
+{
+    return a.Foreground == b.Foreground && a.Background == b.Background;
+}
+
+void ColorSpans::Reset(uint64 start, uint64 end, ColorPair color)
+{
+    this->start        = start;
+    this->end          = std::max<>(start, end);
+    this->defaultColor = color;
+    this->current      = 0;
+    spans.clear();
+    if (start < end) {
+        spans.push_back({ start, end, color });
+    }
+}
+
+void ColorSpans::Append(uint64 spanStart, uint64 spanEnd, ColorPair color)
+{
+    if (spanStart >= spanEnd) {
+        return;
+    }
+    if (!merged.empty() && merged.back().end == spanStart && SameColor(merged.back().color, color)) {
+        merged.back().end = spanEnd;
+        return;
+    }
+    merged.push_back({ spanStart, spanEnd, color });
+}
+
+void ColorSpans::Overlay(const std::vector<Span>& layer)
+{
+    if (layer.empty() || spans.empty()) {
+        return;
+    }
+
+    merged.clear();
+    size_t index = 0; // current span of the old runs
+    uint64 pos   = start;
+
+    // copies the old runs from [pos, limit)
+    const auto copyUntil = [&](uint64 limit) {
+        while (pos < limit && index < spans.size()) {
+            if (spans[index].end <= pos) {
+                index++;
+                continue;
+            }
+            const auto pieceEnd = std::min<>(spans[index].end, limit);
+            Append(pos, pieceEnd, spans[index].color);
+            pos = pieceEnd;
+        }
+    };
+
+    for (const auto& s : layer) {
+        const auto spanStart = std::max<>(std::max<>(s.start, start), pos);
+        const auto spanEnd   = std::min<>(s.end, end);
+        if (spanStart >= spanEnd) {
+            continue;
+        }
+        copyUntil(spanStart);
+        Append(spanStart, spanEnd, s.color);
+        pos = spanEnd;
+    }
+    copyUntil(end);
+
+    std::swap(spans, merged);
+    current = 0;
+}
+
+void ColorSpans::Overlay(uint64 spanStart, uint64 spanEnd, ColorPair color)
+{
+    single.resize(1);
+    single[0] = { spanStart, spanEnd, color };
+    Overlay(single);
+}
+
+ColorPair ColorSpans::Get(uint64 offset)
+{
+    if (!Contains(offset) || spans.empty()) {
+        return defaultColor;
+    }
+    if (current >= spans.size() || spans[current].start > offset) {
+        current = 0;
+    }
+    // usually the same or the next run (the runs are contiguous)
+    if (spans[current].end <= offset) {
+        if (current + 1 < spans.size() && spans[current + 1].end > offset) {
+            current++;
+        } else {
+            const auto it = std::upper_bound(spans.begin() + current, spans.end(), offset, [](uint64 value, const Span& span) { return value < span.end; });
+            current       = static_cast<size_t>(it - spans.begin());
+        }
+    }
+    return spans[current].color;
+}
+} // namespace GView::View::BufferViewer
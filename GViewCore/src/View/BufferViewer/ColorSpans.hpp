@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Internal.hpp"
+
+namespace GView::View::BufferViewer
+{
+// Colors of the bytes of the visible window stored as runs of the same color.
+// The window is colored once per repaint, one layer at a time (zones, strings, plugins, similar text ...):
+// every layer is a sorted list of runs that is laid over the current runs in a single forward pass.
+class ColorSpans
+{
+  public:
+    struct Span {
+        uint64 start; // [start, end)
+        uint64 end;
+        ColorPair color;
+    };
+
+  private:
+    std::vector<Span> spans;
+    std::vector<Span> merged;
+    std::vector<Span> single;
+    uint64 start{ 0 };
+    uint64 end{ 0 };
+    ColorPair defaultColor{ NoColorPair };
+    size_t current{ 0 }; // last span returned by Get (the bytes are usually requested in order)
+
+    void Append(uint64 spanStart, uint64 spanEnd, ColorPair color);
+
+  public:
+    // the whole window [start, end) has the same color
+    void Reset(uint64 start, uint64 end, ColorPair color);
+    // layer must be sorted and must not overlap (the runs are clipped to the window)
+    void Overlay(const std::vector<Span>& layer);
+    void Overlay(uint64 spanStart, uint64 spanEnd, ColorPair color);
+    // color of an offset (the default color for offsets outside the window)
+    ColorPair Get(uint64 offset);
+
+    inline const std::vector<Span>& GetSpans() const
+    {
+        return spans;
+    }
+    inline bool Contains(uint64 offset) const
+    {
+        return offset >= start && offset < end;
+    }
+};
+} // namespace GView::View::BufferViewer
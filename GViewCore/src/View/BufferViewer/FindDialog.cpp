@@ -1,7 +1,6 @@
 #include "BufferViewer.hpp"
 
 #include <array>
-#include <regex>
 #include <charconv>
 
 namespace GView::View::BufferViewer
@@ -32,7 +31,7 @@ constexpr int32 GROUPD_ID_BUFFER_ACTION  = 5;
 constexpr uint32 DIALOG_HEIGHT_TEXT_FORMAT      = 18;
 constexpr uint32 DESCRIPTION_HEIGHT_TEXT_FORMAT = 3;
 constexpr std::string_view TEXT_FORMAT_TITLE    = "Text Pattern";
-constexpr std::string_view TEXT_FORMAT_BODY     = "Plain text or regex (ECMAScript) to find. Alt+I to focus on input text field.";
+constexpr std::string_view TEXT_FORMAT_BODY     = "Plain text or regex (RE2 syntax) to find. Alt+I to focus on input text field.";
 
 constexpr std::string_view BINARY_FORMAT_TITLE = "Binary Pattern";
 constexpr std::array<std::string_view, 4> BINARY_FORMAT_BODY{ "Binary pattern to find. Alt+I to focus on input text field.",
@@ -116,7 +115,6 @@ bool FindDialog::OnEvent(Reference<Control>, Event eventType, int ID)
             return true;
         case BTN_ID_OK:
             Exit(Dialogs::Result::Ok);
-            newRequest = true;
             CHECK(ProcessInput(), false, "");
             return true;
         }
@@ -126,7 +124,6 @@ bool FindDialog::OnEvent(Reference<Control>, Event eventType, int ID)
     {
     case Event::WindowAccept:
         Exit(Dialogs::Result::Ok);
-        newRequest = true;
         CHECK(ProcessInput(), false, "");
         return true;
     case Event::WindowClose:
@@ -297,28 +294,16 @@ void FindDialog::UpdateData(uint64 currentPos, Reference<GView::Object> object)
 std::pair<uint64, uint64> FindDialog::GetNextMatch(uint64 currentPos)
 {
     this->currentPos = currentPos;
-    ProcessInput();
+    Search(currentPos, false);
     return match;
 }
 
 std::pair<uint64, uint64> FindDialog::GetPreviousMatch(uint64 currentPos)
 {
-    const auto initialCurrentPos = this->currentPos;
-    while (true)
+    // matches that start at or before currentPos
+    if (Search(currentPos + 1, true))
     {
-        const auto end   = currentPos - 1;
-        this->currentPos = this->object->GetData().GetCacheSize() > currentPos ? 0 : currentPos - this->object->GetData().GetCacheSize();
-        ProcessInput(end, true);
-        if (HasResults())
-        {
-            this->currentPos = match.first;
-            break;
-        }
-        CHECKBK(this->currentPos, "");
-    };
-    if (HasResults() == false)
-    {
-        this->currentPos = initialCurrentPos;
+        this->currentPos = match.first;
     }
     return match;
 }
@@ -369,7 +354,7 @@ bool ValidateHex(std::string_view number)
         CHECK((number[0] >= '0' && number[0] <= '9') || (number[0] >= 'a' && number[0] <= 'f') || (number[0] >= 'A' && number[0] <= 'F'), false, "");
         if (number.size() == 2)
         {
-            CHECK((number[0] >= '1' && number[1] <= '9') || (number[1] >= 'a' && number[1] <= 'f') || (number[1] >= 'A' && number[1] <= 'F'), false, "");
+            CHECK((number[1] >= '0' && number[1] <= '9') || (number[1] >= 'a' && number[1] <= 'f') || (number[1] >= 'A' && number[1] <= 'F'), false, "");
         }
     }
     else
@@ -380,12 +365,13 @@ bool ValidateHex(std::string_view number)
     return true;
 }
 
-bool FindDialog::ProcessInput(uint64 end, bool last)
+bool FindDialog::ProcessInput()
 {
-    CHECK(currentPos != GView::Utils::INVALID_OFFSET, false, "");
-    CHECK(object.IsValid(), false, "");
     CHECK(input.IsValid(), false, "");
 
+    engine.Clear();
+    match = { GView::Utils::INVALID_OFFSET, 0 };
+
     if (input->GetText().Len() == 0)
     {
         Dialogs::MessageBox::ShowError("Error!", "Missing input!");
@@ -395,293 +381,156 @@ bool FindDialog::ProcessInput(uint64 end, bool last)
     CHECK(usb.Set(input->GetText()), false, "");
     CHECK(usb.Len() > 0, false, "");
 
-    if (newRequest)
-    {
-        match      = { GView::Utils::INVALID_OFFSET, 0 };
-        newRequest = false;
-    }
-
-    std::vector<TypeInterface::SelectionZone> selectedZones;
-    for (auto i = 0U; i < this->object->GetContentType()->GetSelectionZonesCount(); i++)
+    if (textOption->IsChecked())
     {
-        selectedZones.emplace_back(this->object->GetContentType()->GetSelectionZone(i));
-    }
-
-    const auto computeForFile = !searchSelection->IsChecked();
+        std::string text;
+        usb.ToString(text);
 
-    auto objectSize = 0ULL;
-    if (computeForFile)
-    {
-        if (last && end != GView::Utils::INVALID_OFFSET)
+        if (textRegex->IsChecked())
         {
-            objectSize = end - currentPos;
+            if (engine.SetRegex(text, textUnicode->IsChecked(), ignoreCase->IsChecked()) == false)
+            {
+                Dialogs::MessageBox::ShowError("Error!", "Invalid regular expression!");
+                return false;
+            }
+            return true;
         }
-        else
+
+        if (textAscii->IsChecked())
         {
-            objectSize = object->GetData().GetSize();
+            CHECK(engine.SetText(text, false, ignoreCase->IsChecked()), false, "");
         }
-    }
-    else
-    {
-        for (auto& sz : selectedZones)
+        else
         {
-            objectSize += sz.end - sz.start + 1;
+            const auto unicode = usb.ToStringView();
+            const std::string_view bytes{ reinterpret_cast<const char*>(unicode.data()), unicode.size() * sizeof(char16) };
+            CHECK(engine.SetText(bytes, true, ignoreCase->IsChecked()), false, "");
         }
+        return true;
     }
-    ProgressStatus::Init("Searching...", objectSize);
 
-    LocalString<512> ls;
-    const char* format = "Reading [0x%.8llX/0x%.8llX] bytes...";
-    if (objectSize > 0xFFFFFFFF)
-    {
-        format = "[0x%.16llX/0x%.16llX] bytes...";
-    }
+    std::string input;
+    usb.ToString(input);
 
-    const auto block = (last && end != GView::Utils::INVALID_OFFSET) ? (end - currentPos) : object->GetData().GetCacheSize();
+    // every byte is a value & a mask (0 for '?')
+    std::vector<uint8> values;
+    std::vector<uint8> masks;
+    values.reserve(input.size() / 2 + 1);
+    masks.reserve(input.size() / 2 + 1);
 
-    const auto SearchInAsciiChunk = [&](uint64 offset, uint64 left, const std::regex& pattern)
+    size_t last = 0;
+    while (last < input.size())
     {
-        do
+        auto current = input.find_first_of(' ', last);
+        if (current == std::string::npos)
         {
-            CHECK(ProgressStatus::Update(offset, ls.Format(format, offset, objectSize)) == false, false, "");
-
-            const auto sizeToRead = (left >= block ? block : left);
-            left -= (left >= block ? block : left);
-
-            const auto buffer = object->GetData().Get(offset, static_cast<uint32>(sizeToRead), true);
-            CHECK(buffer.IsValid(), false, "");
-
-            const auto initialStart = reinterpret_cast<char const*>(buffer.GetData());
-            auto start              = reinterpret_cast<char const*>(buffer.GetData());
-            const auto end          = reinterpret_cast<char const*>(start + buffer.GetLength());
-            std::cmatch matches{};
-            while (std::regex_search(start, end, matches, pattern))
-            {
-                match = std::pair<uint64, uint64>{ offset + (start - initialStart) + matches.position(), matches.length() };
-                start += matches.position() + matches.length();
-                CHECKBK(last, "");
-            }
+            current = input.size();
+        }
 
-            offset += sizeToRead;
-        } while (left > 0);
+        std::string_view number{ input.data() + last, current - last };
+        last = current + 1;
+        if (number.empty())
+        {
+            continue;
+        }
 
-        return true;
-    };
+        const auto isValid = textDec->IsChecked() ? ValidateDecimal(number) : ValidateHex(number);
+        if (isValid == false)
+        {
+            Dialogs::MessageBox::ShowError("Error!", "Invalid input!");
+            return false;
+        }
 
-    const auto SearchInUnicodeChunk = [&](uint64 offset, uint64 left, const std::wregex& pattern)
-    {
-        do
+        if (number[0] == '?')
         {
-            CHECK(ProgressStatus::Update(offset, ls.Format(format, offset, objectSize)) == false, false, "");
+            values.push_back(0);
+            masks.push_back(0);
+            continue;
+        }
 
-            const auto sizeToRead = (left >= block ? block : left);
-            left -= (left >= block ? block : left);
+        uint8 n                                 = 0;
+        const std::from_chars_result resultFrom = std::from_chars(number.data(), number.data() + number.size(), n, textDec->IsChecked() ? 10 : 16);
+        if (resultFrom.ec == std::errc::invalid_argument || resultFrom.ec == std::errc::result_out_of_range)
+        {
+            Dialogs::MessageBox::ShowError("Error!", "Invalid input - conversion failed!");
+            return false;
+        }
+        values.push_back(n);
+        masks.push_back(0xFF);
+    }
 
-            const auto buffer = object->GetData().Get(offset, static_cast<uint32>(sizeToRead), true);
-            CHECK(buffer.IsValid(), false, "");
+    if (engine.SetBytes(values, masks) == false)
+    {
+        Dialogs::MessageBox::ShowError("Error!", "Invalid input!");
+        return false;
+    }
 
-            auto initialStart = reinterpret_cast<wchar_t const*>(buffer.GetData());
-            auto start        = reinterpret_cast<wchar_t const*>(buffer.GetData());
-            const auto end    = reinterpret_cast<wchar_t const*>(start + buffer.GetLength());
-            std::wcmatch matches{};
-            while (std::regex_search(start, end, matches, pattern))
-            {
-                match = std::pair<uint64, uint64>{ offset + (start - initialStart) * sizeof(wchar_t) + matches.position(), matches.length() };
-                start += matches.position() + matches.length();
-                CHECKBK(last, "");
-            }
+    return true;
+}
 
-            offset += sizeToRead;
-        } while (left > 0);
+bool FindDialog::Search(uint64 offset, bool backward)
+{
+    CHECK(object.IsValid(), false, "");
 
-        return true;
-    };
+    match = { GView::Utils::INVALID_OFFSET, 0 };
+    CHECK(engine.IsValid(), false, "");
 
-    if (textOption->IsChecked())
+    // areas in the order they are searched
+    std::vector<std::pair<uint64, uint64>> areas;
+    if (searchSelection->IsChecked())
     {
-        if (textAscii->IsChecked())
+        for (auto i = 0U; i < this->object->GetContentType()->GetSelectionZonesCount(); i++)
         {
-            std::string ascii;
-            usb.ToString(ascii);
-
-            if (textRegex->IsChecked() == false)
-            {
-                const static std::regex specialChars{ R"([-[\]{}()*+?.,\^$|#\s])" };
-                ascii = std::regex_replace(ascii, specialChars, R"(\$&)");
-            }
-
-            const std::regex pattern(
-                  ascii,
-                  (ignoreCase->IsChecked() ? std::regex_constants::icase | std::regex_constants::ECMAScript | std::regex_constants::optimize
-                                           : std::regex_constants::ECMAScript | std::regex_constants::optimize));
-
-            if (computeForFile)
-            {
-                auto offset = currentPos;
-                auto left   = (last && end != GView::Utils::INVALID_OFFSET) ? (end - currentPos) : (object->GetData().GetSize() - currentPos);
-
-                CHECK(SearchInAsciiChunk(offset, left, pattern), false, "");
-                CHECK(HasResults() == false, true, "");
-            }
-            else
-            {
-                for (const auto& zone : selectedZones)
-                {
-                    auto offset = zone.start;
-                    auto left   = zone.end - zone.start + 1;
-
-                    CHECK(SearchInAsciiChunk(offset, left, pattern), false, "");
-                    CHECK(HasResults() == false, true, "");
-                }
-            }
+            const auto zone = this->object->GetContentType()->GetSelectionZone(i);
+            areas.emplace_back(zone.start, zone.end + 1);
         }
-        else
+        std::sort(areas.begin(), areas.end());
+        if (backward)
         {
-            std::wstring unicode{ reinterpret_cast<const wchar_t*>(usb.ToStringView().data()), usb.ToStringView().size() };
-
-            if (textRegex->IsChecked() == false)
-            {
-                const static std::wregex specialChars{ LR"([-[\]{}()*+?.,\^$|#\s])" };
-                unicode = std::regex_replace(unicode, specialChars, LR"(\$&)");
-            }
-
-            const std::wregex pattern(
-                  reinterpret_cast<wchar_t const* const>(usb.ToStringView().data()),
-                  (ignoreCase->IsChecked() ? std::regex_constants::icase | std::regex_constants::ECMAScript | std::regex_constants::optimize
-                                           : std::regex_constants::ECMAScript | std::regex_constants::optimize));
-
-            if (computeForFile)
-            {
-                auto offset = currentPos;
-                auto left   = (last && end != GView::Utils::INVALID_OFFSET) ? (end - currentPos) : (object->GetData().GetSize() - currentPos);
-
-                CHECK(SearchInUnicodeChunk(offset, left, pattern), false, "");
-                CHECK(HasResults() == false, true, "");
-            }
-            else
-            {
-                for (const auto& zone : selectedZones)
-                {
-                    auto offset = zone.start;
-                    auto left   = zone.end - zone.start + 1;
-
-                    CHECK(SearchInUnicodeChunk(offset, left, pattern), false, "");
-                    CHECK(HasResults() == false, true, "");
-                }
-            }
+            std::reverse(areas.begin(), areas.end());
         }
     }
     else
     {
-        std::string input;
-        usb.ToString(input);
-
-        std::string regexPayload;
-        regexPayload.reserve(input.size() * 2);
-
-        uint64 last    = 0;
-        uint64 current = input.find_first_of(' ', last);
-        do
-        {
-            if (current == std::string::npos)
-            {
-                current = input.size();
-            }
-
-            std::string_view number{ input.data() + last, current - last };
+        areas.emplace_back(0, object->GetData().GetSize());
+    }
 
-            if (textDec->IsChecked())
-            {
-                if (ValidateDecimal(number) == false)
-                {
-                    Dialogs::MessageBox::ShowError("Error!", "Invalid input!");
-                    return false;
-                }
-
-                if (number[0] == '?')
-                {
-                    regexPayload.append("[\\x00-\\xFF]");
-                }
-                else
-                {
-                    uint8 n;
-                    const std::from_chars_result resultFrom = std::from_chars(number.data(), number.data() + number.size(), n);
-                    if (resultFrom.ec == std::errc::invalid_argument || resultFrom.ec == std::errc::result_out_of_range)
-                    {
-                        Dialogs::MessageBox::ShowError("Error!", "Invalid input - conversion failed!");
-                        return false;
-                    }
-
-                    char hex[10]                        = { 0 };
-                    const std::to_chars_result resultTo = std::to_chars(std::begin(hex), std::end(hex), n, 16);
-                    if (resultTo.ec == std::errc::invalid_argument || resultTo.ec == std::errc::result_out_of_range)
-                    {
-                        Dialogs::MessageBox::ShowError("Error!", "Invalid input - conversion failed!");
-                        return false;
-                    }
-                    regexPayload.append("\\x");
-                    if (hex[1] == 0)
-                    {
-                        regexPayload.append("0");
-                    }
-                    regexPayload.append(hex);
-                }
-            }
-            else
-            {
-                if (number.size() > 2)
-                {
-                    Dialogs::MessageBox::ShowError("Error!", "Invalid input!");
-                    return false;
-                }
-
-                if (ValidateHex(number) == false)
-                {
-                    Dialogs::MessageBox::ShowError("Error!", "Invalid input!");
-                    return false;
-                }
-
-                if (number[0] == '?')
-                {
-                    regexPayload.append("[\\x00-\\xFF]");
-                }
-                else
-                {
-                    regexPayload.append("\\x");
-                    if (number.size() == 1)
-                    {
-                        regexPayload.append("0");
-                    }
-                    regexPayload.append(number);
-                }
-            }
-            last = current + 1;
-        } while ((current = input.find_first_of(' ', last)) && last < input.size());
+    uint64 objectSize = 0;
+    for (const auto& [start, end] : areas)
+    {
+        objectSize += end - start;
+    }
+    ProgressStatus::Init("Searching...", objectSize);
 
-        const std::regex pattern(
-              regexPayload,
-              (ignoreCase->IsChecked() ? std::regex_constants::icase | std::regex_constants::ECMAScript | std::regex_constants::optimize
-                                       : std::regex_constants::ECMAScript | std::regex_constants::optimize));
+    LocalString<512> ls;
+    const char* format = "Reading [0x%.8llX/0x%.8llX] bytes...";
+    if (objectSize > 0xFFFFFFFF)
+    {
+        format = "[0x%.16llX/0x%.16llX] bytes...";
+    }
 
-        if (computeForFile)
+    uint64 searched = 0;
+    bool canceled   = false;
+    for (const auto& [start, end] : areas)
+    {
+        if ((backward && offset <= start) || (!backward && offset >= end))
         {
-            auto offset = currentPos;
-            auto left   = (last && end != GView::Utils::INVALID_OFFSET) ? (end - currentPos) : (object->GetData().GetSize() - currentPos);
-
-            CHECK(SearchInAsciiChunk(offset, left, pattern), false, "");
-            CHECK(HasResults() == false, true, "");
+            continue;
         }
-        else
-        {
-            for (const auto& zone : selectedZones)
-            {
-                auto offset = zone.start;
-                auto left   = zone.end - zone.start + 1;
 
-                CHECK(SearchInAsciiChunk(offset, left, pattern), false, "");
-                CHECK(HasResults() == false, true, "");
-            }
+        SearchEngine::Match m;
+        const auto found = engine.Find(object->GetData(), start, end, offset, backward, m, [&](uint64 size) {
+            canceled = ProgressStatus::Update(searched + size, ls.Format(format, searched + size, objectSize));
+            return canceled == false;
+        });
+        if (found)
+        {
+            match = { m.start, m.length };
+            return true;
         }
+        CHECK(canceled == false, false, "");
+
+        searched += end - start;
     }
 
     return false;
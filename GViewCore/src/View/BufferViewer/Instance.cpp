@@ -47,7 +47,6 @@ Instance::Instance(Reference<GView::Object> _obj, Settings* _settings)
 
     memcpy(this->StringInfo.AsciiMask, DefaultAsciiMask, 256);
 
-    this->bufColor.Reset();
     this->ResetStringInfo();
 
     // settings
@@ -350,7 +349,7 @@ void Instance::MoveTillEndBlock(bool selected)
 }
 void Instance::MoveToZone(bool startOfZone, bool select)
 {
-    if (auto z = settings->zList.OffsetToZone(this->cursor.GetCurrentPosition())) {
+    if (auto z = OffsetToTypeZone(this->cursor.GetCurrentPosition())) {
         MoveTo(startOfZone ? z->interval.low : z->interval.high, select);
     }
 }
@@ -522,96 +521,208 @@ bool Instance::SetStringAsciiMask(string_view stringRepresentation)
 
 ColorPair Instance::OffsetToColorZone(uint64 offset)
 {
-    if (auto z = this->settings->zList.OffsetToZone(offset))
+    if (auto z = OffsetToTypeZone(offset))
         return z->color;
 
     return Cfg.Text.Inactive;
 }
-ColorPair Instance::OffsetToColor(uint64 offset)
+std::optional<GView::Utils::Zone> Instance::OffsetToTypeZone(uint64 offset)
 {
-    // current selection
-    if ((this->CurrentSelection.size) && (this->CurrentSelection.highlight)) {
-        if ((offset >= this->CurrentSelection.start) && (offset < this->CurrentSelection.end))
-            return Cfg.Selection.SimilarText;
-
-        auto b = this->obj->GetData().Get(offset, this->CurrentSelection.size, true);
-        if (b.IsValid()) {
-            if (b[0] == this->CurrentSelection.buffer[0]) {
-                if (memcmp(b.begin(), this->CurrentSelection.buffer, this->CurrentSelection.size) == 0) {
-                    this->CurrentSelection.start = offset;
-                    this->CurrentSelection.end   = offset + this->CurrentSelection.size;
-                    return Cfg.Selection.SimilarText;
-                }
-            }
+    // the zones that were added explicitly have priority over the computed ones
+    if (auto z = this->settings->zList.OffsetToZone(offset))
+        return z;
+    if (this->settings->zonesProvider)
+        return this->settings->zonesProvider->OffsetToZone(offset);
+    return std::nullopt;
+}
+void Instance::ColorizeView(uint64 start, uint64 end)
+{
+    auto& cache = this->obj->GetData();
+    ViewColors.colors.Reset(start, end, Cfg.Text.Inactive);
+    ViewColors.unicodeStrings.clear();
+    ViewColors.unicodeIndex = 0;
+    CHECKRET(start < end, "");
+
+    // the visible bytes are read once (a similar text may start before the view, a plugin may look at up to 16 bytes after a position)
+    const uint64 before   = std::min<uint64>(start, this->CurrentSelection.size > 0 ? this->CurrentSelection.size - 1 : 0);
+    const uint64 after    = std::max<uint64>(this->CurrentSelection.size, 16);
+    ViewColors.bytesStart = start - before;
+    const auto bytesEnd   = std::min<uint64>(end + after, cache.GetSize());
+    const auto buf        = cache.Get(ViewColors.bytesStart, static_cast<uint32>(bytesEnd - ViewColors.bytesStart), false);
+    ViewColors.bytes.assign(buf.begin(), buf.end());
+
+    // layers from the lowest to the highest priority
+    if (settings && showObjectsHighlighting) {
+        AddZonesLayer(this->settings->zListObjects, start, end);
+    } else {
+        if (this->settings->zonesProvider) {
+            this->settings->zonesProvider->ForEachZoneInRange({ start, end - 1 }, [this](const GView::Utils::Zone& zone) {
+                ViewColors.colors.Overlay(zone.interval.low, std::max<uint64>(zone.interval.high, zone.interval.high + 1), zone.color);
+                return true;
+            });
+        }
+        AddZonesLayer(this->settings->zList, start, end);
+        if (this->StringInfo.showAscii || this->StringInfo.showUnicode) {
+            AddStringsLayer(start, end);
+        }
+        if (settings && showTypeObjects && settings->positionToColorCallback) {
+            AddTypeObjectsLayer(start, end);
+        }
+        if (settings && (showCodeExecution || showSyncCompare) && settings->bufferColorCallback) {
+            AddBufferColorLayer(start, end);
         }
     }
+    if ((this->CurrentSelection.size) && (this->CurrentSelection.highlight)) {
+        AddSimilarTextLayer(start, end);
+    }
+}
+void Instance::AddZonesLayer(const GView::Utils::ZonesList& zones, uint64 start, uint64 end)
+{
+    // zones come sorted by start (and the outer zone first) --> the innermost zone is laid last, as OffsetToZone returns it
+    zones.ForEachInRange({ start, end - 1 }, [this](const GView::Utils::Zone& zone) {
+        ViewColors.colors.Overlay(zone.interval.low, std::max<uint64>(zone.interval.high, zone.interval.high + 1), zone.color);
+        return true;
+    });
+}
+void Instance::AddStringsLayer(uint64 start, uint64 end)
+{
+    auto& layer = ViewColors.layer;
+    layer.clear();
 
-    // color
-    if (settings) {
-        if (showObjectsHighlighting) {
-            if (auto z = this->settings->zListObjects.OffsetToZone(offset)) {
-                return z->color;
-            }
-            return Cfg.Text.Inactive;
+    auto offset = start;
+    while (offset < end) {
+        if ((offset < StringInfo.start) || (offset >= StringInfo.end)) {
+            UpdateStringInfo(offset);
+            CHECKBK((StringInfo.start != GView::Utils::INVALID_OFFSET) && (StringInfo.end > offset), "");
         }
-
-        if ((showCodeExecution || showSyncCompare) && settings->bufferColorCallback) {
-            if ((offset >= bufColor.start) && (offset <= bufColor.end))
-                return bufColor.color;
-
-            if (cursor.GetStartView() <= offset) {
-                auto b = this->obj->GetData().Get(offset, 1, true);
-                if (b.IsValid()) {
-                    if (settings->bufferColorCallback->GetColorForByteAt(
-                              offset,
-                              ViewData{ .viewStartOffset   = cursor.GetStartView(),
-                                        .viewSize          = static_cast<uint64>(Layout.charactersPerLine) * Layout.visibleRows,
-                                        .cursorStartOffset = cursor.GetCurrentPosition(),
-                                        .byte              = b.GetData()[0] },
-                              bufColor.color)) {
-                        bufColor.start = offset;
-                        bufColor.end   = offset;
-                        return bufColor.color;
-                    }
-                }
-            }
-            // no color provided for the specific buffer --> check show types
+        switch (StringInfo.type) {
+        case StringType::Ascii:
+            layer.push_back({ offset, StringInfo.end, config.Colors.Ascii });
+            break;
+        case StringType::Unicode:
+            layer.push_back({ offset, StringInfo.end, config.Colors.Unicode });
+            ViewColors.unicodeStrings.push_back({ StringInfo.start, StringInfo.middle, StringInfo.end });
+            break;
+        default:
+            break;
         }
+        offset = StringInfo.end;
+    }
 
-        if (showTypeObjects && settings->positionToColorCallback) {
-            if ((offset >= bufColor.start) && (offset <= bufColor.end))
-                return bufColor.color;
-            if (settings->positionToColorCallback->GetColorForBuffer(offset, this->obj->GetData().Get(offset, 16, false), bufColor))
-                return bufColor.color;
+    ViewColors.colors.Overlay(layer);
+}
+void Instance::AddTypeObjectsLayer(uint64 start, uint64 end)
+{
+    auto& layer = ViewColors.layer;
+    layer.clear();
+
+    const auto* bytes   = ViewColors.bytes.data();
+    const auto bytesEnd = ViewColors.bytesStart + ViewColors.bytes.size();
+    BufferColor result;
+    for (auto offset = start; offset < end && offset < bytesEnd;) {
+        const auto bf = BufferView(bytes + (offset - ViewColors.bytesStart), static_cast<size_t>(std::min<uint64>(16, bytesEnd - offset)));
+        result.Reset();
+        if (settings->positionToColorCallback->GetColorForBuffer(offset, bf, result)) {
+            // the color is provided for [offset, result.end]
+            const auto next = (result.end != GView::Utils::INVALID_OFFSET && result.end > offset) ? result.end + 1 : offset + 1;
+            layer.push_back({ offset, next, result.color });
+            offset = next;
+        } else {
+            offset++;
+        }
+    }
 
-            // no color provided for the specific buffer --> check strings and zones
+    ViewColors.colors.Overlay(layer);
+}
+void Instance::AddBufferColorLayer(uint64 start, uint64 end)
+{
+    auto& layer = ViewColors.layer;
+    layer.clear();
+
+    const auto bytesEnd = ViewColors.bytesStart + ViewColors.bytes.size();
+    end                 = std::min<uint64>(end, bytesEnd);
+    CHECKRET(start < end, "");
+
+    const auto size = static_cast<size_t>(end - start);
+    auto& colors    = ViewColors.rangeColors;
+    colors.resize(size);
+
+    const auto vd = ViewData{ .viewStartOffset   = cursor.GetStartView(),
+                              .viewSize          = static_cast<uint64>(Layout.charactersPerLine) * Layout.visibleRows,
+                              .cursorStartOffset = cursor.GetCurrentPosition(),
+                              .byte              = 0 };
+    const auto bf = BufferView(ViewColors.bytes.data() + (start - ViewColors.bytesStart), size);
+    CHECKRET(settings->bufferColorCallback->GetColorsForRange(start, bf, vd, colors.data()), "");
+
+    // consecutive bytes with the same color --> one run
+    for (size_t i = 0; i < size;) {
+        const auto c = colors[i];
+        auto j       = i + 1;
+        while (j < size && colors[j].Foreground == c.Foreground && colors[j].Background == c.Background) {
+            j++;
+        }
+        if (c.Foreground != NoColorPair.Foreground || c.Background != NoColorPair.Background) {
+            layer.push_back({ start + i, start + j, c });
         }
+        i = j;
     }
 
-    // check strings
-    if (this->StringInfo.showAscii || this->StringInfo.showUnicode) {
-        if ((offset >= StringInfo.start) && (offset < StringInfo.end)) {
-            switch (StringInfo.type) {
-            case StringType::Ascii:
-                return config.Colors.Ascii;
-            case StringType::Unicode:
-                return config.Colors.Unicode;
-            }
+    ViewColors.colors.Overlay(layer);
+}
+void Instance::AddSimilarTextLayer(uint64 start, uint64 end)
+{
+    auto& layer = ViewColors.layer;
+    layer.clear();
+
+    // the copy of the view starts with the first position where a text that ends in the view can start
+    const auto size  = static_cast<size_t>(this->CurrentSelection.size);
+    const auto first = this->CurrentSelection.buffer[0];
+    const auto count = ViewColors.bytes.size();
+    CHECKRET(count >= size, "");
+    const auto* s    = ViewColors.bytes.data();
+    const auto* last = s + (count - size); // last position where the text fits
+
+    for (const auto* p = s; p <= last;) {
+        p = reinterpret_cast<const uint8*>(memchr(p, first, last - p + 1));
+        if (p == nullptr) {
+            break;
+        }
+        const auto offset = ViewColors.bytesStart + (p - s);
+        if (offset >= end) {
+            break;
+        }
+        if (memcmp(p, this->CurrentSelection.buffer, size) == 0) {
+            layer.push_back({ offset, offset + size, Cfg.Selection.SimilarText });
+            p += size;
         } else {
-            UpdateStringInfo(offset);
-            if ((offset >= StringInfo.start) && (offset < StringInfo.end)) {
-                switch (StringInfo.type) {
-                case StringType::Ascii:
-                    return config.Colors.Ascii;
-                case StringType::Unicode:
-                    return config.Colors.Unicode;
-                }
-            }
+            p++;
         }
     }
 
-    // not a string --> check the zone
-    return OffsetToColorZone(offset);
+    ViewColors.colors.Overlay(layer);
+}
+uint8 Instance::GetViewByte(uint64 offset)
+{
+    if ((offset >= ViewColors.bytesStart) && (offset - ViewColors.bytesStart < ViewColors.bytes.size()))
+        return ViewColors.bytes[offset - ViewColors.bytesStart];
+    return this->obj->GetData().GetFromCache(offset);
+}
+char16 Instance::OffsetToCharacter(uint64 offset, uint8 value)
+{
+    // unicode strings are shown compacted: their characters first and then spaces
+    const auto& strings = ViewColors.unicodeStrings;
+    auto& index         = ViewColors.unicodeIndex;
+    if ((index < strings.size()) && (strings[index].start > offset))
+        index = 0;
+    while ((index < strings.size()) && (strings[index].end <= offset))
+        index++;
+    if ((index < strings.size()) && (strings[index].start <= offset)) {
+        const auto& str = strings[index];
+        if (offset > str.middle)
+            return ' ';
+        return codePage[GetViewByte(((offset - str.start) << 1) + str.start)];
+    }
+    return codePage[value];
 }
 
 void Instance::UpdateViewSizes()
@@ -753,7 +864,7 @@ void Instance::WriteLineAddress(DrawLineInfo& dli)
         }
 
         if (!z) {
-            z = this->settings->zList.OffsetToZone(dli.offset);
+            z = OffsetToTypeZone(dli.offset);
         }
 
         if (z) {
@@ -823,17 +934,10 @@ void Instance::WriteLineTextToChars(DrawLineInfo& dli)
         const auto startCh  = dli.chText;
         const auto ofsStart = dli.offset;
         while (dli.start < dli.end) {
-            cp = OffsetToColor(dli.offset);
+            cp = ViewColors.colors.Get(dli.offset);
             if (selection.Contains(dli.offset))
                 cp = Cfg.Selection.Editor;
-            if (StringInfo.type == StringType::Unicode) {
-                if (dli.offset > StringInfo.middle)
-                    dli.chText->Code = ' ';
-                else
-                    dli.chText->Code = codePage[obj->GetData().GetFromCache(((dli.offset - StringInfo.start) << 1) + StringInfo.start)];
-            } else {
-                dli.chText->Code = codePage[*dli.start];
-            }
+            dli.chText->Code  = OffsetToCharacter(dli.offset, *dli.start);
             dli.chText->Color = cp;
             dli.chText++;
             dli.start++;
@@ -864,7 +968,7 @@ void Instance::WriteLineNumbersToChars(DrawLineInfo& dli)
 
     while (dli.start < dli.end) {
         if (active) {
-            cp = OffsetToColor(dli.offset);
+            cp = ViewColors.colors.Get(dli.offset);
 
             if (selection.Contains(dli.offset)) {
                 cp = Cfg.Selection.Editor;
@@ -987,14 +1091,7 @@ void Instance::WriteLineNumbersToChars(DrawLineInfo& dli)
         c++;
 
         if (active) {
-            if (StringInfo.type == StringType::Unicode) {
-                if (dli.offset > StringInfo.middle)
-                    dli.chText->Code = ' ';
-                else
-                    dli.chText->Code = codePage[obj->GetData().GetFromCache(((dli.offset - StringInfo.start) << 1) + StringInfo.start)];
-            } else {
-                dli.chText->Code = codePage[*dli.start];
-            }
+            dli.chText->Code = OffsetToCharacter(dli.offset, *dli.start);
         } else {
             dli.chText->Code = codePage[*dli.start];
         }
@@ -1032,10 +1129,10 @@ void Instance::Paint(Renderer& renderer)
     WriteHeaders(renderer);
 
     const auto& startView = cursor.GetStartView();
-    if (showObjectsHighlighting) {
-        settings->zListObjects.SetCache({ startView, ((uint64) Layout.charactersPerLine) * (Layout.visibleRows - 1ull) + startView });
-    } else {
-        settings->zList.SetCache({ startView, ((uint64) Layout.charactersPerLine) * (Layout.visibleRows - 1ull) + startView });
+    const auto endView    = std::min<uint64>(((uint64) Layout.charactersPerLine) * Layout.visibleRows + startView, obj->GetData().GetSize());
+    // all the colors of the view are computed at once (instead of for every byte when the line is written)
+    if (this->showColorNotFocused || this->HasFocus()) {
+        ColorizeView(startView, endView);
     }
 
     DrawLineInfo dli;
@@ -1546,7 +1643,7 @@ int Instance::PrintCursorZone(int x, int y, uint32 width, Renderer& r)
     }
 
     if (!z) {
-        z = this->settings->zList.OffsetToZone(this->cursor.GetCurrentPosition());
+        z = OffsetToTypeZone(this->cursor.GetCurrentPosition());
     }
 
     if (z) {
@@ -0,0 +1,113 @@
+#include "Internal.hpp"
+
+#include <algorithm>
+#include <string>
+
+using namespace GView::View::BufferViewer;
+using namespace GView::Utils;
+
+namespace GView::View::BufferViewer
+{
+// a line ends with \n, \r, \r\n or \n\r (the line break is part of the line)
+struct LineZonesProviderContext {
+    DataCache* cache{ nullptr };
+    ColorPair color{ NoColorPair };
+    std::vector<uint64> lineStarts; // all the lines that start before scannedSize
+    uint64 scannedSize{ 0 };
+    uint8 lastBreak{ 0 }; // the last scanned byte was a line break (it can be followed by its pair)
+
+    bool IsFinished() const
+    {
+        return (cache == nullptr) || (scannedSize >= cache->GetSize());
+    }
+    void ScanNextChunk()
+    {
+        const auto size = cache->GetSize();
+        const auto buf  = cache->Get(scannedSize, static_cast<uint32>(std::min<uint64>(cache->GetCacheSize(), size - scannedSize)), false);
+        if (!buf.IsValid()) {
+            scannedSize = size; // can not read the rest --> the last line ends here
+            return;
+        }
+        const auto* p = buf.GetData();
+        const auto* e = p + buf.GetLength();
+        for (; p < e; p++) {
+            const auto ch = *p;
+            if ((ch != '\n') && (ch != '\r')) {
+                lastBreak = 0;
+                continue;
+            }
+            const auto next = scannedSize + static_cast<uint64>(p - buf.GetData()) + 1;
+            if ((lastBreak != 0) && (lastBreak != ch)) {
+                // \r\n or \n\r --> the line continues with the second character
+                lineStarts.back() = next;
+                lastBreak         = 0;
+            } else {
+                lineStarts.push_back(next);
+                lastBreak = ch;
+            }
+        }
+        scannedSize += buf.GetLength();
+        // a text that ends with a line break does not have an empty last line
+        if ((IsFinished()) && (lineStarts.size() > 1) && (lineStarts.back() >= size))
+            lineStarts.pop_back();
+    }
+    // makes sure that the line that contains offset (and its end) is known
+    void ScanUntil(uint64 offset)
+    {
+        // the start of the last line is final only if its first byte was scanned (it can move after a \r or \n)
+        while ((!IsFinished()) && ((lineStarts.back() <= offset) || (lineStarts.back() >= scannedSize)))
+            ScanNextChunk();
+    }
+    Zone GetZone(size_t lineIndex) const
+    {
+        const auto end = lineIndex + 1 < lineStarts.size() ? lineStarts[lineIndex + 1] : cache->GetSize();
+        return Zone(lineStarts[lineIndex], end - 1, color, std::to_string(lineIndex));
+    }
+};
+} // namespace GView::View::BufferViewer
+
+#define CONTEXT (reinterpret_cast<LineZonesProviderContext*>(this->context))
+
+LineZonesProvider::LineZonesProvider() : context(new LineZonesProviderContext())
+{
+}
+LineZonesProvider::~LineZonesProvider()
+{
+    delete CONTEXT;
+    this->context = nullptr;
+}
+void LineZonesProvider::Init(DataCache& cache, ColorPair color)
+{
+    auto ctx         = CONTEXT;
+    ctx->cache       = &cache;
+    ctx->color       = color;
+    ctx->scannedSize = 0;
+    ctx->lastBreak   = 0;
+    ctx->lineStarts.clear();
+    ctx->lineStarts.push_back(0);
+}
+std::optional<Zone> LineZonesProvider::OffsetToZone(uint64 offset)
+{
+    auto ctx = CONTEXT;
+    CHECK(ctx->cache, std::nullopt, "Provider was not initialized !");
+    CHECK(offset < ctx->cache->GetSize(), std::nullopt, "");
+    ctx->ScanUntil(offset);
+    const auto it = std::upper_bound(ctx->lineStarts.begin(), ctx->lineStarts.end(), offset);
+    return ctx->GetZone(static_cast<size_t>(it - ctx->lineStarts.begin()) - 1);
+}
+void LineZonesProvider::ForEachZoneInRange(const Zone::Interval& interval, const std::function<bool(const Zone&)>& callback)
+{
+    auto ctx = CONTEXT;
+    CHECKRET(ctx->cache, "Provider was not initialized !");
+    CHECKRET(interval.low <= interval.high, "");
+    const auto size = ctx->cache->GetSize();
+    CHECKRET(interval.low < size, "");
+    ctx->ScanUntil(std::min<uint64>(interval.high, size - 1));
+    const auto it = std::upper_bound(ctx->lineStarts.begin(), ctx->lineStarts.end(), interval.low);
+    for (auto index = static_cast<size_t>(it - ctx->lineStarts.begin()) - 1; index < ctx->lineStarts.size(); index++) {
+        if (ctx->lineStarts[index] > interval.high)
+            break;
+        if (!callback(ctx->GetZone(index)))
+            break;
+    }
+}
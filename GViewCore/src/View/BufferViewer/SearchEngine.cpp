@@ -0,0 +1,401 @@
+#include "SearchEngine.hpp"
+#include "CpuFeatures.hpp"
+
+#include <bit>
+#include <cstring>
+#include <re2/re2.h>
+
+#if defined(GVIEW_X86_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#    define GVIEW_SEARCH_SSE2
+#endif
+
+namespace GView::View::BufferViewer
+{
+constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+struct BytePattern {
+    const uint8* values;
+    const uint8* masks;
+    size_t size;
+    uint32 first;
+    uint32 last;
+    bool exact;
+};
+
+static inline bool Verify(const BytePattern& p, const uint8* data)
+{
+    if (p.exact)
+        return memcmp(data, p.values, p.size) == 0;
+    for (size_t i = 0; i < p.size; i++)
+    {
+        if ((data[i] & p.masks[i]) != p.values[i])
+            return false;
+    }
+    return true;
+}
+
+// first position from [0, count) where the pattern matches (data has at least count + p.size - 1 bytes)
+static size_t FindFirst(const BytePattern& p, const uint8* data, size_t count)
+{
+    size_t i = 0;
+#ifdef GVIEW_SEARCH_SSE2
+    // 16 candidates at once -> only the positions where both anchors match are verified
+    const auto valueFirst = _mm_set1_epi8(static_cast<char>(p.values[p.first]));
+    const auto maskFirst  = _mm_set1_epi8(static_cast<char>(p.masks[p.first]));
+    const auto valueLast  = _mm_set1_epi8(static_cast<char>(p.values[p.last]));
+    const auto maskLast   = _mm_set1_epi8(static_cast<char>(p.masks[p.last]));
+    for (; i + 16 <= count; i += 16)
+    {
+        const auto blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + p.first));
+        const auto blockLast  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + p.last));
+        const auto eqFirst    = _mm_cmpeq_epi8(_mm_and_si128(blockFirst, maskFirst), valueFirst);
+        const auto eqLast     = _mm_cmpeq_epi8(_mm_and_si128(blockLast, maskLast), valueLast);
+        auto bits             = static_cast<uint32>(_mm_movemask_epi8(_mm_and_si128(eqFirst, eqLast)));
+        while (bits)
+        {
+            const auto j = static_cast<size_t>(std::countr_zero(bits));
+            if (Verify(p, data + i + j))
+                return i + j;
+            bits &= bits - 1;
+        }
+    }
+#endif
+    for (; i < count; i++)
+    {
+        if (((data[i + p.first] & p.masks[p.first]) == p.values[p.first]) && Verify(p, data + i))
+            return i;
+    }
+    return NOT_FOUND;
+}
+
+// last position from [0, count) where the pattern matches (data has at least count + p.size - 1 bytes)
+static size_t FindLast(const BytePattern& p, const uint8* data, size_t count)
+{
+    size_t i = count;
+#ifdef GVIEW_SEARCH_SSE2
+    const auto valueFirst = _mm_set1_epi8(static_cast<char>(p.values[p.first]));
+    const auto maskFirst  = _mm_set1_epi8(static_cast<char>(p.masks[p.first]));
+    const auto valueLast  = _mm_set1_epi8(static_cast<char>(p.values[p.last]));
+    const auto maskLast   = _mm_set1_epi8(static_cast<char>(p.masks[p.last]));
+    while (i >= 16)
+    {
+        i -= 16;
+        const auto blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + p.first));
+        const auto blockLast  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + p.last));
+        const auto eqFirst    = _mm_cmpeq_epi8(_mm_and_si128(blockFirst, maskFirst), valueFirst);
+        const auto eqLast     = _mm_cmpeq_epi8(_mm_and_si128(blockLast, maskLast), valueLast);
+        auto bits             = static_cast<uint32>(_mm_movemask_epi8(_mm_and_si128(eqFirst, eqLast)));
+        while (bits)
+        {
+            const auto j = static_cast<size_t>(std::bit_width(bits) - 1);
+            if (Verify(p, data + i + j))
+                return i + j;
+            bits &= ~(1U << j);
+        }
+    }
+#endif
+    while (i > 0)
+    {
+        i--;
+        if (((data[i + p.first] & p.masks[p.first]) == p.values[p.first]) && Verify(p, data + i))
+            return i;
+    }
+    return NOT_FOUND;
+}
+
+SearchEngine::SearchEngine()
+{
+}
+
+SearchEngine::~SearchEngine()
+{
+}
+
+void SearchEngine::Clear()
+{
+    kind = Kind::None;
+    values.clear();
+    masks.clear();
+    firstAnchor = 0;
+    lastAnchor  = 0;
+    exact       = false;
+    regex.reset();
+    unicode = false;
+}
+
+bool SearchEngine::SetBytes(const std::vector<uint8>& _values, const std::vector<uint8>& _masks)
+{
+    Clear();
+    CHECK(_values.empty() == false, false, "Empty pattern !");
+    CHECK(_values.size() == _masks.size(), false, "");
+    CHECK(_values.size() < MAX_REGEX_MATCH_SIZE, false, "Pattern is too long !");
+
+    values = _values;
+    masks  = _masks;
+    exact  = true;
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        values[i] &= masks[i];
+        exact = exact && masks[i] == 0xFF;
+    }
+
+    // the anchors are the bytes compared with SIMD (if the pattern has only wildcards every position is a match)
+    for (size_t i = 0; i < masks.size(); i++)
+    {
+        if (masks[i] != 0)
+        {
+            firstAnchor = static_cast<uint32>(i);
+            break;
+        }
+    }
+    for (size_t i = masks.size(); i > 0; i--)
+    {
+        if (masks[i - 1] != 0)
+        {
+            lastAnchor = static_cast<uint32>(i - 1);
+            break;
+        }
+    }
+
+    kind = Kind::Bytes;
+
+    return true;
+}
+
+bool SearchEngine::SetText(std::string_view text, bool _unicode, bool ignoreCase)
+{
+    std::vector<uint8> v(text.begin(), text.end());
+    std::vector<uint8> m(text.size(), 0xFF);
+    if (ignoreCase)
+    {
+        for (size_t i = 0; i < v.size(); i++)
+        {
+            if (_unicode && ((i & 1) != 0 || i + 1 >= v.size() || v[i + 1] != 0))
+                continue; // only the UTF-16 code units from the ASCII range
+            if ((v[i] >= 'a' && v[i] <= 'z') || (v[i] >= 'A' && v[i] <= 'Z'))
+                m[i] = 0xDF; // lower & upper case letters differ only through 0x20
+        }
+    }
+
+    CHECK(SetBytes(v, m), false, "");
+    unicode = _unicode;
+
+    return true;
+}
+
+bool SearchEngine::SetRegex(std::string_view expression, bool _unicode, bool ignoreCase)
+{
+    Clear();
+    CHECK(expression.empty() == false, false, "Empty expression !");
+
+    RE2::Options options;
+    options.set_encoding(RE2::Options::EncodingLatin1);
+    options.set_case_sensitive(!ignoreCase);
+    options.set_longest_match(false);
+    options.set_log_errors(false);
+
+    absl::string_view asv{ expression.data(), expression.size() };
+    regex = std::make_unique<RE2>(asv, options);
+    if (!regex->ok())
+    {
+        regex.reset();
+        RETURNERROR(false, "Invalid expression !");
+    }
+
+    unicode = _unicode;
+    kind    = Kind::Regex;
+
+    return true;
+}
+
+bool SearchEngine::Find(
+      GView::Utils::DataCache& cache, uint64 areaStart, uint64 areaEnd, uint64 offset, bool backward, Match& match, const std::function<bool(uint64)>& onProgress)
+{
+    match = {};
+    areaEnd = std::min<uint64>(areaEnd, cache.GetSize());
+    CHECK(areaStart < areaEnd, false, "");
+
+    switch (kind)
+    {
+    case Kind::Bytes:
+        return FindBytes(cache, areaStart, areaEnd, offset, backward, match, onProgress);
+    case Kind::Regex:
+        return FindRegex(cache, areaStart, areaEnd, offset, backward, match, onProgress);
+    default:
+        RETURNERROR(false, "No pattern was set !");
+    }
+}
+
+bool SearchEngine::FindBytes(
+      GView::Utils::DataCache& cache, uint64 areaStart, uint64 areaEnd, uint64 offset, bool backward, Match& match, const std::function<bool(uint64)>& onProgress)
+{
+    const BytePattern pattern{ values.data(), masks.data(), values.size(), firstAnchor, lastAnchor, exact };
+    CHECK(areaEnd - areaStart >= pattern.size, false, "");
+    CHECK(cache.GetCacheSize() > pattern.size, false, "");
+
+    // consecutive chunks overlap with (size - 1) bytes -> every candidate is checked exactly once
+    const uint64 step      = cache.GetCacheSize() - (pattern.size - 1);
+    const uint64 lastStart = areaEnd - pattern.size;
+
+    if (!backward)
+    {
+        const auto from = std::max<uint64>(offset, areaStart);
+        for (auto pos = from; pos <= lastStart;)
+        {
+            CHECK(onProgress == nullptr || onProgress(pos - from), false, "");
+
+            const auto candidates = std::min<uint64>(step, lastStart - pos + 1);
+            const auto buffer     = cache.Get(pos, static_cast<uint32>(candidates + pattern.size - 1), true);
+            CHECK(buffer.IsValid(), false, "");
+
+            const auto index = FindFirst(pattern, buffer.GetData(), static_cast<size_t>(candidates));
+            if (index != NOT_FOUND)
+            {
+                match = { pos + index, pattern.size };
+                return true;
+            }
+            pos += candidates;
+        }
+        return false;
+    }
+
+    const auto from = std::min<uint64>(offset, lastStart + 1);
+    for (auto end = from; end > areaStart;)
+    {
+        CHECK(onProgress == nullptr || onProgress(from - end), false, "");
+
+        const auto candidates = std::min<uint64>(step, end - areaStart);
+        const auto pos        = end - candidates;
+        const auto buffer     = cache.Get(pos, static_cast<uint32>(candidates + pattern.size - 1), true);
+        CHECK(buffer.IsValid(), false, "");
+
+        const auto index = FindLast(pattern, buffer.GetData(), static_cast<size_t>(candidates));
+        if (index != NOT_FOUND)
+        {
+            match = { pos + index, pattern.size };
+            return true;
+        }
+        end = pos;
+    }
+    return false;
+}
+
+bool SearchEngine::FindRegex(
+      GView::Utils::DataCache& cache, uint64 areaStart, uint64 areaEnd, uint64 offset, bool backward, Match& match, const std::function<bool(uint64)>& onProgress)
+{
+    CHECK(cache.GetCacheSize() > 2 * MAX_REGEX_MATCH_SIZE, false, "");
+
+    // a chunk is searched together with the next MAX_REGEX_MATCH_SIZE bytes, but only the matches that start in the chunk are taken
+    const uint64 step = cache.GetCacheSize() - MAX_REGEX_MATCH_SIZE;
+    size_t start = 0, length = 0;
+
+    if (!backward)
+    {
+        const auto from = std::max<uint64>(offset, areaStart);
+        for (auto pos = from; pos < areaEnd;)
+        {
+            CHECK(onProgress == nullptr || onProgress(pos - from), false, "");
+
+            const auto size   = std::min<uint64>(cache.GetCacheSize(), areaEnd - pos);
+            const auto limit  = pos + size >= areaEnd ? size : step;
+            const auto buffer = cache.Get(pos, static_cast<uint32>(size), true);
+            CHECK(buffer.IsValid(), false, "");
+
+            if (SearchRegex(buffer, static_cast<size_t>(limit), false, start, length))
+            {
+                match = { pos + start, length };
+                return true;
+            }
+            pos += limit;
+        }
+        return false;
+    }
+
+    const auto from = std::min<uint64>(offset, areaEnd);
+    for (auto end = from; end > areaStart;)
+    {
+        CHECK(onProgress == nullptr || onProgress(from - end), false, "");
+
+        const auto candidates = std::min<uint64>(step, end - areaStart);
+        const auto pos        = end - candidates;
+        const auto size       = std::min<uint64>(cache.GetCacheSize(), areaEnd - pos);
+        const auto buffer     = cache.Get(pos, static_cast<uint32>(size), true);
+        CHECK(buffer.IsValid(), false, "");
+
+        if (SearchRegex(buffer, static_cast<size_t>(candidates), true, start, length))
+        {
+            match = { pos + start, length };
+            return true;
+        }
+        end = pos;
+    }
+    return false;
+}
+
+// first (or last) non empty match that starts before limit
+static bool SearchText(const RE2& regex, absl::string_view text, size_t limit, bool last, size_t& start, size_t& length)
+{
+    re2::StringPiece result;
+    bool found  = false;
+    size_t from = 0;
+    while (from < limit && from <= text.size())
+    {
+        if (!regex.Match(text, from, text.size(), RE2::UNANCHORED, &result, 1))
+            break;
+
+        const size_t s = result.data() - text.data();
+        if (s >= limit)
+            break;
+        if (result.empty())
+        {
+            from = s + 1;
+            continue;
+        }
+
+        start  = s;
+        length = result.size();
+        found  = true;
+        if (!last)
+            break;
+        from = s + result.size();
+    }
+    return found;
+}
+
+bool SearchEngine::SearchRegex(BufferView buffer, size_t limit, bool last, size_t& start, size_t& length)
+{
+    if (!unicode)
+    {
+        absl::string_view text{ reinterpret_cast<const char*>(buffer.GetData()), buffer.GetLength() };
+        return SearchText(*regex, text, limit, last, start, length);
+    }
+
+    // UTF-16 -> the expression is applied on the code units (the ones outside of Latin-1 are replaced with 0)
+    // for both alignments and the match closest to the search direction is kept
+    bool found = false;
+    for (size_t parity = 0; parity < 2; parity++)
+    {
+        if (buffer.GetLength() < parity + 2 || limit <= parity)
+            continue;
+
+        const auto count = (buffer.GetLength() - parity) / 2;
+        narrowed.resize(count);
+        const auto* data = buffer.GetData() + parity;
+        for (size_t k = 0; k < count; k++)
+            narrowed[k] = data[2 * k + 1] == 0 ? static_cast<char>(data[2 * k]) : 0;
+
+        size_t s = 0, l = 0;
+        if (SearchText(*regex, absl::string_view{ narrowed.data(), narrowed.size() }, (limit - parity + 1) / 2, last, s, l))
+        {
+            const auto candidate = parity + 2 * s;
+            if (!found || (last ? candidate > start : candidate < start))
+            {
+                start  = candidate;
+                length = 2 * l;
+                found  = true;
+            }
+        }
+    }
+    return found;
+}
+} // namespace GView::View::BufferViewer
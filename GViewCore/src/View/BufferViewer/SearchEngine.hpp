@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Internal.hpp"
+
+namespace re2
+{
+class RE2;
+}
+
+namespace GView::View::BufferViewer
+{
+// Pattern search used by the find dialog. The pattern is compiled once and then searched chunk by chunk
+// (through the DataCache) in any direction:
+//  - text & binary patterns -> every byte is compared as (data & mask) == value (wildcards have mask 0, ignore case clears 0x20)
+//                              and the candidates are filtered with SIMD on the first & last fixed bytes of the pattern
+//  - regular expressions    -> RE2 over Latin-1 (every byte of the data can be matched); for UTF-16 text the expression
+//                              is applied on the narrowed code units (for both alignments)
+class SearchEngine
+{
+  public:
+    static constexpr uint32 MAX_REGEX_MATCH_SIZE = 0x1000; // longer regex matches are truncated at the border of a chunk
+
+    struct Match {
+        uint64 start{ GView::Utils::INVALID_OFFSET };
+        uint64 length{ 0 };
+    };
+
+  private:
+    enum class Kind : uint8 { None, Bytes, Regex };
+
+    Kind kind{ Kind::None };
+
+    std::vector<uint8> values;
+    std::vector<uint8> masks;
+    uint32 firstAnchor{ 0 }; // first & last byte that is not a wildcard
+    uint32 lastAnchor{ 0 };
+    bool exact{ false };     // no wildcards & no ignore case -> memcmp
+
+    std::unique_ptr<re2::RE2> regex;
+    bool unicode{ false };
+    std::string narrowed;
+
+    bool FindBytes(GView::Utils::DataCache& cache, uint64 areaStart, uint64 areaEnd, uint64 offset, bool backward, Match& match, const std::function<bool(uint64)>& onProgress);
+    bool FindRegex(GView::Utils::DataCache& cache, uint64 areaStart, uint64 areaEnd, uint64 offset, bool backward, Match& match, const std::function<bool(uint64)>& onProgress);
+    bool SearchRegex(BufferView buffer, size_t limit, bool last, size_t& start, size_t& length);
+
+  public:
+    SearchEngine();
+    ~SearchEngine();
+
+    // values & masks have the same size (mask 0 -> any byte)
+    bool SetBytes(const std::vector<uint8>& values, const std::vector<uint8>& masks);
+    // text is the exact content to look for (UTF-16LE bytes if unicode is set)
+    bool SetText(std::string_view text, bool unicode, bool ignoreCase);
+    bool SetRegex(std::string_view expression, bool unicode, bool ignoreCase);
+    void Clear();
+
+    inline bool IsValid() const
+    {
+        return kind != Kind::None;
+    }
+
+    // matches are always inside [areaStart, areaEnd)
+    //  - forward  -> the first match that starts at or after offset
+    //  - backward -> the last match that starts before offset
+    // onProgress receives the number of bytes searched so far and returns false to cancel the search
+    bool Find(
+          GView::Utils::DataCache& cache,
+          uint64 areaStart,
+          uint64 areaEnd,
+          uint64 offset,
+          bool backward,
+          Match& match,
+          const std::function<bool(uint64)>& onProgress = nullptr);
+};
+} // namespace GView::View::BufferViewer
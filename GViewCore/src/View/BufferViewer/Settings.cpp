@@ -66,6 +66,11 @@ void Settings::SetPositionToColorCallback(Reference<PositionToColorInterface> cb
     ((SettingsData*) (this->data))->positionToColorCallback = cbk;
 }
 
+void Settings::SetZonesProvider(Reference<ZonesProviderInterface> provider)
+{
+    ((SettingsData*) (this->data))->zonesProvider = provider;
+}
+
 void Settings::SetEntryPointOffset(uint64 offset)
 {
     ((SettingsData*) (this->data))->entryPointOffset = offset;
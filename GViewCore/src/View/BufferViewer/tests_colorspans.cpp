@@ -0,0 +1,59 @@
+#include <catch.hpp>
+#include "ColorSpans.hpp"
+#include <random>
+
+using namespace GView::View::BufferViewer;
+
+TEST_CASE("ColorSpansOverlay", "[BufferViewer]Colors")
+{
+    // every layer is a set of random runs -> the result must be the same as painting every byte
+    constexpr uint64 start = 1000;
+    constexpr uint64 end   = 5000;
+    const ColorPair colors[] = { { Color::White, Color::Black }, { Color::Red, Color::Black }, { Color::Green, Color::Blue }, { Color::Yellow, Color::Red } };
+
+    std::mt19937 gen(0x434F4C52);
+    std::vector<uint32> expected(end - start, 0);
+
+    ColorSpans spans;
+    spans.Reset(start, end, colors[0]);
+    for (uint32 layerIndex = 0; layerIndex < 20; layerIndex++)
+    {
+        std::vector<ColorSpans::Span> layer;
+        uint64 offset = start - 100; // the first & the last runs may be outside the window
+        while (offset < end + 100)
+        {
+            offset += gen() % 200;
+            const auto length = 1 + gen() % 150;
+            const auto color  = 1 + gen() % 3;
+            layer.push_back({ offset, offset + length, colors[color] });
+            for (auto o = std::max<uint64>(offset, start); o < std::min<uint64>(offset + length, end); o++)
+                expected[o - start] = color;
+            offset += length;
+        }
+        spans.Overlay(layer);
+    }
+    spans.Overlay(start + 10, start + 20, colors[3]);
+    for (auto o = start + 10; o < start + 20; o++)
+        expected[o - start] = 3;
+
+    // forward, random & backward lookups
+    for (auto o = start; o < end; o++)
+        REQUIRE(spans.Get(o).Foreground == colors[expected[o - start]].Foreground);
+    for (uint32 i = 0; i < 1000; i++)
+    {
+        const auto o = start + gen() % (end - start);
+        REQUIRE(spans.Get(o).Background == colors[expected[o - start]].Background);
+    }
+    for (auto o = end; o > start; o--)
+        REQUIRE(spans.Get(o - 1).Foreground == colors[expected[o - 1 - start]].Foreground);
+
+    // runs are contiguous, cover the window and the neighbours have different colors
+    const auto& runs = spans.GetSpans();
+    REQUIRE(runs.front().start == start);
+    REQUIRE(runs.back().end == end);
+    for (size_t i = 1; i < runs.size(); i++)
+    {
+        REQUIRE(runs[i].start == runs[i - 1].end);
+        REQUIRE((runs[i].color.Foreground != runs[i - 1].color.Foreground || runs[i].color.Background != runs[i - 1].color.Background));
+    }
+}
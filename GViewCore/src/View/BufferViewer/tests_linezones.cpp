@@ -0,0 +1,77 @@
+#include <catch.hpp>
+#include "Internal.hpp"
+#include <random>
+
+using namespace GView::View::BufferViewer;
+using namespace GView::Utils;
+
+// [start, end] of every line (the line break is part of the line, \r\n and \n\r are a single line break)
+static std::vector<std::pair<uint64, uint64>> SplitLinesNaive(const std::string& data)
+{
+    std::vector<std::pair<uint64, uint64>> lines;
+    uint64 start = 0;
+    for (size_t i = 0; i < data.size(); i++) {
+        if ((data[i] != '\n') && (data[i] != '\r'))
+            continue;
+        if ((i + 1 < data.size()) && ((data[i + 1] == '\n') || (data[i + 1] == '\r')) && (data[i + 1] != data[i]))
+            i++;
+        lines.emplace_back(start, i);
+        start = i + 1;
+    }
+    if (start < data.size())
+        lines.emplace_back(start, data.size() - 1);
+    return lines;
+}
+
+TEST_CASE("LineZonesProvider", "[BufferViewer]Zones")
+{
+    static const std::vector<std::string> words = { "a", "some text", "\n", "\r", "\r\n", "\n\r", "\n\n", "\r\r" };
+    std::mt19937 gen(0x4C5A4F4E);
+    std::string data;
+    while (data.size() < 0x40000) {
+        data.append(words[gen() % words.size()]);
+        if (gen() % 100 == 0)
+            data.append(std::string(2000 + gen() % 0x20000, 'x')); // lines bigger than the cache
+    }
+    // line breaks split between two reads of the cache
+    data[0x10000 - 1] = '\r';
+    data[0x10000]     = '\n';
+    const auto expected = SplitLinesNaive(data);
+
+    DataCache cache;
+    auto memoryFile = std::make_unique<AppCUI::OS::MemoryFile>();
+    REQUIRE(memoryFile->Create(reinterpret_cast<const uint8*>(data.data()), data.size()));
+    REQUIRE(cache.Init(std::move(memoryFile), 0x10000));
+
+    LineZonesProvider provider;
+    provider.Init(cache, ColorPair{ Color::Gray, Color::Transparent });
+
+    // random lookups (the index grows only up to the requested offset)
+    for (uint32 i = 0; i < 3000; i++) {
+        const auto offset = (i < 1500 ? i * 7 : gen()) % data.size();
+        const auto line   = std::upper_bound(
+                                  expected.begin(), expected.end(), offset, [](uint64 value, const auto& l) { return value < l.first; }) -
+                          expected.begin() - 1;
+        const auto zone = provider.OffsetToZone(offset);
+        REQUIRE(zone.has_value());
+        REQUIRE(zone->interval.low == expected[line].first);
+        REQUIRE(zone->interval.high == expected[line].second);
+        REQUIRE(std::string_view(zone->name.GetText()) == std::to_string(line));
+    }
+    REQUIRE(provider.OffsetToZone(data.size()).has_value() == false);
+
+    // all the lines, enumerated in chunks
+    std::vector<std::pair<uint64, uint64>> lines;
+    for (uint64 offset = 0; offset < data.size(); offset += 5000) {
+        provider.ForEachZoneInRange({ offset, offset + 4999 }, [&](const Zone& zone) {
+            if (lines.empty() || lines.back().first < zone.interval.low)
+                lines.emplace_back(zone.interval.low, zone.interval.high);
+            return true;
+        });
+    }
+    REQUIRE(lines == expected);
+
+    size_t count = 0;
+    provider.ForEachZoneInRange({ 0, data.size() }, [&](const Zone&) { return ++count < 3; });
+    REQUIRE(count == 3);
+}
@@ -0,0 +1,130 @@
+#include <catch.hpp>
+#include "SearchEngine.hpp"
+#include <random>
+
+using namespace GView::View::BufferViewer;
+
+static GView::Utils::DataCache CreateCache(const std::vector<uint8>& data, uint32 cacheSize)
+{
+    GView::Utils::DataCache cache;
+    auto memoryFile = std::make_unique<AppCUI::OS::MemoryFile>();
+    REQUIRE(memoryFile->Create(data.data(), data.size()));
+    REQUIRE(cache.Init(std::move(memoryFile), cacheSize));
+    return cache;
+}
+
+static std::vector<uint64> FindAllNaive(const std::vector<uint8>& data, const std::vector<uint8>& values, const std::vector<uint8>& masks)
+{
+    std::vector<uint64> result;
+    for (size_t i = 0; i + values.size() <= data.size(); i++)
+    {
+        size_t j = 0;
+        while (j < values.size() && (data[i + j] & masks[j]) == (values[j] & masks[j]))
+            j++;
+        if (j == values.size())
+            result.push_back(i);
+    }
+    return result;
+}
+
+TEST_CASE("SearchEngineBytes", "[BufferViewer]Search")
+{
+    // small alphabet -> many partial matches; data larger than the cache -> matches crossing the chunk borders
+    std::mt19937 gen(0x46494E44);
+    std::vector<uint8> data(0x48000);
+    for (auto& b : data)
+        b = "aAbB\x00\xFF"[gen() % 6];
+    auto cache = CreateCache(data, 0x10000);
+
+    const std::vector<std::pair<std::vector<uint8>, std::vector<uint8>>> patterns = {
+        { { 'a' }, { 0xFF } },
+        { { 'a', 'b', 'a', 'b' }, { 0xFF, 0xFF, 0xFF, 0xFF } },
+        { { 'a', 'b', 'a', 'b', 'a' }, { 0xDF, 0xDF, 0xDF, 0xDF, 0xDF } },
+        { { 0x00, 0x00, 'B', 0xFF, 0x00 }, { 0xFF, 0x00, 0xFF, 0x00, 0xFF } },
+        { { 0x00, 0x00 }, { 0x00, 0x00 } },
+    };
+
+    for (const auto& [values, masks] : patterns)
+    {
+        SearchEngine engine;
+        REQUIRE(engine.SetBytes(values, masks));
+        const auto expected = FindAllNaive(data, values, masks);
+
+        std::vector<uint64> forward;
+        SearchEngine::Match match;
+        for (uint64 offset = 0; engine.Find(cache, 0, data.size(), offset, false, match); offset = match.start + 1)
+            forward.push_back(match.start);
+        REQUIRE(forward == expected);
+
+        std::vector<uint64> backward;
+        for (uint64 offset = data.size(); engine.Find(cache, 0, data.size(), offset, true, match); offset = match.start)
+            backward.push_back(match.start);
+        std::reverse(backward.begin(), backward.end());
+        REQUIRE(backward == expected);
+    }
+
+    // the matches must be inside the area
+    SearchEngine engine;
+    REQUIRE(engine.SetText("abab", false, true));
+    SearchEngine::Match match;
+    const auto expected = FindAllNaive(data, { 'a', 'b', 'a', 'b' }, { 0xDF, 0xDF, 0xDF, 0xDF });
+    const auto area     = std::find_if(expected.begin(), expected.end(), [](uint64 o) { return o > 0x20000; });
+    REQUIRE(area != expected.end());
+    REQUIRE(engine.Find(cache, 0x20000, *area + 3, 0, false, match) == false);
+    REQUIRE(engine.Find(cache, 0x20000, *area + 4, 0, false, match));
+    REQUIRE(match.start == *area);
+}
+
+TEST_CASE("SearchEngineRegex", "[BufferViewer]Search")
+{
+    std::mt19937 gen(0x52454758);
+    std::vector<uint8> data(0x30000);
+    for (auto& b : data)
+        b = "xyz10. "[gen() % 7];
+    const std::string_view ip = "10.1.10.1";
+    for (uint32 i = 0; i < 300; i++)
+    {
+        const auto pos = gen() % (data.size() / 2 - ip.size());
+        std::copy(ip.begin(), ip.end(), data.begin() + pos);
+        // the same text as UTF-16 in the second half of the buffer
+        auto upos = data.size() / 2 + gen() % (data.size() / 2 - ip.size() * 2);
+        for (auto c : ip)
+        {
+            data[upos++] = c;
+            data[upos++] = 0;
+        }
+    }
+    auto cache = CreateCache(data, 0x10000);
+
+    SearchEngine engine;
+    REQUIRE(engine.SetRegex(R"([0-9]+\.[0-9]+\.[0-9]+\.[0-9]+)", false, false));
+
+    std::vector<SearchEngine::Match> forward;
+    SearchEngine::Match match;
+    for (uint64 offset = 0; engine.Find(cache, 0, data.size(), offset, false, match); offset = match.start + match.length)
+        forward.push_back(match);
+    REQUIRE(forward.size() >= 300);
+    for (const auto& m : forward)
+    {
+        const std::string_view text{ reinterpret_cast<const char*>(data.data() + m.start), m.length };
+        REQUIRE(std::count(text.begin(), text.end(), '.') == 3);
+        REQUIRE((m.start == 0 || data[m.start - 1] < '0' || data[m.start - 1] > '9'));
+    }
+
+    // last match before the end of each forward match must be the match itself
+    for (const auto& m : forward)
+    {
+        REQUIRE(engine.Find(cache, 0, data.size(), m.start + 1, true, match));
+        REQUIRE(match.start == m.start);
+    }
+
+    SearchEngine unicode;
+    REQUIRE(unicode.SetRegex(R"(10\.1\.10\.1)", true, false));
+    REQUIRE(unicode.Find(cache, 0, data.size(), data.size() / 2, false, match));
+    REQUIRE(match.length == ip.size() * 2);
+    for (uint32 i = 0; i < ip.size(); i++)
+    {
+        REQUIRE(data[match.start + i * 2] == static_cast<uint8>(ip[i]));
+        REQUIRE(data[match.start + i * 2 + 1] == 0);
+    }
+}
@@ -76,6 +76,7 @@ void Config::Update(AppCUI::Utils::IniSection sect)
     sect.UpdateValue("Config.ShowFileContent", true, true);
     sect.UpdateValue("Config.ShowOnlyDissasm", false, true);
     sect.UpdateValue("Config.DeepScanDissasmOnStart", false, true);
+    sect.UpdateValue("Config.ControlFlowAnalysis", true, true);
     sect.UpdateValue("Config.CacheSameLocationAsAnalyzedFile", true, true);
 }
 
@@ -150,6 +151,7 @@ void Config::Initialize(const AppCUI::Application::Config& config)
             this->ShowFileContent                 = sect.GetValue("Config.ShowFileContent").ToBool(true);
             this->ShowOnlyDissasm                 = sect.GetValue("Config.ShowOnlyDissasm").ToBool(false);
             this->EnableDeepScanDissasmOnStart    = sect.GetValue("Config.DeepScanDissasmOnStart").ToBool(false);
+            this->EnableControlFlowAnalysis       = sect.GetValue("Config.ControlFlowAnalysis").ToBool(true);
             this->CacheSameLocationAsAnalyzedFile = sect.GetValue("Config.CacheSameLocationAsAnalyzedFile").ToBool(true);
             foundSettings                         = true;
         }
@@ -158,6 +160,7 @@ void Config::Initialize(const AppCUI::Application::Config& config)
         this->ShowFileContent                 = true;
         this->ShowOnlyDissasm                 = false;
         this->EnableDeepScanDissasmOnStart    = false;
+        this->EnableControlFlowAnalysis       = true;
         this->CacheSameLocationAsAnalyzedFile = true;
     }
 
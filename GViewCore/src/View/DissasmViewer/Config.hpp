@@ -197,6 +197,7 @@ namespace View
             bool ShowFileContent;
             bool ShowOnlyDissasm;
             bool EnableDeepScanDissasmOnStart;
+            bool EnableControlFlowAnalysis;
             bool CacheSameLocationAsAnalyzedFile;
             static void Update(AppCUI::Utils::IniSection sect);
             void UpdateColors(const AppCUI::Application::Config& config);
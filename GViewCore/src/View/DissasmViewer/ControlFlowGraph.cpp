@@ -0,0 +1,312 @@
+#include "ControlFlowGraph.hpp"
+#include "DissasmViewer.hpp"
+#include "DissasmFunctionUtils.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace GView::View::DissasmViewer;
+
+namespace
+{
+// one byte for every byte of the code: the size of the instruction that starts there and what is known about it
+constexpr uint8 INSTRUCTION_SIZE_MASK = 0x0F; // x86 instructions have at most 15 bytes
+constexpr uint8 INSTRUCTION_START     = 0x10;
+constexpr uint8 BLOCK_START           = 0x20;
+constexpr uint8 FUNCTION_START        = 0x40;
+constexpr uint8 NO_FALLTHROUGH        = 0x80; // the execution does not continue with the next instruction
+
+enum class InstructionFlow : uint8 { Next, Jump, ConditionalJump, Call, Stop };
+
+bool HasGroup(const cs_insn* insn, uint8 group)
+{
+    const auto groups = insn->detail->groups;
+    return std::find(groups, groups + insn->detail->groups_count, group) != groups + insn->detail->groups_count;
+}
+
+InstructionFlow GetInstructionFlow(const cs_insn* insn)
+{
+    if (!insn->detail)
+        return InstructionFlow::Next;
+    if (HasGroup(insn, CS_GRP_JUMP))
+        return (insn->id == X86_INS_JMP || insn->id == X86_INS_LJMP) ? InstructionFlow::Jump : InstructionFlow::ConditionalJump;
+    if (HasGroup(insn, CS_GRP_CALL))
+        return InstructionFlow::Call;
+    if (HasGroup(insn, CS_GRP_RET) || HasGroup(insn, CS_GRP_IRET))
+        return InstructionFlow::Stop;
+    switch (insn->id) {
+    case X86_INS_HLT:
+    case X86_INS_INT3:
+    case X86_INS_UD2:
+        return InstructionFlow::Stop;
+    default:
+        return InstructionFlow::Next;
+    }
+}
+
+// the state shared by the threads that explore the code: the function entries that were not explored yet (the blocks
+// reached by the jumps of a function are explored by the same thread) and the flags of every byte, that are only set
+// with atomic operations while the code is explored
+struct Exploration {
+    BufferView code;
+    std::vector<uint8>& info;
+    std::vector<uint64> functions;
+    std::mutex lock;
+    std::condition_variable hasWork;
+    uint32 busyThreads;
+};
+
+inline uint8 AddFlags(uint8& flags, uint8 value)
+{
+    return std::atomic_ref<uint8>(flags).fetch_or(value, std::memory_order_relaxed);
+}
+
+inline uint8 GetFlags(uint8& flags)
+{
+    return std::atomic_ref<uint8>(flags).load(std::memory_order_relaxed);
+}
+
+// recursive descent: every target is decoded until the flow stops or reaches decoded code
+void Explore(Exploration& state, DissasmDecoder& decoder, std::vector<std::pair<uint64, uint64>>& branches)
+{
+    const uint64 size = state.code.GetLength();
+    auto& info        = state.info;
+    std::vector<uint64> worklist;
+
+    auto addTarget = [&](uint64 target, uint8 flags) {
+        if (target >= size)
+            return;
+        const auto oldFlags = AddFlags(info[target], flags);
+        if ((oldFlags & (INSTRUCTION_START | BLOCK_START)) != 0)
+            return;
+        if ((flags & FUNCTION_START) == 0) {
+            worklist.push_back(target);
+            return;
+        }
+        std::scoped_lock<std::mutex> guard(state.lock);
+        state.functions.push_back(target);
+        state.hasWork.notify_one();
+    };
+
+    const auto insn = decoder.GetInstruction();
+    while (true) {
+        {
+            std::unique_lock<std::mutex> guard(state.lock);
+            state.hasWork.wait(guard, [&state]() { return !state.functions.empty() || state.busyThreads == 0; });
+            if (state.functions.empty())
+                return; // no function is left and no thread can add a new one
+            worklist.push_back(state.functions.back());
+            state.functions.pop_back();
+            state.busyThreads++;
+        }
+
+        while (!worklist.empty()) {
+            auto offset = worklist.back();
+            worklist.pop_back();
+
+            while (offset < size) {
+                if (GetFlags(info[offset]) & INSTRUCTION_START) {
+                    AddFlags(info[offset], BLOCK_START); // two paths join here
+                    break;
+                }
+                const uint8* data = state.code.GetData() + offset;
+                size_t dataSize   = static_cast<size_t>(size - offset);
+                uint64 address    = offset;
+                if (!decoder.Decode(data, dataSize, address))
+                    break;
+                if (AddFlags(info[offset], INSTRUCTION_START | (insn->size & INSTRUCTION_SIZE_MASK)) & INSTRUCTION_START) {
+                    AddFlags(info[offset], BLOCK_START); // decoded by another thread in the meantime
+                    break;
+                }
+
+                const auto next = offset + insn->size;
+                uint64 target   = 0;
+                const auto flow = GetInstructionFlow(insn);
+                if (flow == InstructionFlow::Jump || flow == InstructionFlow::ConditionalJump) {
+                    if (ExtractInsnBranchTarget(insn, target) && target < size) {
+                        branches.emplace_back(offset, target);
+                        addTarget(target, BLOCK_START);
+                    }
+                    if (flow == InstructionFlow::ConditionalJump) {
+                        if (next < size)
+                            AddFlags(info[next], BLOCK_START);
+                    } else {
+                        AddFlags(info[offset], NO_FALLTHROUGH);
+                        break;
+                    }
+                } else if (flow == InstructionFlow::Call) {
+                    if (ExtractInsnBranchTarget(insn, target))
+                        addTarget(target, BLOCK_START | FUNCTION_START);
+                } else if (flow == InstructionFlow::Stop) {
+                    AddFlags(info[offset], NO_FALLTHROUGH);
+                    break;
+                }
+                offset = next;
+            }
+        }
+
+        std::scoped_lock<std::mutex> guard(state.lock);
+        if (--state.busyThreads == 0 && state.functions.empty())
+            state.hasWork.notify_all();
+    }
+}
+} // namespace
+
+void ControlFlowGraph::Clear()
+{
+    blocks.clear();
+    successors.clear();
+    functions.clear();
+    ranges.clear();
+    jumpTargets.clear();
+}
+
+bool ControlFlowGraph::Build(DissasmDecoder& decoder, BufferView code, const std::vector<uint64>& entryPoints, uint32 threads)
+{
+    Clear();
+    CHECK(decoder.IsValid(), false, "");
+    CHECK(code.IsValid(), false, "");
+
+    const uint64 size = code.GetLength();
+    std::vector<uint8> info(size, 0);
+    Exploration state{ code, info, {}, {}, {}, 0 };
+    for (const auto entryPoint : entryPoints) {
+        if (entryPoint < size && (info[entryPoint] & FUNCTION_START) == 0) {
+            info[entryPoint] |= BLOCK_START | FUNCTION_START;
+            state.functions.push_back(entryPoint);
+        }
+    }
+
+    // every thread has its own decoder (a capstone handle can not be shared between threads) and its own list of branches
+    std::vector<std::vector<std::pair<uint64, uint64>>> threadBranches(std::max<uint32>(threads, 1));
+    std::vector<std::thread> workers;
+    workers.reserve(threadBranches.size() - 1);
+    for (size_t index = 1; index < threadBranches.size(); index++) {
+        workers.emplace_back([&state, &branches = threadBranches[index], mode = decoder.GetMode()]() {
+            DissasmDecoder workerDecoder;
+            if (workerDecoder.Init(CS_ARCH_X86, mode))
+                Explore(state, workerDecoder, branches);
+        });
+    }
+    Explore(state, decoder, threadBranches[0]);
+    for (auto& worker : workers)
+        worker.join();
+
+    auto& branches = threadBranches[0]; // jump instruction -> target
+    for (size_t index = 1; index < threadBranches.size(); index++)
+        branches.insert(branches.end(), threadBranches[index].begin(), threadBranches[index].end());
+
+    // blocks: runs of consecutive instructions that end before a block start or after a jump/return
+    std::vector<uint64> lastInstructions;
+    for (uint64 offset = 0; offset < size;) {
+        if ((info[offset] & INSTRUCTION_START) == 0) {
+            offset++;
+            continue;
+        }
+        auto current = offset;
+        while (true) {
+            const auto next = current + (info[current] & INSTRUCTION_SIZE_MASK);
+            if ((info[current] & NO_FALLTHROUGH) || next >= size || (info[next] & (INSTRUCTION_START | BLOCK_START)) != INSTRUCTION_START)
+                break;
+            current = next;
+        }
+        const auto end = std::min<uint64>(current + (info[current] & INSTRUCTION_SIZE_MASK), size);
+        blocks.push_back({ offset, end, INVALID_INDEX, 0, 0 });
+        lastInstructions.push_back(current);
+        offset = end;
+    }
+    CHECK(!blocks.empty(), false, "No instruction was decoded!");
+
+    auto blockStartingAt = [this](uint64 offset) -> uint32 {
+        const auto it = std::lower_bound(blocks.begin(), blocks.end(), offset, [](const Block& block, uint64 value) { return block.start < value; });
+        if (it == blocks.end() || it->start != offset)
+            return INVALID_INDEX;
+        return static_cast<uint32>(it - blocks.begin());
+    };
+
+    std::sort(branches.begin(), branches.end());
+    successors.reserve(blocks.size() * 2);
+    for (uint32 index = 0; index < blocks.size(); index++) {
+        auto& block          = blocks[index];
+        const auto last      = lastInstructions[index];
+        block.firstSuccessor = static_cast<uint32>(successors.size());
+        auto it              = std::lower_bound(branches.begin(), branches.end(), std::pair<uint64, uint64>{ last, 0 });
+        for (; it != branches.end() && it->first == last; ++it) {
+            const auto target = blockStartingAt(it->second);
+            if (target != INVALID_INDEX)
+                successors.push_back(target);
+        }
+        if ((info[last] & NO_FALLTHROUGH) == 0 && block.end < size && (info[block.end] & INSTRUCTION_START)) {
+            const auto next = blockStartingAt(block.end);
+            if (next != INVALID_INDEX)
+                successors.push_back(next);
+        }
+        block.successorsCount = static_cast<uint32>(successors.size()) - block.firstSuccessor;
+    }
+
+    for (const auto& branch : branches) {
+        if (blockStartingAt(branch.second) != INVALID_INDEX) // targets inside of other instructions are ignored
+            jumpTargets.push_back(branch.second);
+    }
+    std::sort(jumpTargets.begin(), jumpTargets.end());
+    jumpTargets.erase(std::unique(jumpTargets.begin(), jumpTargets.end()), jumpTargets.end());
+
+    // functions: the blocks reachable from an entry through jumps (a block shared by more functions belongs to the first one)
+    for (uint32 index = 0; index < blocks.size(); index++) {
+        if (info[blocks[index].start] & FUNCTION_START)
+            functions.push_back({ blocks[index].start, blocks[index].end, index });
+    }
+    std::vector<uint32> stack;
+    for (uint32 function = 0; function < functions.size(); function++) {
+        const auto entryBlock = functions[function].entryBlock;
+        if (blocks[entryBlock].function != INVALID_INDEX)
+            continue;
+        blocks[entryBlock].function = function;
+        stack.push_back(entryBlock);
+        while (!stack.empty()) {
+            const auto& block = blocks[stack.back()];
+            stack.pop_back();
+            for (const auto successor : GetSuccessors(block)) {
+                if (blocks[successor].function == INVALID_INDEX && (info[blocks[successor].start] & FUNCTION_START) == 0) {
+                    blocks[successor].function = function;
+                    stack.push_back(successor);
+                }
+            }
+        }
+    }
+
+    for (const auto& block : blocks) {
+        if (block.function == INVALID_INDEX)
+            continue;
+        auto& function = functions[block.function];
+        const auto nextEntry = block.function + 1 < functions.size() ? functions[block.function + 1].entry : size;
+        if (block.start < nextEntry)
+            function.end = std::max<uint64>(function.end, std::min<uint64>(block.end, nextEntry));
+        if (!ranges.empty() && ranges.back().function == block.function && ranges.back().end == block.start)
+            ranges.back().end = block.end;
+        else
+            ranges.push_back({ block.start, block.end, block.function });
+    }
+    return true;
+}
+
+uint32 ControlFlowGraph::FindBlock(uint64 offset) const
+{
+    auto it = std::upper_bound(blocks.begin(), blocks.end(), offset, [](uint64 value, const Block& block) { return value < block.start; });
+    if (it == blocks.begin())
+        return INVALID_INDEX;
+    --it;
+    return offset < it->end ? static_cast<uint32>(it - blocks.begin()) : INVALID_INDEX;
+}
+
+uint32 ControlFlowGraph::FindFunction(uint64 offset) const
+{
+    auto it = std::upper_bound(ranges.begin(), ranges.end(), offset, [](uint64 value, const Range& range) { return value < range.start; });
+    if (it == ranges.begin())
+        return INVALID_INDEX;
+    --it;
+    return offset < it->end ? it->function : INVALID_INDEX;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Internal.hpp"
+
+namespace GView::View::DissasmViewer
+{
+class DissasmDecoder;
+
+// Basic blocks and functions of a x86/x64 code zone, found by recursive descent (with a work queue) from a list of entry
+// points: direct jumps add blocks to the current function and direct calls add new functions. Code reached only through
+// indirect jumps or calls is not found. Every byte is decoded at most once (unless two threads reach it at the same time)
+// and all the offsets are relative to the start of the zone.
+class ControlFlowGraph
+{
+  public:
+    static constexpr uint32 INVALID_INDEX = 0xFFFFFFFF;
+
+    struct Block {
+        uint64 start;
+        uint64 end; // after the last instruction
+        uint32 function;
+        uint32 firstSuccessor; // index in successors
+        uint32 successorsCount;
+    };
+    struct Function {
+        uint64 entry;
+        uint64 end; // after the last block of the function placed before the next function
+        uint32 entryBlock;
+    };
+
+  private:
+    struct Range {
+        uint64 start;
+        uint64 end;
+        uint32 function;
+    };
+
+    std::vector<Block> blocks;       // sorted by start
+    std::vector<uint32> successors;  // block indexes
+    std::vector<Function> functions; // sorted by entry
+    std::vector<Range> ranges;       // consecutive blocks of the same function, sorted by start
+    std::vector<uint64> jumpTargets; // sorted
+
+  public:
+    void Clear();
+    // threads > 1 -> the functions are explored in parallel (every extra thread opens its own decoder); the graph is the same
+    bool Build(DissasmDecoder& decoder, BufferView code, const std::vector<uint64>& entryPoints, uint32 threads = 1);
+
+    inline bool IsBuilt() const
+    {
+        return !blocks.empty();
+    }
+    inline const std::vector<Block>& GetBlocks() const
+    {
+        return blocks;
+    }
+    inline std::span<const uint32> GetSuccessors(const Block& block) const
+    {
+        return { successors.data() + block.firstSuccessor, block.successorsCount };
+    }
+    inline const std::vector<Function>& GetFunctions() const
+    {
+        return functions;
+    }
+    // starts of the blocks reached by a jump
+    inline const std::vector<uint64>& GetJumpTargets() const
+    {
+        return jumpTargets;
+    }
+
+    // INVALID_INDEX if the offset is not inside a decoded block
+    uint32 FindBlock(uint64 offset) const;
+    uint32 FindFunction(uint64 offset) const;
+};
+} // namespace GView::View::DissasmViewer
@@ -8,241 +8,395 @@
 using namespace GView::View::DissasmViewer;
 using namespace AppCUI::Input;
 
-void DissasmCache::ClearCache(bool forceClear)
-{
-    if (!hasCache && !forceClear)
-        return;
-    zonesData.clear();
-    cacheFile.Close();
-}
+constexpr char DISSASM_CACHE_MAGIC[8]      = { 'G', 'V', 'D', 'A', 'S', 'M', 'C', '\0' };
+constexpr uint64 DISSASM_CACHE_MAX_SIZE    = 0x10000000; // 256 MB
+constexpr uint64 DISSASM_CACHE_ALIGNMENT   = 8;
+constexpr uint32 DISSASM_CACHE_HEADER_SIZE = static_cast<uint32>(sizeof(DissasmCacheHeader));
 
-bool DissasmCache::AddRegion(std::string regionName, const std::byte* data, AppCUI::uint32 size)
+// the records are written straight from memory -> they must not have padding bytes
+static_assert(sizeof(DissasmCacheHeader) == 48 && sizeof(DissasmCacheSection) == 32, "the layout of the cache file must not change");
+static_assert(sizeof(DissasmCacheZone) == 24 && sizeof(DissasmCacheLineIndexEntry) == 16, "the layout of the cache file must not change");
+static_assert(sizeof(DissasmCacheAnnotation) == 24 && sizeof(DissasmCacheLabelName) == 24, "the layout of the cache file must not change");
+static_assert(sizeof(DissasmCacheComment) == 16 && sizeof(DissasmCacheCollapsibleZone) == 40, "the layout of the cache file must not change");
+
+void DissasmCache::ClearCache()
 {
-    if (zonesData.contains(regionName))
-        return false;
-    DissasmCacheEntry entry = { std::make_unique<std::byte[]>(size), size };
-    memcpy(entry.data.get(), data, size);
-    zonesData[std::move(regionName)] = std::move(entry);
-    return true;
+    // the content hash is kept, it belongs to the analysed object and not to the cache file
+    hasCache = false;
+    sections = {};
+    content  = {};
+    cacheFile.reset();
 }
 
-std::filesystem::path DissasmCache::GetCacheFilePath(std::u16string_view fileLocation, bool cacheSameLocationAsAnalyzedFile)
+std::filesystem::path DissasmCache::GetCacheFilePath(
+      std::u16string_view fileLocation, const DissasmCacheContentHash& contentHash, bool cacheSameLocationAsAnalyzedFile)
 {
-    constexpr char16 currentLoc  = '.';
-    const auto cacheDataLocation = cacheSameLocationAsAnalyzedFile ? fileLocation : std::u16string_view(&currentLoc, 1);
-
-    std::filesystem::path path = cacheDataLocation;
+    std::filesystem::path path;
+    if (cacheSameLocationAsAnalyzedFile) {
+        path = fileLocation;
+    } else {
+        // the current folder keeps the caches of different objects -> the name is the hash of the analysed content
+        LocalString<64> name;
+        for (const auto value : contentHash)
+            name.AddFormat("%02x", value);
+        path = name.GetText();
+    }
     path += ".dissasm.cache";
     return path;
 }
-    
-bool DissasmCache::SaveCacheFile(std::u16string_view location)
+
+bool DissasmCache::LoadCacheFile(const std::filesystem::path& path)
 {
-    if (zonesData.empty())
-        return false;
-    const std::filesystem::path filePath(location.begin(), location.end());
-    bool created = cacheFile.Create(filePath, true);
-    if (!created)
-        return false;
-    const uint32 zonesCount = (uint32) zonesData.size();
-    uint32 entrySize;
-    cacheFile.Write((const char*) &zonesCount, sizeof(zonesCount));
-    for (auto& [name, entry] : zonesData) {
-        entrySize = (uint32) name.size();
-        cacheFile.Write((const char*) &entrySize, sizeof(entrySize));
-        cacheFile.Write(name.data(), entrySize);
-
-        entrySize = entry.size;
-        cacheFile.Write((const char*) &entrySize, sizeof(entrySize));
-        cacheFile.Write(reinterpret_cast<const char*>(entry.data.get()), entry.size);
+    ClearCache();
+    CHECK(kHostIsLittleEndian, false, "The cache file is only supported on little endian hosts!");
+    CHECK(hasContentHash, false, "");
+
+    auto file = std::make_unique<AppCUI::OS::File>();
+    if (!file->OpenRead(path))
+        return false; // no cache for this object yet
+    const uint64 fileSize = file->GetSize();
+    CHECK(fileSize >= DISSASM_CACHE_HEADER_SIZE && fileSize <= DISSASM_CACHE_MAX_SIZE, false, "Invalid cache file size!");
+
+    // the whole file fits in the cache -> GetEntireFile returns one contiguous view (straight into the mapping if the file can be mapped)
+    cacheFile = std::make_unique<GView::Utils::DataCache>();
+    CHECK(cacheFile->Init(std::move(file), static_cast<uint32>(fileSize)), false, "Fail to read the cache file!");
+    cacheFile->MapFile(path);
+    content = cacheFile->GetEntireFile();
+    CHECK(content.IsValid() && content.GetLength() == fileSize, false, "Fail to read the cache file!");
+
+    const auto header = reinterpret_cast<const DissasmCacheHeader*>(content.GetData());
+    CHECK(memcmp(header->magic, DISSASM_CACHE_MAGIC, sizeof(DISSASM_CACHE_MAGIC)) == 0, false, "Invalid cache file!");
+    CHECK(header->version == DISSASM_CACHE_VERSION, false, "Unsupported cache file version: %u", header->version);
+    CHECK(header->fileSize == fileSize, false, "Truncated cache file!");
+    if (header->contentHash != contentHash)
+        return false; // the cache was saved for another content (the object was changed since)
+
+    GView::Hashes::CRC32 crc32{};
+    uint32 checksum                  = 0;
+    DissasmCacheHeader checkedHeader = *header;
+    checkedHeader.checksum           = 0;
+    const BufferView checkedData(content.GetData() + DISSASM_CACHE_HEADER_SIZE, content.GetLength() - DISSASM_CACHE_HEADER_SIZE);
+    CHECK(crc32.Init(GView::Hashes::CRC32Type::JAMCRC), false, "");
+    CHECK(crc32.Update(reinterpret_cast<const unsigned char*>(&checkedHeader), DISSASM_CACHE_HEADER_SIZE), false, "");
+    CHECK(checkedData.Empty() || crc32.Update(checkedData), false, "");
+    CHECK(crc32.Final(checksum) && checksum == header->checksum, false, "Corrupted cache file!");
+
+    const uint64 dataStart = DISSASM_CACHE_HEADER_SIZE + static_cast<uint64>(header->sectionsCount) * sizeof(DissasmCacheSection);
+    CHECK(dataStart <= fileSize, false, "Invalid sections table!");
+    sections = { reinterpret_cast<const DissasmCacheSection*>(content.GetData() + DISSASM_CACHE_HEADER_SIZE), header->sectionsCount };
+    for (const auto& section : sections) {
+        CHECK(section.recordSize > 0 && section.offset >= dataStart && section.offset <= fileSize && section.offset % DISSASM_CACHE_ALIGNMENT == 0,
+              false,
+              "Invalid section in the cache file!");
+        const uint64 sectionSize = static_cast<uint64>(section.recordSize) * section.recordsCount + section.stringsSize;
+        CHECK(sectionSize <= fileSize - section.offset, false, "Invalid section in the cache file!");
     }
-    cacheFile.Close();
+
+    hasCache = true;
     return true;
 }
 
-bool DissasmCache::LoadCacheFile(std::u16string_view location)
+const DissasmCacheSection* DissasmCache::FindSection(DissasmCacheSectionType type, uint64 zone) const
 {
-    const std::filesystem::path filePath(location.begin(), location.end());
-    const bool opened = cacheFile.OpenRead(filePath);
-    if (!opened)
-        return false;
-    const auto fileSize = cacheFile.GetSize();
-    if (fileSize == (uint64)-1)
-        return false;
-    if (fileSize == 0)
-        return true;
-    std::vector<uint8> buffer;
-    buffer.resize((uint32) fileSize);
-    cacheFile.Read(reinterpret_cast<char*>(buffer.data()), (uint32)fileSize);
-    cacheFile.Close();
-
-    if (fileSize < sizeof(uint32))
-        return false;
+    if (!hasCache)
+        return nullptr;
+    // a few sections for every code zone -> a linear search is enough
+    for (const auto& section : sections) {
+        if (section.type == type && section.zone == zone)
+            return &section;
+    }
+    return nullptr;
+}
 
-    uint32 offset     = 0;
-    uint32 zonesCount = 0;
-    memcpy(&zonesCount, buffer.data() + offset, sizeof(zonesCount));
-    offset += sizeof(zonesCount);
-
-    while (offset < buffer.size()) {
-        if (zonesCount-- == 0)
-            return false;
-        uint32 entrySize;
-        memcpy(&entrySize, buffer.data() + offset, sizeof(entrySize));
-        offset += sizeof(entrySize);
-        if (offset + entrySize > buffer.size())
-            return false;
-        const auto entryDataName = buffer.data() + offset;
-        offset += entrySize;
-        if (offset > buffer.size())
-            return false;
-        std::string_view entryName = { (const char*) entryDataName, entrySize };
-
-        if (offset + sizeof(uint32) > buffer.size())
-            return false;
-        memcpy(&entrySize, buffer.data() + offset, sizeof(entrySize));
-        offset += sizeof(entrySize);
-        if (offset + entrySize > buffer.size())
-            return false;
-        const auto entryData = buffer.data() + offset;
-        offset += entrySize;
-        if (offset > buffer.size())
-            return false;
-
-        auto newCacheEntry = DissasmCacheEntry{ std::make_unique<std::byte[]>(entrySize), entrySize };
-        memcpy(newCacheEntry.data.get(), entryData, entrySize);
-        zonesData.emplace(entryName, std::move(newCacheEntry));
+void DissasmCacheWriter::AddSection(
+      DissasmCacheSectionType type, uint64 zone, uint32 recordSize, uint32 recordsCount, const void* records, std::string_view strings)
+{
+    sections.push_back({ type, recordSize, zone, data.size(), recordsCount, static_cast<uint32>(strings.size()) });
+
+    const auto recordsData = reinterpret_cast<const std::byte*>(records);
+    const auto stringsData = reinterpret_cast<const std::byte*>(strings.data());
+    data.insert(data.end(), recordsData, recordsData + static_cast<size_t>(recordSize) * recordsCount);
+    data.insert(data.end(), stringsData, stringsData + strings.size());
+    data.resize((data.size() + DISSASM_CACHE_ALIGNMENT - 1) & ~(DISSASM_CACHE_ALIGNMENT - 1));
+}
+
+void DissasmCacheWriter::CopySections(const DissasmCache& cache, uint64 zone)
+{
+    if (!cache.hasCache)
+        return;
+    for (const auto& section : cache.sections) {
+        if (section.zone != zone)
+            continue;
+        const auto records = cache.content.GetData() + section.offset;
+        const auto strings = reinterpret_cast<const char*>(records) + static_cast<size_t>(section.recordSize) * section.recordsCount;
+        AddSection(section.type, zone, section.recordSize, section.recordsCount, records, { strings, section.stringsSize });
     }
-    return true;
 }
 
-bool DisassemblyZone::ToBuffer(std::vector<std::byte>& buffer, Reference<GView::Object> obj) const
+bool DissasmCacheWriter::Save(const std::filesystem::path& path, const DissasmCacheContentHash& contentHash) const
 {
-    Hashes::OpenSSLHash hash(Hashes::OpenSSLHashKind::Md5);
-    const auto zoneData = obj->GetData().Get(startingZonePoint, (uint32) size, false);
-    if (zoneData.Empty())
-        return false;
-    if (!hash.Update(zoneData.GetData(), (uint32) zoneData.GetLength()))
-        return false;
-    const auto hashValue = hash.GetHexValue();
-    buffer.reserve(hashValue.size() + sizeof(DisassemblyZone));
-    buffer.clear();
-    buffer.insert(buffer.end(), (const std::byte*) hashValue.data(), (const std::byte*) hashValue.data() + hashValue.size());
-    buffer.insert(buffer.end(), reinterpret_cast<const std::byte*>(this), reinterpret_cast<const std::byte*>(this) + sizeof(DisassemblyZone));
+    CHECK(kHostIsLittleEndian, false, "The cache file is only supported on little endian hosts!");
+
+    const uint64 dataStart = DISSASM_CACHE_HEADER_SIZE + sections.size() * sizeof(DissasmCacheSection);
+    const uint64 fileSize  = dataStart + data.size();
+    CHECK(fileSize <= DISSASM_CACHE_MAX_SIZE, false, "The cache file is too big!");
+
+    std::vector<DissasmCacheSection> sectionsTable = sections;
+    for (auto& section : sectionsTable)
+        section.offset += dataStart;
+
+    DissasmCacheHeader header{};
+    memcpy(header.magic, DISSASM_CACHE_MAGIC, sizeof(DISSASM_CACHE_MAGIC));
+    header.version       = DISSASM_CACHE_VERSION;
+    header.sectionsCount = static_cast<uint32>(sectionsTable.size());
+    header.contentHash   = contentHash;
+    header.fileSize      = fileSize;
+
+    GView::Hashes::CRC32 crc32{};
+    const auto tableSize = static_cast<uint32>(sectionsTable.size() * sizeof(DissasmCacheSection));
+    CHECK(crc32.Init(GView::Hashes::CRC32Type::JAMCRC), false, "");
+    CHECK(crc32.Update(reinterpret_cast<const unsigned char*>(&header), DISSASM_CACHE_HEADER_SIZE), false, ""); // with checksum = 0
+    if (tableSize > 0)
+        CHECK(crc32.Update(reinterpret_cast<const unsigned char*>(sectionsTable.data()), tableSize), false, "");
+    if (!data.empty())
+        CHECK(crc32.Update(reinterpret_cast<const unsigned char*>(data.data()), static_cast<uint32>(data.size())), false, "");
+    CHECK(crc32.Final(header.checksum), false, "");
+
+    // the previous cache file may still be mapped (or read) -> the new one is written aside and replaces it at the end
+    std::filesystem::path tempPath = path;
+    tempPath += ".tmp";
+    AppCUI::OS::File file;
+    CHECK(file.Create(tempPath, true), false, "Fail to create the cache file!");
+    bool written = file.Write(&header, DISSASM_CACHE_HEADER_SIZE);
+    written      = written && (tableSize == 0 || file.Write(sectionsTable.data(), tableSize));
+    written      = written && (data.empty() || file.Write(data.data(), static_cast<uint32>(data.size())));
+    file.Close();
+
+    std::error_code error;
+    if (!written) {
+        std::filesystem::remove(tempPath, error);
+        RETURNERROR(false, "Fail to write the cache file!");
+    }
+    std::filesystem::rename(tempPath, path, error);
+    if (error) {
+        std::filesystem::remove(tempPath, error);
+        RETURNERROR(false, "Fail to replace the cache file!");
+    }
     return true;
 }
 
 void Instance::LoadCacheData()
 {
-    if (!config.EnableDeepScanDissasmOnStart)
+    // the content hash reads all the disassembly zones -> it is computed when the first code zone is initialized (and only once)
+    if (cacheData.isLoaded)
         return;
-    const std::filesystem::path path = DissasmCache::GetCacheFilePath(obj->GetPath(), config.CacheSameLocationAsAnalyzedFile);
-    if (!cacheData.LoadCacheFile(path.u16string())) {
-        cacheData.ClearCache(true);
+    cacheData.isLoaded = true;
+    if (!config.EnableDeepScanDissasmOnStart && !config.EnableControlFlowAnalysis)
         return;
-    }
-    if (!settings->ValidateCacheData(cacheData, obj)) {
-        cacheData.ClearCache(true);
+    cacheData.hasContentHash = settings->ComputeContentHash(obj, cacheData.contentHash);
+    if (!cacheData.hasContentHash)
         return;
-    }
-    cacheData.hasCache = true;
+    const auto path = DissasmCache::GetCacheFilePath(obj->GetPath(), cacheData.contentHash, config.CacheSameLocationAsAnalyzedFile);
+    if (!cacheData.LoadCacheFile(path))
+        cacheData.ClearCache();
 }
 
 void Instance::SaveCacheData()
 {
-    if (!config.EnableDeepScanDissasmOnStart)
-        return;
-    cacheData.ClearCache(); // TODO: optimise this better? maybe clear cache after loading
-    if (!settings->SaveToCache(cacheData, obj))
-        return;
+    if (!cacheData.hasContentHash)
+        return; // the cache is disabled or the content of the object could not be read
 
-    std::vector<std::byte> buffer;
-    LocalString<64> zoneName;
+    DissasmCacheWriter writer;
     for (auto& zone : settings->parseZones) {
         if (zone->zoneType != DissasmParseZoneType::DissasmCodeParseZone)
             continue;
         const auto* dissasmZone = (DissasmCodeZone*) zone.get();
-        if (!dissasmZone->ToBuffer(buffer))
-            return;
-        zoneName.SetFormat("DissasmParseZoneType.%llu", zone->startLineIndex);
-        if (!cacheData.AddRegion(zoneName.GetText(), buffer.data(), (uint32) buffer.size()))
+        if (!dissasmZone->isInit || dissasmZone->parallelDisassembly) {
+            // not analysed yet (or the listing is not complete) -> the previous analysis is kept
+            writer.CopySections(cacheData, dissasmZone->zoneDetails.startingZonePoint);
+            continue;
+        }
+        if (!dissasmZone->SaveToCache(writer))
             return;
     }
 
-    const std::filesystem::path path = DissasmCache::GetCacheFilePath(obj->GetPath(), config.CacheSameLocationAsAnalyzedFile);
-    cacheData.SaveCacheFile(path.u16string());
+    // the sections were copied -> the old file is released, so it can be replaced
+    cacheData.ClearCache();
+    const auto path = DissasmCache::GetCacheFilePath(obj->GetPath(), cacheData.contentHash, config.CacheSameLocationAsAnalyzedFile);
+    if (!writer.Save(path, cacheData.contentHash))
+        return;
+    if (!cacheData.LoadCacheFile(path))
+        cacheData.ClearCache();
 }
 
-bool SettingsData::SaveToCache(DissasmCache& cache, Reference<GView::Object> obj)
+bool SettingsData::ComputeContentHash(Reference<GView::Object> obj, DissasmCacheContentHash& contentHash) const
 {
-    std::vector<std::byte> buffer;
-    LocalString<64> zoneName;
-    for (auto& [start, zone] : disassemblyZones) {
-        if (!zone.ToBuffer(buffer, obj))
-            return false;
-        zoneName.SetFormat("DisassemblyZone.%llu", start);
-        if (!cache.AddRegion(zoneName.GetText(), buffer.data(), (uint32) buffer.size()))
-            return false;
+    Hashes::OpenSSLHash hash(Hashes::OpenSSLHashKind::Md5);
+    auto& data             = obj->GetData();
+    const uint32 blockSize = data.GetCacheSize();
+    for (const auto& [start, zone] : disassemblyZones) {
+        const uint64 descriptor[] = { zone.startingZonePoint, zone.size, zone.entryPoint, static_cast<uint64>(zone.language) };
+        CHECK(hash.Update(descriptor, sizeof(descriptor)), false, "");
+
+        // big zones are hashed in blocks of the size of the cache
+        const uint64 zoneEnd = zone.startingZonePoint + zone.size;
+        for (uint64 offset = zone.startingZonePoint; offset < zoneEnd;) {
+            const auto buffer = data.Get(offset, static_cast<uint32>(std::min<uint64>(blockSize, zoneEnd - offset)), false);
+            if (buffer.Empty())
+                break; // the zone goes past the end of the object
+            CHECK(hash.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
+            offset += buffer.GetLength();
+        }
     }
+    CHECK(hash.Final(), false, "");
+    CHECK(hash.GetSize() == contentHash.size(), false, "");
+    memcpy(contentHash.data(), hash.Get(), contentHash.size());
     return true;
 }
 
-bool SettingsData::ValidateCacheData(DissasmCache& cache, Reference<GView::Object> obj)
+bool DissasmCodeZone::SaveToCache(DissasmCacheWriter& writer) const
 {
-    std::vector<std::byte> buffer;
-    LocalString<64> zoneName;
-    for (auto& [start, zone] : disassemblyZones) {
-        zoneName.SetFormat("DisassemblyZone.%llu", start);
-        if (!cache.zonesData.contains(zoneName.GetText()))
-            return false;
-        const auto& entry = cache.zonesData[zoneName.GetText()];
-        if (!zone.ToBuffer(buffer, obj))
-            return false;
-        if (entry.size != buffer.size())
-            return false;
-        if (memcmp(entry.data.get(), buffer.data(), buffer.size()) != 0)
-            return false;
+    const uint64 zone              = zoneDetails.startingZonePoint;
+    const DissasmCacheZone details = { zoneDetails.size, zoneDetails.entryPoint, static_cast<uint32>(zoneDetails.language), extendedSize };
+    writer.AddSection(DissasmCacheSectionType::Zone, zone, std::span<const DissasmCacheZone>(&details, 1));
+    std::vector<DissasmCacheLineIndexEntry> lineIndex;
+    lineIndex.reserve(cachedCodeOffsets.size());
+    for (const auto& entry : cachedCodeOffsets)
+        lineIndex.push_back({ entry.offset, entry.line, 0 });
+    writer.AddSection(DissasmCacheSectionType::LineIndex, zone, std::span<const DissasmCacheLineIndexEntry>(lineIndex));
+
+    // the collapsible zones in pre-order, every one with its own annotations, label names and comments
+    std::vector<DissasmCacheCollapsibleZone> zones;
+    std::vector<DissasmCacheAnnotation> annotations;
+    std::vector<DissasmCacheLabelName> labelNames;
+    std::vector<DissasmCacheComment> comments;
+    DissasmCacheStrings zonesStrings, annotationsStrings, labelNamesStrings, commentsStrings;
+
+    std::vector<std::pair<const DissasmCodeInternalType*, uint32>> toVisit = { { &dissasmType, DISSASM_CACHE_NO_PARENT } };
+    while (!toVisit.empty()) {
+        const auto [type, parent] = toVisit.back();
+        toVisit.pop_back();
+        const auto index = static_cast<uint32>(zones.size());
+        zones.push_back({ zonesStrings.Add(type->name),
+                          parent,
+                          type->indexZoneStart,
+                          type->indexZoneEnd,
+                          type->workingIndexZoneStart,
+                          type->workingIndexZoneEnd,
+                          type->beforeTextLines,
+                          type->beforeAsmLines,
+                          type->isCollapsed ? 1u : 0u });
+
+        for (const auto& [line, annotation] : type->annotations.mappings)
+            annotations.push_back({ annotation.second, annotationsStrings.Add(annotation.first), index, line });
+        for (const auto& [initialName, currentName] : type->annotations.initial_name_to_current_name)
+            labelNames.push_back({ labelNamesStrings.Add(initialName), labelNamesStrings.Add(currentName), index, 0 });
+        for (const auto& [line, comment] : type->commentsData.comments)
+            comments.push_back({ commentsStrings.Add(comment), index, line });
+
+        // reversed -> the first internal zone is visited first
+        for (auto it = type->internalTypes.rbegin(); it != type->internalTypes.rend(); ++it)
+            toVisit.emplace_back(&*it, index);
     }
-    return true;
-}
 
-bool DissasmCodeZone::ToBuffer(std::vector<std::byte>& buffer) const
-{
-    uint32 reserveSize = dissasmType.commentsData.GetRequiredSizeForSerialization();
-    reserveSize += dissasmType.annotations.GetRequiredSizeForSerialization();
-    buffer.reserve(reserveSize);
-
-    // comments
-    dissasmType.commentsData.ToBuffer(buffer);
-    // annotations
-    dissasmType.annotations.ToBuffer(buffer);
+    writer.AddSection(DissasmCacheSectionType::CollapsibleZones, zone, std::span<const DissasmCacheCollapsibleZone>(zones), zonesStrings.data);
+    writer.AddSection(DissasmCacheSectionType::Annotations, zone, std::span<const DissasmCacheAnnotation>(annotations), annotationsStrings.data);
+    writer.AddSection(DissasmCacheSectionType::LabelNames, zone, std::span<const DissasmCacheLabelName>(labelNames), labelNamesStrings.data);
+    writer.AddSection(DissasmCacheSectionType::Comments, zone, std::span<const DissasmCacheComment>(comments), commentsStrings.data);
     return true;
 }
 
-bool DissasmCodeZone::TryLoadDataFromCache(DissasmCache& cache)
+bool DissasmCodeZone::LoadFromCache(const DissasmCache& cache, uint32& totalLines)
 {
     if (!cache.hasCache)
-        return true;
-    if (zoneType != DissasmParseZoneType::DissasmCodeParseZone)
         return false;
-    LocalString<64> zoneName;
-    zoneName.SetFormat("DissasmParseZoneType.%llu", startLineIndex);
-
-    auto it = cache.zonesData.find(zoneName.GetText());
-    if (it == cache.zonesData.end())
+    const uint64 zone    = zoneDetails.startingZonePoint;
+    const auto details   = cache.GetSection<DissasmCacheZone>(DissasmCacheSectionType::Zone, zone).records;
+    const auto lineIndex = cache.GetSection<DissasmCacheLineIndexEntry>(DissasmCacheSectionType::LineIndex, zone).records;
+    const auto zones     = cache.GetSection<DissasmCacheCollapsibleZone>(DissasmCacheSectionType::CollapsibleZones, zone);
+    if (details.size() != 1 || lineIndex.empty() || zones.records.empty())
+        return false; // the zone was not analysed when the cache was saved
+    if (details[0].size != zoneDetails.size || details[0].entryPoint != zoneDetails.entryPoint ||
+        details[0].language != static_cast<uint32>(zoneDetails.language) || details[0].extendedSize == 0)
         return false;
-    const std::byte* dataPtr    = it->second.data.get();
-    const std::byte* dataPtrEnd = dataPtr + it->second.size;
+    // the listing may start before the entry point (the functions that are placed before it)
+    CHECK(zoneDetails.startingZonePoint <= lineIndex[0].offset && lineIndex[0].offset <= zoneDetails.entryPoint && lineIndex[0].line == 0,
+          false,
+          "Invalid line index in the cache!");
+    CHECK(zones.records[0].parent == DISSASM_CACHE_NO_PARENT, false, "Invalid collapsible zones in the cache!");
 
-    if (dataPtr + sizeof(uint32) > dataPtrEnd)
-        return false;
+    // the tree is built aside -> a cache that is not valid does not leave a partially loaded zone behind
+    DissasmCodeInternalType root{};
+    std::vector<DissasmCodeInternalType*> path; // from the root to the last added zone (pre-order -> the parent of a zone is on it)
+    std::vector<uint32> pathIndexes;
+    std::string_view text;
+    for (uint32 index = 0; index < zones.records.size(); index++) {
+        const auto& record            = zones.records[index];
+        DissasmCodeInternalType* type = &root;
+        if (index > 0) {
+            while (!pathIndexes.empty() && pathIndexes.back() != record.parent) {
+                path.pop_back();
+                pathIndexes.pop_back();
+            }
+            CHECK(!path.empty(), false, "Invalid collapsible zones in the cache!");
+            type = &path.back()->internalTypes.emplace_back();
+        }
+        CHECK(zones.GetString(record.name, text), false, "Invalid collapsible zones in the cache!");
+        type->name                  = text;
+        type->indexZoneStart        = record.indexZoneStart;
+        type->indexZoneEnd          = record.indexZoneEnd;
+        type->workingIndexZoneStart = record.workingIndexZoneStart;
+        type->workingIndexZoneEnd   = record.workingIndexZoneEnd;
+        type->beforeTextLines       = record.beforeTextLines;
+        type->beforeAsmLines        = record.beforeAsmLines;
+        type->textLinesPassed       = 0;
+        type->asmLinesPassed        = 0;
+        type->isCollapsed           = record.isCollapsed != 0;
+        path.push_back(type);
+        pathIndexes.push_back(index);
+    }
 
-        // comments
-    if (!dissasmType.commentsData.LoadFromBuffer(dataPtr, dataPtrEnd))
-        return false;
-    // annotations
-    if (!dissasmType.annotations.LoadFromBuffer(dataPtr, dataPtrEnd))
-        return false;
+    // the vectors of internal zones do not change anymore -> the addresses of the zones are stable
+    std::vector<DissasmCodeInternalType*> types;
+    types.reserve(zones.records.size());
+    std::vector<DissasmCodeInternalType*> toVisit = { &root };
+    while (!toVisit.empty()) {
+        const auto type = toVisit.back();
+        toVisit.pop_back();
+        types.push_back(type);
+        for (auto it = type->internalTypes.rbegin(); it != type->internalTypes.rend(); ++it)
+            toVisit.push_back(&*it);
+    }
+
+    const auto annotations = cache.GetSection<DissasmCacheAnnotation>(DissasmCacheSectionType::Annotations, zone);
+    for (const auto& record : annotations.records) {
+        CHECK(record.collapsibleZone < types.size() && annotations.GetString(record.name, text), false, "Invalid annotation in the cache!");
+        types[record.collapsibleZone]->annotations.insert({ record.line, { std::string(text), record.value } });
+    }
+
+    const auto labelNames = cache.GetSection<DissasmCacheLabelName>(DissasmCacheSectionType::LabelNames, zone);
+    std::string_view currentName;
+    for (const auto& record : labelNames.records) {
+        CHECK(record.collapsibleZone < types.size() && labelNames.GetString(record.initialName, text) &&
+                    labelNames.GetString(record.currentName, currentName),
+              false,
+              "Invalid label name in the cache!");
+        auto& container = types[record.collapsibleZone]->annotations;
+        container.initial_name_to_current_name.emplace(text, currentName);
+        container.current_name_to_initial_name.emplace(currentName, text);
+    }
+
+    const auto comments = cache.GetSection<DissasmCacheComment>(DissasmCacheSectionType::Comments, zone);
+    for (const auto& record : comments.records) {
+        CHECK(record.collapsibleZone < types.size() && comments.GetString(record.text, text), false, "Invalid comment in the cache!");
+        types[record.collapsibleZone]->commentsData.comments[record.line] = text;
+    }
 
+    cachedCodeOffsets.clear();
+    cachedCodeOffsets.reserve(lineIndex.size());
+    for (const auto& entry : lineIndex)
+        cachedCodeOffsets.push_back({ entry.offset, entry.line });
+    dissasmType = std::move(root);
+    totalLines  = details[0].extendedSize - 1; // without the title
     return true;
-}
\ No newline at end of file
+}
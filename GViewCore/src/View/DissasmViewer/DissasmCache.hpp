@@ -1,29 +1,177 @@
 #pragma once
-#include <unordered_map>
 
-#include <AppCUI/include/AppCUI.hpp>
+#include "Internal.hpp"
+
+#include <array>
+#include <filesystem>
+#include <span>
 
 namespace GView::View::DissasmViewer
 {
-struct DissasmCacheEntry
-{
-    std::unique_ptr<std::byte[]> data;
-    AppCUI::uint32 size;
+// The analysis of an object saved on disk (little endian), keyed by the hash of its disassembly zones:
+//     DissasmCacheHeader | DissasmCacheSection[sectionsCount] | the data of the sections
+// The data of a section is an array of fixed size records followed by the strings the records point to. Every section
+// starts 8 bytes aligned, so the records are used straight from the mapping of the file. The checksum from the header
+// covers the whole file (computed with the checksum field set to 0).
+constexpr uint32 DISSASM_CACHE_VERSION = 1;
+
+enum class DissasmCacheSectionType : uint32 {
+    Zone = 1,         // DissasmCacheZone
+    LineIndex,        // DissasmCacheLineIndexEntry -> the offset table of the listing
+    Annotations,      // DissasmCacheAnnotation
+    LabelNames,       // DissasmCacheLabelName
+    Comments,         // DissasmCacheComment
+    CollapsibleZones, // DissasmCacheCollapsibleZone (pre-order, the first one is the code zone itself)
+};
+
+using DissasmCacheContentHash = std::array<uint8, 16>; // MD5
+
+struct DissasmCacheHeader {
+    char magic[8];
+    uint32 version;
+    uint32 sectionsCount;
+    DissasmCacheContentHash contentHash;
+    uint64 fileSize;
+    uint32 checksum; // CRC32 (JAMCRC) of the file, with this field set to 0
+    uint32 reserved;
+};
+
+struct DissasmCacheSection {
+    DissasmCacheSectionType type;
+    uint32 recordSize;
+    uint64 zone;   // starting offset of the code zone
+    uint64 offset; // from the start of the file
+    uint32 recordsCount;
+    uint32 stringsSize;
+};
+
+struct DissasmCacheString {
+    uint32 offset; // in the strings of the section
+    uint32 size;
+};
+
+struct DissasmCacheZone {
+    uint64 size;
+    uint64 entryPoint;
+    uint32 language;
+    uint32 extendedSize; // lines of the zone, with the title
+};
+
+// AsmOffsetLine has 4 bytes of padding -> the line index is saved with explicit (zeroed) reserved bytes
+struct DissasmCacheLineIndexEntry {
+    uint64 offset;
+    uint32 line;
+    uint32 reserved;
+};
+
+// collapsibleZone -> index of the record in the CollapsibleZones section of the same code zone
+struct DissasmCacheAnnotation {
+    uint64 value;
+    DissasmCacheString name;
+    uint32 collapsibleZone;
+    uint32 line;
+};
+
+// initial name -> current name of a label (the annotations keep the current names)
+struct DissasmCacheLabelName {
+    DissasmCacheString initialName;
+    DissasmCacheString currentName;
+    uint32 collapsibleZone;
+    uint32 reserved;
+};
+
+struct DissasmCacheComment {
+    DissasmCacheString text;
+    uint32 collapsibleZone;
+    uint32 line;
+};
+
+struct DissasmCacheCollapsibleZone {
+    DissasmCacheString name;
+    uint32 parent; // index of the parent zone (DISSASM_CACHE_NO_PARENT for the code zone)
+    uint32 indexZoneStart;
+    uint32 indexZoneEnd;
+    uint32 workingIndexZoneStart;
+    uint32 workingIndexZoneEnd;
+    uint32 beforeTextLines;
+    uint32 beforeAsmLines;
+    uint32 isCollapsed;
+};
+constexpr uint32 DISSASM_CACHE_NO_PARENT = 0xFFFFFFFF;
+
+// the records of a section and their strings, straight from the cache file
+template <typename T>
+struct DissasmCacheSectionView {
+    std::span<const T> records;
+    std::string_view strings;
+
+    bool GetString(DissasmCacheString value, std::string_view& result) const
+    {
+        if (value.offset > strings.size() || value.size > strings.size() - value.offset)
+            return false;
+        result = strings.substr(value.offset, value.size);
+        return true;
+    }
 };
 
 struct DissasmCache {
+    bool isLoaded; // the cache file is looked up once, when the first code zone is initialized
     bool hasCache;
-    AppCUI::OS::File cacheFile;
-    std::unordered_map<std::string, DissasmCacheEntry> zonesData;
+    bool hasContentHash;
+    DissasmCacheContentHash contentHash; // of the disassembly zones of the analysed object
+    std::unique_ptr<GView::Utils::DataCache> cacheFile;
+    BufferView content;
+    std::span<const DissasmCacheSection> sections;
 
-    void ClearCache(bool forceClear = false);
+    void ClearCache();
 
-    static std::filesystem::path GetCacheFilePath(std::u16string_view fileLocation, bool cacheSameLocationAsAnalyzedFile);
-    bool AddRegion(std::string regionName, const std::byte* data, AppCUI::uint32 size);
+    static std::filesystem::path GetCacheFilePath(
+          std::u16string_view fileLocation, const DissasmCacheContentHash& contentHash, bool cacheSameLocationAsAnalyzedFile);
+    // maps the cache file (or reads it at once if it can not be mapped) and validates it against contentHash
+    bool LoadCacheFile(const std::filesystem::path& path);
 
-    bool SaveCacheFile(std::u16string_view location);
-    bool LoadCacheFile(std::u16string_view location);
+    const DissasmCacheSection* FindSection(DissasmCacheSectionType type, uint64 zone) const;
+    template <typename T>
+    DissasmCacheSectionView<T> GetSection(DissasmCacheSectionType type, uint64 zone) const
+    {
+        const auto section = FindSection(type, zone);
+        if (!section || section->recordSize != sizeof(T))
+            return {};
+        const auto records = reinterpret_cast<const T*>(content.GetData() + section->offset);
+        const auto strings = reinterpret_cast<const char*>(records + section->recordsCount);
+        return { { records, section->recordsCount }, { strings, section->stringsSize } };
+    }
 };
 
+// the strings of a section that is written
+struct DissasmCacheStrings {
+    std::string data;
+
+    DissasmCacheString Add(std::string_view value)
+    {
+        const DissasmCacheString result = { static_cast<uint32>(data.size()), static_cast<uint32>(value.size()) };
+        data.append(value);
+        return result;
+    }
+};
 
-} // namespace GView::View::DissasmViewer
\ No newline at end of file
+// builds a cache file in memory
+class DissasmCacheWriter
+{
+    std::vector<DissasmCacheSection> sections;
+    std::vector<std::byte> data; // the data of the sections (the offsets are updated on Save)
+
+    void AddSection(DissasmCacheSectionType type, uint64 zone, uint32 recordSize, uint32 recordsCount, const void* records, std::string_view strings);
+
+  public:
+    template <typename T>
+    void AddSection(DissasmCacheSectionType type, uint64 zone, std::span<const T> records, std::string_view strings = {})
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "the records are used straight from the cache file");
+        AddSection(type, zone, sizeof(T), static_cast<uint32>(records.size()), records.data(), strings);
+    }
+    // the sections of a zone that was not initialized yet are kept from the previous cache file
+    void CopySections(const DissasmCache& cache, uint64 zone);
+    bool Save(const std::filesystem::path& path, const DissasmCacheContentHash& contentHash) const;
+};
+} // namespace GView::View::DissasmViewer
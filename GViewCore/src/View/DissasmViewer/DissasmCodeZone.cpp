@@ -3,28 +3,85 @@
 
 using namespace GView::View::DissasmViewer;
 
-constexpr size_t DISSASM_INSTRUCTION_OFFSET_MARGIN = 500;
+// adds the entry point to the labels found in the zone, sorts them and keeps a single label for every offset
+inline void PrepareLabels(std::vector<std::pair<uint64, std::string>>& callsFound, const DissasmCodeZone* zone)
+{
+    enum labelType { SUB, OFFSET, OTHER };
+    auto getLabelType = [](const std::string& s) -> labelType {
+        assert(!s.empty());
+        if (s.size() < 4)
+            return OTHER;
+        if (memcmp(s.c_str(), "sub_", 4) == 0)
+            return SUB;
+        if (s.size() < 7)
+            return OTHER;
+        if (memcmp(s.c_str(), "offset_", 7) == 0)
+            return OFFSET;
+        return OTHER;
+    };
 
-const uint8 HEX_MAPPER[] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  0,  0,  0,  0,  0, 0, 0,
-                             0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 0, 0, 0, 0,  0,  0,  0,  0,  0, 0, 0,
-                             0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 10, 11, 12, 13, 14, 15 };
+    std::vector<uint32> indexesToErase;
+    for (int32 i = static_cast<int32>(callsFound.size()) - 1; i >= 0; i--) {
+        const auto& call = callsFound[i];
+        if (call.first == zone->zoneDetails.entryPoint) {
+            indexesToErase.push_back(i);
+            break;
+        }
+    }
+    for (const auto indexToErase : indexesToErase)
+        callsFound.erase(callsFound.begin() + indexToErase);
+
+    callsFound.emplace_back(zone->zoneDetails.entryPoint, "EntryPoint");
+    // TODO: this can be extracted for the user to add / delete its own operations
+    std::sort(callsFound.begin(), callsFound.end(), [getLabelType](const auto& a, const auto& b) {
+        if (a.first < b.first)
+            return true;
+        if (a.first > b.first)
+            return false;
+        return getLabelType(a.second) < getLabelType(b.second);
+
+        // return a.second.compare(b.second) > 0; // move sub instructions first
+    });
+
+    // TODO: if there are missing called improve predicate to delele only sub and offset
+    callsFound.erase(
+          std::unique(callsFound.begin(), callsFound.end(), [](const auto& left, const auto& right) { return left.first == right.first; }), callsFound.end());
+}
+
+// inserts the labels found in the zone as annotations above their instructions
+inline void InsertLabelsAsAnnotations(
+      std::vector<std::pair<uint64, std::string>>& callsFound, DissasmCodeZone* zone, Reference<GView::Object> obj, uint32& totalLines)
+{
+    const auto& offsets = zone->cachedCodeOffsets;
+    PrepareLabels(callsFound, zone);
+
+    // callsFound.push_back({ 1030, "call2" });
+    // callsFound.push_back({ 1130, "call 3" });
+    // callsFound.push_back({ 1140, "call 5" });
+    uint32 extraLines = 0;
+    for (const auto& call : callsFound) {
+        const uint64 callValue = call.first;
+        uint32 diffLines       = 0;
+        auto callInsn          = GetCurrentInstructionByOffset(callValue, zone, obj, diffLines);
+        if (callInsn) {
+            auto& annotations = zone->dissasmType.annotations;
+            annotations.insert({ diffLines + extraLines, { call.second, callValue - offsets[0].offset } });
+            annotations.add_initial_name(call.second);
+            extraLines++;
+        }
+    }
+    totalLines += static_cast<uint32>(callsFound.size());
+}
 
 inline bool ExtractCallsToInsertFunctionNames(
       vector<AsmOffsetLine>& offsets,
       DissasmCodeZone* zone,
       Reference<GView::Object> obj,
-      int internalArchitecture,
+      DissasmDecoder& decoder,
       uint32& totalLines,
       uint64 maxLocationMemoryMappingSize)
 {
-    csh handle;
-    const auto resCode = cs_open(CS_ARCH_X86, static_cast<cs_mode>(internalArchitecture), &handle);
-    if (resCode != CS_ERR_OK) {
-        // WriteErrorToScreen(dli, cs_strerror(resCode));
-        return false;
-    }
-
-    cs_insn* insn = cs_malloc(handle);
+    cs_insn* insn = decoder.GetInstruction();
 
     DisassemblyZone& zoneDetails = zone->zoneDetails;
     const auto instructionData   = obj->GetData().Get(zoneDetails.startingZonePoint, static_cast<uint32>(zoneDetails.size), false);
@@ -39,12 +96,12 @@ inline bool ExtractCallsToInsertFunctionNames(
     callsFound.reserve(16);
     bool foundCall     = false;
     uint64 callAddress = 0;
-    while (cs_disasm_iter(handle, &data, &size, &address, insn) && linesToDecode > 0) {
+    while (linesToDecode > 0 && decoder.Decode(data, size, address)) {
         linesToDecode--;
         const bool isJump = insn->mnemonic[0] == 'j';
         if (*(uint32*) insn->mnemonic == callOP || isJump) {
             uint64 value;
-            const bool foundValue = CheckExtractInsnHexValue(insn->op_str, value, maxLocationMemoryMappingSize);
+            const bool foundValue = ExtractInsnOperandValue(insn, value, maxLocationMemoryMappingSize);
             if (foundValue && value < zoneDetails.startingZonePoint + zoneDetails.size) {
                 if (value < offsets[0].offset)
                     value += offsets[0].offset;
@@ -61,7 +118,7 @@ inline bool ExtractCallsToInsertFunctionNames(
         } else {
             const auto mnemonicVal = *(uint32*) insn->mnemonic;
             if (foundCall) {
-                if (mnemonicVal == movOP && strcmp(insn->op_str, "ebp, esp") == 0) {
+                if (mnemonicVal == movOP && IsInsnRegisterOperand(insn, 0, X86_REG_EBP) && IsInsnRegisterOperand(insn, 1, X86_REG_ESP)) {
                     if (callAddress < offsets[0].offset)
                         callAddress += offsets[0].offset;
                     const auto it = callsMap.find(callAddress);
@@ -77,7 +134,7 @@ inline bool ExtractCallsToInsertFunctionNames(
                 foundCall = false;
             } else {
                 if (mnemonicVal == pushOP) {
-                    if (strcmp(insn->op_str, "ebp") == 0) {
+                    if (IsInsnRegisterOperand(insn, 0, X86_REG_EBP)) {
                         callAddress = insn->address;
                         foundCall   = true;
                     }
@@ -86,88 +143,18 @@ inline bool ExtractCallsToInsertFunctionNames(
         }
     }
 
-    if (callsFound.empty()) {
-        cs_free(insn, 1);
-        cs_close(&handle);
+    if (callsFound.empty())
         return false;
-    }
-
-    auto val = callsFound[0].first;
-
-    enum labelType { SUB, OFFSET, OTHER };
-    auto getLabelType = [](const std::string& s) -> labelType {
-        assert(!s.empty());
-        if (s.size() < 4)
-            return OTHER;
-        if (memcmp(s.c_str(), "sub_", 4) == 0)
-            return SUB;
-        if (s.size() < 7)
-            return OTHER;
-        if (memcmp(s.c_str(), "offset_", 7) == 0)
-            return OFFSET;
-        return OTHER;
-    };
-
-    std::vector<uint32> indexesToErase;
-    for (int32 i = static_cast<int32>(callsFound.size()) - 1; i >= 0; i--) {
-        const auto& call = callsFound[i];
-        if (call.first == zone->zoneDetails.entryPoint) {
-            indexesToErase.push_back(i);
-            break;
-        }
-    }
-    for (const auto indexToErase : indexesToErase)
-        callsFound.erase(callsFound.begin() + indexToErase);
-
-    callsFound.emplace_back(zone->zoneDetails.entryPoint, "EntryPoint");
-    // TODO: this can be extracted for the user to add / delete its own operations
-    std::sort(callsFound.begin(), callsFound.end(), [getLabelType](const auto& a, const auto& b) {
-        if (a.first < b.first)
-            return true;
-        if (a.first > b.first)
-            return false;
-        return getLabelType(a.second) < getLabelType(b.second);
-
-        // return a.second.compare(b.second) > 0; // move sub instructions first
-    });
-
-    // TODO: if there are missing called improve predicate to delele only sub and offset
-    callsFound.erase(
-          std::unique(callsFound.begin(), callsFound.end(), [](const auto& left, const auto& right) { return left.first == right.first; }), callsFound.end());
-
-    // callsFound.push_back({ 1030, "call2" });
-    // callsFound.push_back({ 1130, "call 3" });
-    // callsFound.push_back({ 1140, "call 5" });
-    uint32 extraLines = 0;
-    for (const auto& call : callsFound) {
-        const uint64 callValue = call.first;
-        uint32 diffLines       = 0;
-        auto callInsn          = GetCurrentInstructionByOffset(callValue, zone, obj, diffLines);
-        if (callInsn) {
-            auto& annotations = zone->dissasmType.annotations;
-            annotations.insert({ diffLines + extraLines, { call.second, callValue - offsets[0].offset } });
-            annotations.add_initial_name(call.second);
-            cs_free(callInsn, 1);
-            extraLines++;
-        }
-    }
-    totalLines += static_cast<uint32>(callsFound.size());
-    cs_free(insn, 1);
-    cs_close(&handle);
 
+    InsertLabelsAsAnnotations(callsFound, zone, obj, totalLines);
     return true;
 }
 
+// knownStart -> offsets[0] is already the first instruction of the listing (picked by the control flow analysis), so the
+// zone is not scanned for the jumps and calls that go before the entry point
 inline bool populateOffsetsVector(
-      vector<AsmOffsetLine>& offsets, DisassemblyZone& zoneDetails, GView::Object& obj, int internalArchitecture, uint32& totalLines)
+      vector<AsmOffsetLine>& offsets, DisassemblyZone& zoneDetails, GView::Object& obj, DissasmDecoder& decoder, uint32& totalLines, bool knownStart)
 {
-    csh handle;
-    const auto resCode = cs_open(CS_ARCH_X86, static_cast<cs_mode>(internalArchitecture), &handle);
-    if (resCode != CS_ERR_OK) {
-        // WriteErrorToScreen(dli, cs_strerror(resCode));
-        return false;
-    }
-
     const auto instructionData = obj.GetData().Get(zoneDetails.startingZonePoint, static_cast<uint32>(zoneDetails.size), false);
 
     if (offsets.empty()) {
@@ -177,21 +164,17 @@ inline bool populateOffsetsVector(
 
     size_t minimalValue = offsets[0].offset;
 
-    cs_insn* insn     = cs_malloc(handle);
+    cs_insn* insn     = decoder.GetInstruction();
     size_t lastOffset = offsets[0].offset;
 
-    constexpr uint32 addInstructionsStop = 30; // TODO: update this -> for now it stops, later will fold
-
     std::list<uint64> finalOffsets;
 
     size_t size       = zoneDetails.startingZonePoint + zoneDetails.size;
     uint64 address    = zoneDetails.entryPoint - zoneDetails.startingZonePoint;
     uint64 endAddress = zoneDetails.size;
 
-    if (address >= endAddress) {
-        cs_close(&handle);
+    if (address >= endAddress)
         return false;
-    }
 
     auto data = instructionData.GetData() + address;
 
@@ -202,53 +185,22 @@ inline bool populateOffsetsVector(
     // std::vector<uint64> tempStorage;
     // tempStorage.push_back(lastOffset);
 
-    do {
+    while (!knownStart) {
         if (size > lastSize) {
             lastSize = size;
             // tempStorage.reserve(size / DISSASM_INSTRUCTION_OFFSET_MARGIN + 1);
         }
 
         while (address < endAddress) {
-            if (!cs_disasm_iter(handle, &data, &size, &address, insn))
+            if (!decoder.Decode(data, size, address))
                 break;
 
-            if ((insn->mnemonic[0] == 'j' || *(uint32*) insn->mnemonic == callOP)) // && insn->op_str[0] == '0' /* && insn->op_str[1] == 'x'*/)
-            {
-                uint64 computedValue = 0;
-                if (insn->op_str[1] == 'x') {
-                    // uint64 computedValue = 0;
-                    char* ptr = &insn->op_str[2];
-                    // TODO: also check not to overflow access!
-                    while (*ptr && *ptr != ' ' && *ptr != ',') {
-                        if (!(*ptr >= 'a' && *ptr <= 'f' || *ptr >= '0' && *ptr <= '9')) {
-                            computedValue = 0;
-                            break;
-                        }
-                        computedValue = computedValue * 16 + HEX_MAPPER[static_cast<uint8>(*ptr)];
-                        ptr++;
-                    }
-                } else {
-                    char* ptr = &insn->op_str[0];
-                    while (*ptr && *ptr != ' ' && *ptr != ',') {
-                        if (*ptr < '0' || *ptr > '9') {
-                            computedValue = 0;
-                            break;
-                        }
-                        computedValue = computedValue * 10 + (static_cast<uint8>(*ptr) - '0');
-                        ptr++;
-                    }
-                    if (computedValue < zoneDetails.startingZonePoint)
-                        computedValue += zoneDetails.startingZonePoint;
-                    // if (insn->op_str[1] == '\0') {
-                    //     computedValue = zoneDetails.startingZonePoint;
-                    // }
-                }
-
-                if (computedValue < minimalValue && computedValue >= zoneDetails.startingZonePoint) {
+            uint64 computedValue = 0;
+            if ((insn->mnemonic[0] == 'j' || *(uint32*) insn->mnemonic == callOP) && ExtractInsnBranchTarget(insn, computedValue)) {
+                // the instructions are decoded relative to the start of the zone
+                computedValue += zoneDetails.startingZonePoint;
+                if (computedValue < minimalValue && computedValue >= zoneDetails.startingZonePoint)
                     minimalValue = computedValue;
-                    // saved1       = insn->mnemonic;
-                    // saved2       = insn->op_str;
-                }
             }
             const size_t adjustedSize = address + zoneDetails.startingZonePoint;
             if (adjustedSize - lastOffset >= DISSASM_INSTRUCTION_OFFSET_MARGIN) {
@@ -268,7 +220,7 @@ inline bool populateOffsetsVector(
         data           = instructionData.GetData() + address;
         lastOffset     = minimalValue;
         startingOffset = minimalValue;
-    } while (true);
+    }
 
     size       = zoneDetails.size;
     address    = minimalValue - zoneDetails.startingZonePoint;
@@ -279,10 +231,9 @@ inline bool populateOffsetsVector(
     offsets.clear();
     offsets.push_back({ minimalValue, 0 });
 
-    constexpr uint32 alOpStr         = 7102752u; //* (uint32*) " al";
     uint32 continuousAddInstructions = 0;
 
-    while (cs_disasm_iter(handle, &data, &size, &address, insn)) {
+    while (decoder.Decode(data, size, address)) {
         lineIndex++;
         if (address - lastOffset >= DISSASM_INSTRUCTION_OFFSET_MARGIN) {
             lastOffset                = address;
@@ -290,8 +241,9 @@ inline bool populateOffsetsVector(
             offsets.push_back({ adjustedSize, lineIndex });
         }
 
-        if (*(uint32*) insn->mnemonic == addOP && insn->op_str[0] == 'b' && *(uint32*) &insn->op_str[15] == alOpStr) {
-            if (++continuousAddInstructions == addInstructionsStop) {
+        // zero padding (00 00 -> add byte ptr [eax], al)
+        if (insn->size == 2 && insn->bytes[0] == 0 && insn->bytes[1] == 0) {
+            if (++continuousAddInstructions == DISSASM_ZERO_PADDING_STOP) {
                 lineIndex -= continuousAddInstructions;
                 break;
             }
@@ -300,8 +252,88 @@ inline bool populateOffsetsVector(
     }
 
     totalLines = lineIndex;
-    cs_free(insn, 1);
-    cs_close(&handle);
+    return true;
+}
+
+inline void BuildControlFlowGraph(DissasmCodeZone* zone, DissasmCodeZoneInitData& initData)
+{
+    const DisassemblyZone& zoneDetails = zone->zoneDetails;
+    const uint64 zoneEnd               = zoneDetails.startingZonePoint + zoneDetails.size;
+    const auto instructionData         = initData.obj->GetData().Get(zoneDetails.startingZonePoint, static_cast<uint32>(zoneDetails.size), false);
+    if (!instructionData.IsValid() || zoneDetails.entryPoint < zoneDetails.startingZonePoint || zoneDetails.entryPoint >= zoneEnd)
+        return;
+
+    std::vector<uint64> entryPoints;
+    entryPoints.push_back(zoneDetails.entryPoint - zoneDetails.startingZonePoint);
+    if (initData.codeEntryPoints.IsValid()) {
+        for (const auto offset : *initData.codeEntryPoints) {
+            if (offset >= zoneDetails.startingZonePoint && offset < zoneEnd)
+                entryPoints.push_back(offset - zoneDetails.startingZonePoint);
+        }
+    }
+    // the functions of big zones are explored on all the cores (the same zones that are decoded in parallel chunks)
+    const uint32 threads = zoneDetails.size >= ParallelDisassembly::MIN_ZONE_SIZE ? std::max<uint32>(std::thread::hardware_concurrency(), 1) : 1;
+    if (!zone->controlFlow.Build(*zone->decoder, instructionData, entryPoints, threads))
+        return;
+
+    // the linear sweep used for drawing starts with the first recovered instruction
+    const uint64 firstInstruction = zoneDetails.startingZonePoint + zone->controlFlow.GetBlocks()[0].start;
+    zone->cachedCodeOffsets.clear();
+    zone->cachedCodeOffsets.reserve(256);
+    zone->cachedCodeOffsets.push_back({ std::min<uint64>(zoneDetails.entryPoint, firstInstruction), 0 });
+}
+
+// names the recovered functions (sub_) and the targets of their jumps (offset_)
+inline std::vector<std::pair<uint64, std::string>> GetControlFlowNames(const DissasmCodeZone* zone)
+{
+    const auto& controlFlow  = zone->controlFlow;
+    const auto& functions    = controlFlow.GetFunctions();
+    const uint64 zoneStart   = zone->zoneDetails.startingZonePoint;
+    const uint64 firstOffset = zone->cachedCodeOffsets[0].offset;
+
+    std::vector<std::pair<uint64, std::string>> labels;
+    labels.reserve(functions.size() + controlFlow.GetJumpTargets().size() + 1);
+    for (const auto& function : functions) {
+        const uint64 value = zoneStart + function.entry;
+        if (value >= firstOffset)
+            labels.emplace_back(value, FormatFunctionName(value, "sub_0x").GetText());
+    }
+    auto function = functions.begin();
+    for (const auto target : controlFlow.GetJumpTargets()) {
+        while (function != functions.end() && function->entry < target)
+            ++function;
+        if (function != functions.end() && function->entry == target)
+            continue;
+        const uint64 value = zoneStart + target;
+        if (value >= firstOffset)
+            labels.emplace_back(value, FormatFunctionName(value, "offset_0x").GetText());
+    }
+    return labels;
+}
+
+// big zones with a control flow graph are decoded in chunks (split at function entries) on all the cores
+inline bool StartParallelDisassembly(DissasmCodeZone* zone, Reference<GView::Object> obj)
+{
+    const uint32 threads               = std::thread::hardware_concurrency();
+    const DisassemblyZone& zoneDetails = zone->zoneDetails;
+    if (!zone->controlFlow.IsBuilt() || zoneDetails.size < ParallelDisassembly::MIN_ZONE_SIZE || threads < 2)
+        return false;
+
+    auto labels = GetControlFlowNames(zone);
+    PrepareLabels(labels, zone);
+    std::vector<uint64> labelOffsets;
+    labelOffsets.reserve(labels.size());
+    for (const auto& label : labels)
+        labelOffsets.push_back(label.first - zoneDetails.startingZonePoint);
+
+    auto parallelDisassembly      = std::make_unique<ParallelDisassembly>();
+    const uint64 firstInstruction = zone->cachedCodeOffsets[0].offset - zoneDetails.startingZonePoint;
+    if (!parallelDisassembly->Start(
+              obj->GetData(), zoneDetails, zone->internalArchitecture, zone->controlFlow, firstInstruction, std::move(labelOffsets), threads))
+        return false;
+    zone->parallelDisassembly = std::move(parallelDisassembly);
+    zone->parallelLabels      = std::move(labels);
+    zone->parallelAsmLines    = 0;
     return true;
 }
 
@@ -328,13 +360,32 @@ bool GView::View::DissasmViewer::DissasmCodeZone::InitZone(DissasmCodeZoneInitDa
     }
     }
 
-    uint32 totalLines = 0;
-    if (!populateOffsetsVector(cachedCodeOffsets, zoneDetails, initData.obj, internalArchitecture, totalLines)) {
-        initData.dli->WriteErrorToScreen("ERROR: failed to populate offsets vector!");
+    decoder = initData.decoders.IsValid() ? initData.decoders->Get(internalArchitecture) : nullptr;
+    if (!decoder.IsValid()) {
+        initData.dli->WriteErrorToScreen("ERROR: failed to open the dissasembler!");
         return false;
     }
-    if (initData.enableDeepScanDissasmOnStart &&
-        !ExtractCallsToInsertFunctionNames(cachedCodeOffsets, this, initData.obj, internalArchitecture, totalLines, initData.maxLocationMemoryMappingSize)) {
+
+    controlFlow.Clear();
+    uint32 totalLines    = 0;
+    const bool fromCache = initData.cache.IsValid() && LoadFromCache(*initData.cache, totalLines);
+    if (!fromCache && initData.enableControlFlowAnalysis)
+        BuildControlFlowGraph(this, initData);
+
+    if (fromCache) {
+        // the listing was analysed in a previous session -> no decoding is needed
+    } else if (StartParallelDisassembly(this, initData.obj)) {
+        // only the first chunk is waited for, the rest of the listing is added while the zone is drawn
+        FetchParallelDisassembly(true, totalLines);
+    } else if (!populateOffsetsVector(cachedCodeOffsets, zoneDetails, initData.obj, *decoder, totalLines, controlFlow.IsBuilt())) {
+        initData.dli->WriteErrorToScreen("ERROR: failed to populate offsets vector!");
+        return false;
+    } else if (controlFlow.IsBuilt()) {
+        auto labels = GetControlFlowNames(this);
+        InsertLabelsAsAnnotations(labels, this, initData.obj, totalLines);
+    } else if (
+          initData.enableDeepScanDissasmOnStart &&
+          !ExtractCallsToInsertFunctionNames(cachedCodeOffsets, this, initData.obj, *decoder, totalLines, initData.maxLocationMemoryMappingSize)) {
         initData.dli->WriteErrorToScreen("ERROR: failed to populate offsets vector!");
         return false;
     }
@@ -365,13 +416,142 @@ bool GView::View::DissasmViewer::DissasmCodeZone::InitZone(DissasmCodeZoneInitDa
     types.push_back(dissasmType);
     levels.push_back(0);
 
-    dissasmType.indexZoneStart = 0; //+1 for the title
-    dissasmType.indexZoneEnd   = totalLines + 1;
+    if (!fromCache) {
+        dissasmType.indexZoneStart = 0; //+1 for the title
+        dissasmType.indexZoneEnd   = totalLines + 1;
+    }
     // dissasmType.annotations.insert({ 2, "loc fn" });
 
     return true;
 }
 
+bool DissasmCodeZone::FetchParallelDisassembly(bool wait, uint32& totalLines)
+{
+    if (!parallelDisassembly)
+        return false;
+
+    auto& annotations        = dissasmType.annotations;
+    const uint64 firstOffset = cachedCodeOffsets[0].offset;
+    bool hasNewLines         = false;
+    while (const auto chunk = parallelDisassembly->FetchNext(wait)) {
+        wait = false;
+        for (const auto& offset : chunk->offsets) {
+            const AsmOffsetLine value = { zoneDetails.startingZonePoint + offset.offset, parallelAsmLines + offset.line };
+            if (cachedCodeOffsets.back().offset == value.offset)
+                cachedCodeOffsets.back() = value;
+            else
+                cachedCodeOffsets.push_back(value);
+        }
+        for (uint32 i = 0; i < chunk->labelLines.size(); i++) {
+            const auto& label = parallelLabels[chunk->firstLabel + i];
+            const uint32 line = parallelAsmLines + chunk->labelLines[i] + static_cast<uint32>(annotations.size());
+            annotations.insert({ line, { label.second, label.first - firstOffset } });
+            annotations.add_initial_name(label.second);
+        }
+        parallelAsmLines += chunk->linesCount;
+        hasNewLines = true;
+    }
+    if (parallelDisassembly->IsFinished()) {
+        parallelDisassembly.reset();
+        parallelLabels.clear();
+        parallelLabels.shrink_to_fit();
+    }
+    if (!hasNewLines)
+        return false;
+
+    totalLines               = parallelAsmLines + static_cast<uint32>(annotations.size());
+    dissasmType.indexZoneEnd = totalLines + 2; //+1 for title
+    offsetCacheMaxLine       = 0;              // the next line is searched in the extended offsets table
+    ResetZoneCaching();
+    return true;
+}
+
+bool DissasmCodeZone::AddControlFlowCollapsibleZones(Reference<GView::Object> obj)
+{
+    if (!controlFlow.IsBuilt() || parallelDisassembly || !dissasmType.internalTypes.empty())
+        return false;
+
+    const auto& annotations = dissasmType.annotations.mappings;
+    // the annotation lines, converted to the asm line of the instruction that follows them (sorted)
+    std::vector<uint32> labelAsmLines;
+    labelAsmLines.reserve(annotations.size());
+    for (const auto& annotation : annotations)
+        labelAsmLines.push_back(annotation.first - static_cast<uint32>(labelAsmLines.size()));
+    auto countLabelsUntil = [&labelAsmLines](uint32 asmLine) {
+        return static_cast<uint32>(std::upper_bound(labelAsmLines.begin(), labelAsmLines.end(), asmLine) - labelAsmLines.begin());
+    };
+
+    // GetCurrentInstructionByOffset moves the drawing position of the zone
+    const auto savedClosestLine = lastClosestLine;
+    const auto savedAddress     = asmAddress;
+    const auto savedSize        = asmSize;
+    const auto savedData        = lastData;
+    const auto savedAsmData     = asmData;
+
+    // [zone line start, zone line end) of every named function, sorted and without overlaps
+    std::vector<std::pair<uint32, uint32>> functionLines;
+    functionLines.reserve(controlFlow.GetFunctions().size());
+    const uint64 firstOffset = cachedCodeOffsets[0].offset;
+    for (const auto& function : controlFlow.GetFunctions()) {
+        const uint64 entry = zoneDetails.startingZonePoint + function.entry;
+        if (entry < firstOffset)
+            continue;
+        uint32 entryAsmLine = 0, lastAsmLine = 0;
+        if (!GetCurrentInstructionByOffset(entry, this, obj, entryAsmLine))
+            continue;
+        if (!GetCurrentInstructionByOffset(zoneDetails.startingZonePoint + function.end - 1, this, obj, lastAsmLine))
+            continue;
+        const uint32 labelsCount = countLabelsUntil(entryAsmLine);
+        if (labelsCount == 0 || labelAsmLines[labelsCount - 1] != entryAsmLine)
+            continue; // the function has no name
+        const uint32 zoneLineStart = entryAsmLine + labelsCount - 1;
+        const uint32 zoneLineEnd   = lastAsmLine + countLabelsUntil(lastAsmLine) + 1;
+        if ((!functionLines.empty() && zoneLineStart < functionLines.back().second) || zoneLineEnd > dissasmType.indexZoneEnd)
+            continue;
+        functionLines.emplace_back(zoneLineStart, zoneLineEnd);
+    }
+
+    lastClosestLine = savedClosestLine;
+    asmAddress      = savedAddress;
+    asmSize         = savedSize;
+    lastData        = savedData;
+    asmData         = savedAsmData;
+
+    if (functionLines.empty())
+        return false;
+
+    // the zones are built at once (adding them one by one with AddNewZone moves all the annotations every time)
+    auto& zones     = dissasmType.internalTypes;
+    auto addNewZone = [&](uint32 zoneLineStart, uint32 zoneLineEnd, bool isFunction) {
+        DissasmCodeInternalType newZone = {};
+        newZone.indexZoneStart          = zoneLineStart;
+        newZone.workingIndexZoneStart   = zoneLineStart;
+        newZone.indexZoneEnd            = zoneLineEnd;
+        newZone.workingIndexZoneEnd     = zoneLineEnd;
+        if (isFunction)
+            newZone.name = annotations.at(zoneLineStart).first;
+        if (!zones.empty())
+            newZone.UpdateDataLineFromPrevious(zones.back());
+        newZone.annotations.insert(annotations.lower_bound(zoneLineStart), annotations.lower_bound(zoneLineEnd));
+        const auto& comments = dissasmType.commentsData.comments;
+        newZone.commentsData.comments.insert(comments.lower_bound(zoneLineStart == 0 ? 0 : zoneLineStart - 1), comments.lower_bound(zoneLineEnd - 1));
+        zones.push_back(std::move(newZone));
+    };
+
+    zones.reserve(functionLines.size() * 2 + 1);
+    uint32 lastZoneLineEnd = dissasmType.indexZoneStart;
+    for (const auto& [zoneLineStart, zoneLineEnd] : functionLines) {
+        if (lastZoneLineEnd < zoneLineStart)
+            addNewZone(lastZoneLineEnd, zoneLineStart, false);
+        addNewZone(zoneLineStart, zoneLineEnd, true);
+        lastZoneLineEnd = zoneLineEnd;
+    }
+    if (lastZoneLineEnd < dissasmType.indexZoneEnd)
+        addNewZone(lastZoneLineEnd, dissasmType.indexZoneEnd, false);
+
+    return ResetTypesReferenceList();
+}
+
 void DissasmCodeZone::ReachZoneLine(uint32 line)
 {
     changedLevel = false;
@@ -409,18 +589,9 @@ void DissasmCodeZone::ReachZoneLine(uint32 line)
     }
 
     DissasmCodeInternalType& currentType = types.back();
-    // TODO: do a faster search using a binary search using the annotations and start from there
-    // TODO: maybe use some caching here?
+    // a jump -> the lines are counted again with the annotation lines index
     if (reAdapt || levelNow < levelToReach && levelNow + 1 != levelToReach || levelNow > levelToReach && levelNow - 1 != levelToReach) {
-        currentType.textLinesPassed = 0;
-        currentType.asmLinesPassed  = 0;
-        for (uint32 i = currentType.indexZoneStart; i <= levelToReach; i++) {
-            if (currentType.annotations.contains(i)) {
-                currentType.textLinesPassed++;
-                continue;
-            }
-            currentType.asmLinesPassed++;
-        }
+        currentType.CountLinesPassed(levelToReach);
     } else {
         if (currentType.annotations.contains(levelToReach))
             currentType.textLinesPassed++;
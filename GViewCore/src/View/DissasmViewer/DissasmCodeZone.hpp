@@ -1,6 +1,8 @@
 #pragma once
 
 #include "DissasmViewer.hpp"
+#include "ControlFlowGraph.hpp"
+#include "ParallelDisassembly.hpp"
 
 namespace GView::View::DissasmViewer
 {
@@ -13,6 +15,7 @@ struct DissasmCodeZone : public ParseZone {
     uint32 lastReachedLine = UINT32_MAX;
 
     // fields only for dissasmx86/x64
+    Reference<DissasmDecoder> decoder; // owned by the view
     const uint8* asmData;
     uint64 asmSize, asmAddress;
 
@@ -25,6 +28,10 @@ struct DissasmCodeZone : public ParseZone {
 
     std::vector<AsmOffsetLine> cachedCodeOffsets;
     DisassemblyZone zoneDetails;
+    ControlFlowGraph controlFlow; // empty when the control flow analysis is disabled
+    std::unique_ptr<ParallelDisassembly> parallelDisassembly; // only while the listing of a big zone is decoded in the background
+    std::vector<std::pair<uint64, std::string>> parallelLabels;
+    uint32 parallelAsmLines = 0; // asm lines fetched from parallelDisassembly
     int internalArchitecture; // used for dissasm libraries
     bool isInit;
     bool changedLevel;
@@ -42,6 +49,10 @@ struct DissasmCodeZone : public ParseZone {
     bool RemoveCollapsibleZone(uint32 zoneLine);
 
     bool InitZone(DissasmCodeZoneInitData& initData);
+    // adds the chunks decoded in the background to the listing -> true (and the new size of the zone without its title) if there are new lines
+    bool FetchParallelDisassembly(bool wait, uint32& totalLines);
+    // one collapsible zone for every recovered function (only if the zone does not have collapsible zones already)
+    bool AddControlFlowCollapsibleZones(Reference<GView::Object> obj);
     void ReachZoneLine(uint32 line);
 
     bool ResetTypesReferenceList();
@@ -53,8 +64,9 @@ struct DissasmCodeZone : public ParseZone {
     bool RemoveComment(uint32 line, bool showErr = true);
     DissasmAsmPreCacheLine GetCurrentAsmLine(uint32 currentLine, Reference<GView::Object> obj, DissasmInsnExtractLineParams* params);
 
-    bool ToBuffer(std::vector<std::byte>& buffer) const;
-    bool TryLoadDataFromCache(DissasmCache& cache);
+    bool SaveToCache(DissasmCacheWriter& writer) const;
+    // the line index, labels, comments and collapsible zones of a previous analysis -> true (and the size of the zone without its title)
+    bool LoadFromCache(const DissasmCache& cache, uint32& totalLines);
 };
 
 } // namespace GView::View::DissasmViewer
@@ -1,6 +1,6 @@
 #include "DissasmDataTypes.hpp"
-#include "DissasmIOHelpers.hpp"
-#include <array>
+
+#include <bit>
 
 using namespace GView::View::DissasmViewer;
 
@@ -49,129 +49,62 @@ void DissasmComments::AdjustCommentsOffsets(uint32 changedLine, bool isAddedLine
     comments = std::move(commentsAjusted);
 }
 
-uint32 DissasmComments::GetRequiredSizeForSerialization() const
-{
-    uint32 result = 0;
-    for (const auto& comment : comments) {
-        result += sizeof(comment.first) + sizeof(uint32) + (uint32) comment.second.size();
-    }
-    return result;
-}
-
-void DissasmComments::ToBuffer(std::vector<std::byte>& buffer) const
+void AnnotationLinesIndex::BuildTree()
 {
-    append_bytes(buffer, (uint32) comments.size());
-    for (const auto& comment : comments) {
-        append_bytes(buffer, comment.first);
-        append_string(buffer, comment.second);
+    // O(n) construction: every node adds its sum to its parent
+    const auto blocksCount = static_cast<uint32>(bits.size());
+    tree.assign(blocksCount + 1, 0);
+    for (uint32 i = 1; i <= blocksCount; i++) {
+        tree[i] += static_cast<uint32>(std::popcount(bits[i - 1]));
+        const uint32 parent = i + (i & (0 - i));
+        if (parent <= blocksCount)
+            tree[parent] += tree[i];
     }
 }
 
-bool DissasmComments::LoadFromBuffer(const std::byte*& start, const std::byte* end)
+void AnnotationLinesIndex::Add(uint32 line)
 {
-    if (start + sizeof(uint32) > end)
-        return false;
-
-    uint32 commentsCount = 0;
-    if (!read_primitive(start, end, commentsCount))
-        return false;
-    while (commentsCount > 0) {
-        uint32 offset = 0;
-        if (!read_primitive(start, end, offset))
-            return false;
-        uint32 comment_size = 0;
-        if (!read_primitive(start, end, comment_size))
-            return false;
-        const std::byte* out = nullptr;
-        if (!read_bytes(start, end, comment_size, out))
-            return false;
-        comments[offset] = std::string((const char*) out, comment_size);
-        --commentsCount;
+    if (!built)
+        return; // built from all the lines on the next count
+    if (bits.empty())
+        firstLine = line / BLOCK_LINES * BLOCK_LINES;
+    if (line < firstLine) {
+        built = false;
+        return;
     }
 
-    return true;
-}
-
-uint32 AnnotationContainer::GetRequiredSizeForSerialization() const
-{
-    uint32 result = 3 * sizeof(uint32);
-    for (const auto& annotation : mappings) {
-        result += sizeof(annotation.first) + sizeof(uint32) + (uint32) annotation.second.first.size() + sizeof(annotation.second.second);
-    }
-    for (const auto& name : initial_name_to_current_name) {
-        result += sizeof(uint32) + (uint32) name.first.size() + sizeof(uint32) + (uint32) name.second.size();
-    }
-    for (const auto& name : current_name_to_initial_name) {
-        result += sizeof(uint32) + (uint32) name.first.size() + sizeof(uint32) + (uint32) name.second.size();
-    }
-    return result;
-}
-
-void AnnotationContainer::ToBuffer(std::vector<std::byte>& buffer) const
-{
-    append_bytes(buffer, (uint32) mappings.size());
-    for (const auto& [line, details] : mappings) {
-        const auto& [call_name, call_value] = details;
-        append_bytes(buffer, line);
-        append_string(buffer, call_name);
-        append_bytes(buffer, call_value);
-    }
-    std::array<const MapNameLinkType*, 2> availableMaps  = { &initial_name_to_current_name, &current_name_to_initial_name };
-    for (const auto& map : availableMaps) {
-        append_bytes(buffer, (uint32) map->size());
-        for (const auto& [name1, name2] : *map) {
-            append_string(buffer, name1);
-            append_string(buffer, name2);
-        }
+    const uint32 offset = line - firstLine;
+    const uint32 block  = offset / BLOCK_LINES;
+    const uint64 mask   = 1ULL << (offset % BLOCK_LINES);
+    if (block >= bits.size()) {
+        // the listing is usually extended at its end -> doubling keeps the rebuilds of the tree amortized O(1)
+        bits.resize(std::max<size_t>(block + 1, bits.size() * 2));
+        bits[block] |= mask;
+        linesCount++;
+        BuildTree();
+        return;
     }
+    if (bits[block] & mask)
+        return;
+    bits[block] |= mask;
+    linesCount++;
+    for (uint32 i = block + 1; i < tree.size(); i += i & (0 - i))
+        tree[i]++;
 }
 
-bool AnnotationContainer::LoadFromBuffer(const std::byte*& start, const std::byte* end)
+uint32 AnnotationLinesIndex::CountUntil(uint32 line) const
 {
-    if (start + sizeof(uint32) > end)
-        return false;
-    uint32 annotationsCount = 0;
-    if (!read_primitive(start, end, annotationsCount))
-        return false;
-    while (annotationsCount > 0) {
-        uint32 offset = 0;
-        if (!read_primitive(start, end, offset))
-            return false;
-        uint32 annotationSize       = 0;
-        const std::byte* annotation = nullptr;
-        if (!read_string_with_size(start, end, annotationSize, annotation))
-            return false;
-        AnnoationCallValueType callValue = 0;
-        if (!read_primitive(start, end, callValue))
-            return false;
-        std::string annName((const char*) annotation, annotationSize);
-        mappings[offset] = { std::move(annName), callValue };
-        --annotationsCount;
-    }
+    if (line < firstLine)
+        return 0;
+    const uint32 offset = line - firstLine;
+    const uint32 block  = offset / BLOCK_LINES;
+    if (block >= bits.size())
+        return linesCount;
 
-    std::array<MapNameLinkType*, 2> availableMaps = { &initial_name_to_current_name, &current_name_to_initial_name };
-
-    for (const auto& map : availableMaps) {
-        uint32 count = 0;
-        if (!read_primitive(start, end, count))
-            return false;
-        while (count > 0) {
-            uint32 name1Size            = 0;
-            const std::byte* name1Value = nullptr;
-            if (!read_string_with_size(start, end, name1Size, name1Value))
-                return false;
-            uint32 name2Size            = 0;
-            const std::byte* name2Value = nullptr;
-            if (!read_string_with_size(start, end, name2Size, name2Value))
-                return false;
-
-            auto name1 = std::string((const char*) name1Value, name1Size);
-            auto name2 = std::string((const char*) name2Value, name2Size);
-
-            (*map)[std::move(name1)] = std::move(name2);
-            --count;
-        }
-    }
-
-    return true;
+    uint32 result = 0;
+    for (uint32 i = block; i > 0; i -= i & (0 - i))
+        result += tree[i];
+    const uint32 bit  = offset % BLOCK_LINES;
+    const uint64 mask = bit == BLOCK_LINES - 1 ? ~0ULL : (2ULL << bit) - 1;
+    return result + static_cast<uint32>(std::popcount(bits[block] & mask));
 }
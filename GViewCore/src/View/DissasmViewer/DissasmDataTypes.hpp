@@ -48,10 +48,48 @@ namespace View
             bool HasComment(uint32 line) const;
             void RemoveComment(uint32 line);
             void AdjustCommentsOffsets(uint32 changedLine, bool isAddedLine);
+        };
 
-            uint32 GetRequiredSizeForSerialization() const;
-            void ToBuffer(std::vector<std::byte>& buffer) const;
-            bool LoadFromBuffer(const std::byte*& start, const std::byte* end);
+        // Number of annotation lines up to a line in O(log n): every line is a bit in a block of 64 lines and a Fenwick tree keeps
+        // the number of annotation lines of the blocks, so adding a line is O(log n) as well (amortized when the index grows).
+        class AnnotationLinesIndex
+        {
+            static constexpr uint32 BLOCK_LINES = 64;
+
+            uint32 firstLine  = 0;    // first line of the first block
+            uint32 linesCount = 0;
+            std::vector<uint64> bits; // one bit for every line
+            std::vector<uint32> tree; // Fenwick tree (1 based) over the number of annotation lines of every block
+            bool built = false;
+
+            void BuildTree();
+
+          public:
+            template <typename LinesMap>
+            void Build(const LinesMap& lines)
+            {
+                bits.clear();
+                firstLine  = lines.empty() ? 0 : lines.begin()->first / BLOCK_LINES * BLOCK_LINES;
+                linesCount = static_cast<uint32>(lines.size());
+                for (const auto& line : lines) {
+                    const uint32 offset = line.first - firstLine;
+                    if (offset / BLOCK_LINES >= bits.size())
+                        bits.resize(offset / BLOCK_LINES + 1);
+                    bits[offset / BLOCK_LINES] |= 1ULL << (offset % BLOCK_LINES);
+                }
+                BuildTree();
+                built = true;
+            }
+            inline bool IsBuilt() const
+            {
+                return built;
+            }
+            inline void Invalidate()
+            {
+                built = false;
+            }
+            void Add(uint32 line);
+            uint32 CountUntil(uint32 line) const; // annotation lines in [0, line]
         };
 
         struct AnnotationContainer {
@@ -68,9 +106,10 @@ namespace View
             using mapped_type    = typename AnnotationMap::mapped_type;
             using key_type       = typename AnnotationMap::key_type;
 
-            AnnotationMap mappings;
+            AnnotationMap mappings; // the lines must be added through the container (so the lines index is kept up to date)
             MapNameLinkType initial_name_to_current_name;
             MapNameLinkType current_name_to_initial_name;
+            mutable AnnotationLinesIndex linesIndex; // built on the first count
 
             std::size_t size() const
             {
@@ -89,30 +128,49 @@ namespace View
 
             std::pair<iterator, bool> insert(const value_type& v)
             {
-                return mappings.insert(v);
+                auto result = mappings.insert(v);
+                if (result.second)
+                    linesIndex.Add(v.first);
+                return result;
             }
 
             template <class P, std::enable_if_t<std::is_constructible_v<value_type, P&&>, int> = 0>
             std::pair<iterator, bool> insert(P&& v)
             {
-                return mappings.insert(std::forward<P>(v));
+                auto result = mappings.insert(std::forward<P>(v));
+                if (result.second)
+                    linesIndex.Add(result.first->first);
+                return result;
             }
 
             template <class InputIt>
             void insert(InputIt first, InputIt last)
             {
                 mappings.insert(first, last);
+                linesIndex.Invalidate();
             }
 
             mapped_type& operator[](const key_type& k)
             {
+                if (!mappings.contains(k))
+                    linesIndex.Add(k);
                 return mappings[k];
             }
             mapped_type& operator[](key_type&& k)
             {
+                if (!mappings.contains(k))
+                    linesIndex.Add(k);
                 return mappings[std::move(k)];
             }
 
+            // annotation lines in [0, line]
+            uint32 count_lines_until(AnnoationLineNumberType line) const
+            {
+                if (!linesIndex.IsBuilt())
+                    linesIndex.Build(mappings);
+                return linesIndex.CountUntil(line);
+            }
+
             bool contains(const key_type& k) const
             {
                 return mappings.contains(k);
@@ -174,13 +232,10 @@ namespace View
             void populate_annotations_from_other_storage(const AnnotationContainer& other)
             {
                 mappings.insert(other.mappings.begin(), other.mappings.end());
+                linesIndex.Invalidate();
                 initial_name_to_current_name.insert(other.initial_name_to_current_name.begin(), other.initial_name_to_current_name.end());
                 current_name_to_initial_name.insert(other.current_name_to_initial_name.begin(), other.current_name_to_initial_name.end());
             }
-
-            uint32 GetRequiredSizeForSerialization() const;
-            void ToBuffer(std::vector<std::byte>& buffer) const;
-            bool LoadFromBuffer(const std::byte*& start, const std::byte* end);
         };
 
 
@@ -122,6 +122,89 @@ bool CheckExtractInsnHexValue(const char* op_str, uint64& value, uint64 maxSize)
     return true;
 }
 
+bool ExtractInsnOperandValue(const cs_insn* insn, uint64& value, uint64 maxSize)
+{
+    // maxSize == 0 -> there are no memory mappings, so no value can be a location
+    if (maxSize == 0 || !insn->detail || insn->detail->x86.op_count == 0)
+        return false;
+    const auto& op = insn->detail->x86.operands[0];
+    switch (op.type) {
+    case X86_OP_IMM:
+        value = static_cast<uint64>(op.imm);
+        break;
+    case X86_OP_MEM:
+        // only absolute locations ([0x1234]), not the ones computed from registers
+        if (op.mem.base != X86_REG_INVALID || op.mem.index != X86_REG_INVALID)
+            return false;
+        value = static_cast<uint64>(op.mem.disp);
+        break;
+    default:
+        return false;
+    }
+    if (maxSize < sizeof(uint64) * 2)
+        value &= (1ull << (maxSize * 4)) - 1;
+    return true;
+}
+
+bool ExtractInsnBranchTarget(const cs_insn* insn, uint64& target)
+{
+    if (!insn->detail || insn->detail->x86.op_count == 0 || insn->detail->x86.operands[0].type != X86_OP_IMM)
+        return false;
+    target = static_cast<uint64>(insn->detail->x86.operands[0].imm);
+    return true;
+}
+
+bool IsInsnRegisterOperand(const cs_insn* insn, uint8 index, x86_reg reg)
+{
+    if (!insn->detail || index >= insn->detail->x86.op_count)
+        return false;
+    const auto& op = insn->detail->x86.operands[index];
+    return op.type == X86_OP_REG && op.reg == reg;
+}
+
+DissasmDecoder::DissasmDecoder() : handle(0), insn(nullptr), mode(CS_MODE_32)
+{
+}
+
+DissasmDecoder::~DissasmDecoder()
+{
+    if (insn)
+        cs_free(insn, 1);
+    if (handle)
+        cs_close(&handle);
+}
+
+bool DissasmDecoder::Init(cs_arch arch, cs_mode mode, bool detail)
+{
+    if (insn)
+        return true;
+    const auto resCode = cs_open(arch, mode, &handle);
+    CHECK(resCode == CS_ERR_OK, false, "%s", cs_strerror(resCode));
+    this->mode           = mode;
+    const auto resOption = cs_option(handle, CS_OPT_DETAIL, detail ? CS_OPT_ON : CS_OPT_OFF);
+    if (resOption != CS_ERR_OK) {
+        cs_close(&handle);
+        handle = 0;
+        RETURNERROR(false, "%s", cs_strerror(resOption));
+    }
+    insn = cs_malloc(handle);
+    return insn != nullptr;
+}
+
+Reference<DissasmDecoder> DissasmDecoders::Get(int internalArchitecture)
+{
+    switch (internalArchitecture) {
+    case CS_MODE_32:
+        CHECK(x86.Init(CS_ARCH_X86, CS_MODE_32), nullptr, "");
+        return &x86;
+    case CS_MODE_64:
+        CHECK(x64.Init(CS_ARCH_X86, CS_MODE_64), nullptr, "");
+        return &x64;
+    default:
+        RETURNERROR(nullptr, "Unsupported architecture: %d", internalArchitecture);
+    }
+}
+
 LocalString<64> FormatFunctionName(uint64 functionAddress, const char* prefix)
 {
     NumericFormatter formatter;
@@ -171,32 +254,25 @@ cs_insn* GetCurrentInstructionByOffset(
 
     zone->asmData = const_cast<uint8*>(zone->lastData.GetData());
 
-    // TODO: keep the handle open and insn open until the program ends
-    csh handle;
-    const auto resCode = cs_open(CS_ARCH_X86, static_cast<cs_mode>(zone->internalArchitecture), &handle);
-    if (resCode != CS_ERR_OK) {
+    if (!zone->decoder.IsValid()) {
         if (dli)
-            dli->WriteErrorToScreen(cs_strerror(resCode));
-        cs_close(&handle);
+            dli->WriteErrorToScreen("ERROR: the zone has no decoder!");
         return nullptr;
     }
 
     diffLines     = 0;
-    cs_insn* insn = cs_malloc(handle);
+    cs_insn* insn = zone->decoder->GetInstruction();
     if (offsetToReach >= zone->cachedCodeOffsets[0].offset)
         offsetToReach -= zone->cachedCodeOffsets[0].offset;
     while (zone->asmAddress <= offsetToReach) {
-        if (!cs_disasm_iter(handle, &zone->asmData, (size_t*) &zone->asmSize, &zone->asmAddress, insn)) {
+        if (!zone->decoder->Decode(zone->asmData, *(size_t*) &zone->asmSize, zone->asmAddress)) {
             if (dli)
                 dli->WriteErrorToScreen("Failed to dissasm!");
-            cs_free(insn, 1);
-            cs_close(&handle);
             return nullptr;
         }
         diffLines++;
     }
     diffLines += closestData.line - 1;
-    cs_close(&handle);
     return insn;
 }
 
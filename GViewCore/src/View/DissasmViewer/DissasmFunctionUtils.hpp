@@ -10,8 +10,16 @@ constexpr uint32 retOP  = 7628146u;    //*((uint32*) "ret");
 
 // TODO: maybe add also minimum number?
 bool CheckExtractInsnHexValue(const char* op_str, AppCUI::uint64& value, AppCUI::uint64 maxSize);
+// value of the first operand taken from the instruction details: an immediate (for jumps and calls it is relative to the
+// address the instruction was decoded at) or an absolute memory location ([0x1234]); maxSize is the maximum number of hex
+// digits kept from the value (0 -> no value is extracted)
+bool ExtractInsnOperandValue(const cs_insn* insn, AppCUI::uint64& value, AppCUI::uint64 maxSize);
+// target of a jump/call with an immediate operand (relative to the address the instruction was decoded at)
+bool ExtractInsnBranchTarget(const cs_insn* insn, AppCUI::uint64& target);
+bool IsInsnRegisterOperand(const cs_insn* insn, AppCUI::uint8 index, x86_reg reg);
 AppCUI::Utils::LocalString<64> FormatFunctionName(AppCUI::uint64 functionAddress, const char* prefix);
 
+// the returned instruction belongs to the zone decoder (valid until its next decode)
 cs_insn* GetCurrentInstructionByOffset(
       uint64 offsetToReach,
       GView::View::DissasmViewer::DissasmCodeZone* zone,
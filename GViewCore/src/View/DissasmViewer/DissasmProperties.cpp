@@ -7,6 +7,7 @@ enum DissasmProperties : uint32 {
     // Config properties
     CacheSameLocationAsAnalyzedFileConfig,
     DeepScanDissasmOnStartConfig,
+    ControlFlowAnalysisConfig,
     ShowFileContentConfig,
     ShowOnlyDissasmConfig,
 };
@@ -23,6 +24,9 @@ bool Instance::GetPropertyValue(uint32 propertyID, PropertyValue& value)
     case DeepScanDissasmOnStartConfig:
         value = config.EnableDeepScanDissasmOnStart;
         return true;
+    case ControlFlowAnalysisConfig:
+        value = config.EnableControlFlowAnalysis;
+        return true;
     case CacheSameLocationAsAnalyzedFileConfig:
         value = config.CacheSameLocationAsAnalyzedFile;
         return true;
@@ -48,6 +52,9 @@ bool Instance::SetPropertyValue(uint32 propertyID, const PropertyValue& value, S
     case DeepScanDissasmOnStartConfig:
         config.EnableDeepScanDissasmOnStart = std::get<bool>(value);
         return true;
+    case ControlFlowAnalysisConfig:
+        config.EnableControlFlowAnalysis = std::get<bool>(value);
+        return true;
     case CacheSameLocationAsAnalyzedFileConfig:
         config.CacheSameLocationAsAnalyzedFile = std::get<bool>(value);
         return true;
@@ -76,6 +83,7 @@ const vector<Property> Instance::GetPropertiesList()
         { ShowFileContentConfig, "Config", "ShowFileContent", PropertyType::Boolean, true },
         { ShowOnlyDissasmConfig, "Config", "ShowOnlyDissasm", PropertyType::Boolean, true },
         { DeepScanDissasmOnStartConfig, "Config", "DeepScanDissasmOnStart", PropertyType::Boolean, true },
+        { ControlFlowAnalysisConfig, "Config", "ControlFlowAnalysis", PropertyType::Boolean, true },
         { CacheSameLocationAsAnalyzedFileConfig, "Config", "CacheSameLocationAsAnalyzedFile", PropertyType::Boolean, true },
     };
 
@@ -57,8 +57,6 @@ namespace View
             uint64 size;
             uint64 entryPoint;
             DisassemblyLanguage language;
-
-            bool ToBuffer(std::vector<std::byte>& buffer, Reference<GView::Object> obj) const;
         };
 
         enum class InternalDissasmType : uint8 {
@@ -129,6 +127,11 @@ namespace View
             uint32 line;
         };
 
+        // the line table of a code zone keeps an AsmOffsetLine every DISSASM_INSTRUCTION_OFFSET_MARGIN bytes of code
+        constexpr uint32 DISSASM_INSTRUCTION_OFFSET_MARGIN = 500;
+        // the linear disassembly of a zone stops after this many consecutive "00 00" instructions (zero padding)
+        constexpr uint32 DISSASM_ZERO_PADDING_STOP = 30; // TODO: update this -> for now it stops, later will fold
+
         struct DissasmCodeZone;
         struct DissasmInsnExtractLineParams {
             Reference<GView::Object> obj;
@@ -339,6 +342,19 @@ namespace View
                 return beforeAsmLines + asmLinesPassed + beforeTextLines + textLinesPassed;
             }
 
+            // textLinesPassed/asmLinesPassed for the lines in [indexZoneStart, line] (O(log n), used when the listing jumps)
+            void CountLinesPassed(uint32 line)
+            {
+                textLinesPassed = 0;
+                asmLinesPassed  = 0;
+                if (line < indexZoneStart)
+                    return;
+                textLinesPassed = annotations.count_lines_until(line);
+                if (indexZoneStart > 0)
+                    textLinesPassed -= annotations.count_lines_until(indexZoneStart - 1);
+                asmLinesPassed = line - indexZoneStart + 1 - textLinesPassed;
+            }
+
             uint32 GetSize() const
             {
                 if (isCollapsed)
@@ -366,14 +382,65 @@ namespace View
             bool RemoveCollapsibleZone(uint32 zoneLine, const DissasmCodeRemovableZoneDetails& removableDetails);
         };
 
+        // capstone handle and instruction buffer (with the operand details), opened once and reused for every decoded
+        // instruction; the instruction is overwritten by the next decode done with the same decoder
+        class DissasmDecoder
+        {
+            csh handle;
+            cs_insn* insn;
+            cs_mode mode;
+
+          public:
+            DissasmDecoder();
+            ~DissasmDecoder();
+            DissasmDecoder(const DissasmDecoder&)            = delete;
+            DissasmDecoder& operator=(const DissasmDecoder&) = delete;
+
+            // detail = false -> only the size, the bytes and the text of the instructions are decoded (much faster)
+            bool Init(cs_arch arch, cs_mode mode, bool detail = true);
+            inline bool IsValid() const
+            {
+                return insn != nullptr;
+            }
+            inline csh GetHandle() const
+            {
+                return handle;
+            }
+            inline cs_mode GetMode() const
+            {
+                return mode;
+            }
+            inline cs_insn* GetInstruction() const
+            {
+                return insn;
+            }
+            inline bool Decode(const uint8*& data, size_t& size, uint64& address)
+            {
+                return cs_disasm_iter(handle, &data, &size, &address, insn);
+            }
+        };
+
+        // one decoder per architecture, opened on first use and shared by all the code zones of a view
+        class DissasmDecoders
+        {
+            DissasmDecoder x86, x64;
+
+          public:
+            Reference<DissasmDecoder> Get(int internalArchitecture);
+        };
+
         struct DissasmCodeZoneInitData {
             Reference<DrawLineInfo> dli;
+            Reference<DissasmDecoders> decoders;
             int32 adjustedZoneSize;
             bool hasAdjustedSize;
             bool enableDeepScanDissasmOnStart;
+            bool enableControlFlowAnalysis;
+            Reference<std::vector<uint64>> codeEntryPoints;
             Reference<GView::Object> obj;
             uint64 maxLocationMemoryMappingSize;
             uint32 visibleRows;
+            Reference<DissasmCache> cache; // analysis saved from a previous session (if any)
         };
 
         struct InternalTypeNewLevelChangeData {
@@ -394,6 +461,7 @@ namespace View
 
             DisassemblyLanguage defaultLanguage;
             std::map<uint64, DisassemblyZone> disassemblyZones;
+            std::vector<uint64> codeEntryPoints; // extra function starts for the control flow analysis
             std::deque<char*> buffersToDelete;
             uint32 availableID;
 
@@ -406,8 +474,8 @@ namespace View
             std::unordered_map<TypeID, DissasmStructureType> userDesignedTypes; // user defined types
             Reference<BufferViewer::OffsetTranslateInterface> offsetTranslateCallback;
 
-            bool SaveToCache(DissasmCache& cache, Reference<GView::Object> obj);
-            bool ValidateCacheData(DissasmCache& cache, Reference<GView::Object> obj);
+            // MD5 of the disassembly zones (their details and their content) -> the key of the analysis cache
+            bool ComputeContentHash(Reference<GView::Object> obj, DissasmCacheContentHash& contentHash) const;
             SettingsData();
         };
 
@@ -569,6 +637,7 @@ namespace View
             // uint64 rightClickOffset;
 
             AsmData asmData;
+            DissasmDecoders decoders;
             JumpsHolder jumps_holder;
             DissasmCache cacheData;
             CommonInterfaces::QueryInterface* queryInterface;
@@ -604,6 +673,8 @@ namespace View
             [[nodiscard]] vector<ZoneLocation> GetZonesIndexesFromLinePosition(uint32 lineStart, uint32 lineEnd = 0) const;
 
             void AdjustZoneExtendedSize(ParseZone* zone, uint32 newExtendedSize);
+            // adds the lines decoded in the background since the last paint to the code zones
+            void FetchParallelDisassembly();
 
             void AnalyzeMousePosition(int x, int y, MousePositionInfo& mpInfo);
 
@@ -1278,6 +1278,24 @@ void GView::View::DissasmViewer::Instance::AdjustZoneExtendedSize(ParseZone* zon
     assert(foundZone);
 }
 
+void Instance::FetchParallelDisassembly()
+{
+    for (const auto& zone : settings->parseZones) {
+        if (zone->zoneType != DissasmParseZoneType::DissasmCodeParseZone)
+            continue;
+        const auto codeZone = static_cast<DissasmCodeZone*>(zone.get());
+        if (!codeZone->parallelDisassembly)
+            continue;
+        uint32 totalLines = 0;
+        if (codeZone->FetchParallelDisassembly(false, totalLines))
+            AdjustZoneExtendedSize(codeZone, totalLines + 1); //+1 for title
+        if (!codeZone->parallelDisassembly) {
+            // the listing is complete -> the function zones can be added
+            codeZone->AddControlFlowCollapsibleZones(obj);
+        }
+    }
+}
+
 bool Instance::WriteTextLineToChars(DrawLineInfo& dli)
 {
     const uint64 textFileOffset = ((uint64) this->Layout.textSize) * dli.textLineToDraw;
@@ -1345,6 +1363,8 @@ void Instance::Paint(AppCUI::Graphics::Renderer& renderer)
             zone->asmPreCacheData.Reset();
     }
 
+    FetchParallelDisassembly();
+
     DrawLineInfo dli(renderer, Layout.startingTextLineOffset, ColorMan.Colors.Normal);
 
     // TODO: improve this!!
@@ -1439,7 +1459,6 @@ void Instance::OnStart()
         }
         asmData.functions.insert({ hashVal, &KNOWN_FUNCTIONS[i] });
     }
-    LoadCacheData();
 }
 
 void Instance::RecomputeDissasmLayout()
@@ -1490,6 +1509,11 @@ void Instance::ChangeZoneCollapseState(ParseZone* zoneToChange, uint32 line)
 
 Instance::~Instance()
 {
+    // the background decoders use views of the object cache
+    for (auto& zone : settings->parseZones) {
+        if (zone->zoneType == DissasmParseZoneType::DissasmCodeParseZone)
+            static_cast<DissasmCodeZone*>(zone.get())->parallelDisassembly.reset();
+    }
     while (!settings->buffersToDelete.empty()) {
         char* bufferToDelete = settings->buffersToDelete.back();
         settings->buffersToDelete.pop_back();
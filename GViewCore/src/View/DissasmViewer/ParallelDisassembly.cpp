@@ -0,0 +1,190 @@
+#include "ParallelDisassembly.hpp"
+#include "ControlFlowGraph.hpp"
+
+#include <algorithm>
+
+using namespace GView::View::DissasmViewer;
+
+constexpr uint32 MAX_INSTRUCTION_SIZE = 16; // x86 instructions have at most 15 bytes
+
+ParallelDisassembly::ParallelDisassembly()
+    : cache(nullptr), zoneStart(0), zoneSize(0), mode(CS_MODE_32), nextChunk(0), stop(false), running(0), fetchedChunks(0), finished(true)
+{
+}
+
+ParallelDisassembly::~ParallelDisassembly()
+{
+    Stop();
+}
+
+bool ParallelDisassembly::Start(
+      GView::Utils::DataCache& cache,
+      const DisassemblyZone& zone,
+      int internalArchitecture,
+      const ControlFlowGraph& controlFlow,
+      uint64 firstInstruction,
+      std::vector<uint64> labels,
+      uint32 threads)
+{
+    Stop();
+    CHECK(threads > 0, false, "");
+    CHECK(firstInstruction < zone.size, false, "");
+
+    this->cache     = &cache;
+    this->zoneStart = zone.startingZonePoint;
+    this->zoneSize  = zone.size;
+    this->mode      = static_cast<cs_mode>(internalArchitecture);
+    this->labels    = std::move(labels);
+
+    // the chunks are split at function entries -> the linear sweep of every chunk starts with a known instruction
+    // (~8 chunks for each thread, so a chunk that is slow to decode does not keep the other threads waiting)
+    const auto& functions  = controlFlow.GetFunctions();
+    const uint64 chunkSize = std::max<uint64>(MIN_CHUNK_SIZE, (zoneSize - firstInstruction) / (threads * 8ULL));
+    auto function          = functions.begin();
+    auto label             = this->labels.begin();
+    chunks.clear();
+    for (uint64 start = firstInstruction; start < zoneSize;) {
+        const uint64 target = start + (chunks.empty() ? FIRST_CHUNK_SIZE : chunkSize);
+        function            = std::lower_bound(function, functions.end(), target, [](const auto& f, uint64 value) { return f.entry < value; });
+        const uint64 end    = function == functions.end() ? zoneSize : function->entry;
+        label               = std::lower_bound(label, this->labels.end(), start);
+
+        auto& chunk      = chunks.emplace_back();
+        chunk.start      = start;
+        chunk.end        = end;
+        chunk.firstLabel = static_cast<uint32>(label - this->labels.begin());
+        chunk.linesCount = 0;
+        chunk.lastChunk  = false;
+        chunk.completed  = false;
+        start            = end;
+    }
+
+    threads       = static_cast<uint32>(std::min<uint64>(threads, chunks.size()));
+    nextChunk     = 0;
+    stop          = false;
+    running       = threads;
+    fetchedChunks = 0;
+    finished      = false;
+    workers.reserve(threads);
+    for (uint32 i = 0; i < threads; i++)
+        workers.emplace_back(&ParallelDisassembly::Run, this);
+    return true;
+}
+
+void ParallelDisassembly::Stop()
+{
+    stop = true;
+    for (auto& worker : workers)
+        worker.join();
+    workers.clear();
+}
+
+void ParallelDisassembly::Run()
+{
+    // every worker has its own view of the cache and its own decoder (a capstone handle can not be shared between threads);
+    // the sweep only needs the sizes of the instructions -> no details
+    GView::Utils::DataCache view;
+    DissasmDecoder decoder;
+    if (view.InitView(*cache, cache->GetCacheSize()) && decoder.Init(CS_ARCH_X86, mode, false)) {
+        while (!stop) {
+            const auto index = nextChunk++;
+            if (index >= chunks.size())
+                break;
+            Decode(view, decoder, chunks[index]);
+
+            std::scoped_lock<std::mutex> guard(lock);
+            chunks[index].completed = !stop;
+            chunkCompleted.notify_all();
+        }
+    }
+
+    std::scoped_lock<std::mutex> guard(lock);
+    running--;
+    chunkCompleted.notify_all();
+}
+
+void ParallelDisassembly::Decode(GView::Utils::DataCache& view, DissasmDecoder& decoder, Chunk& chunk)
+{
+    const auto insn      = decoder.GetInstruction();
+    const auto pieceSize = view.GetCacheSize();
+    uint64 address       = chunk.start;
+    uint64 lastOffset    = chunk.start;
+    uint32 lineIndex     = 0;
+    auto label           = chunk.firstLabel;
+
+    uint32 continuousAddInstructions = 0;
+
+    chunk.offsets.push_back({ chunk.start, 0 });
+    while (address < chunk.end && !stop && !chunk.lastChunk) {
+        // the last instruction of the chunk may end after chunk.end, so the piece is not limited to the chunk
+        const auto buffer = view.Get(zoneStart + address, static_cast<uint32>(std::min<uint64>(pieceSize, zoneSize - address)), false);
+        if (!buffer.IsValid() || buffer.GetLength() == 0) {
+            chunk.lastChunk = true;
+            break;
+        }
+        const uint8* data     = buffer.GetData();
+        size_t size           = buffer.GetLength();
+        const uint64 pieceEnd = address + size;
+        // the instructions that start close to the end of the piece are decoded from the next one (unless the zone ends here)
+        uint64 decodeEnd = pieceEnd;
+        if (pieceEnd < zoneSize && size > MAX_INSTRUCTION_SIZE)
+            decodeEnd = pieceEnd - MAX_INSTRUCTION_SIZE;
+
+        while (address < chunk.end && address < decodeEnd) {
+            if (!decoder.Decode(data, size, address)) {
+                chunk.lastChunk = true;
+                break;
+            }
+            lineIndex++;
+            for (const auto labelsEnd = std::min<uint64>(address, chunk.end); label < labels.size() && labels[label] < labelsEnd; label++)
+                chunk.labelLines.push_back(lineIndex - 1);
+            if (address - lastOffset >= DISSASM_INSTRUCTION_OFFSET_MARGIN && address < chunk.end) {
+                lastOffset = address;
+                chunk.offsets.push_back({ address, lineIndex });
+            }
+
+            // zero padding (00 00 -> add byte ptr [eax], al)
+            if (insn->size == 2 && insn->bytes[0] == 0 && insn->bytes[1] == 0) {
+                if (++continuousAddInstructions == DISSASM_ZERO_PADDING_STOP) {
+                    lineIndex -= continuousAddInstructions;
+                    chunk.lastChunk = true;
+                    break;
+                }
+            } else
+                continuousAddInstructions = 0;
+        }
+    }
+
+    if (chunk.lastChunk) {
+        // the lines of the padding are not part of the listing
+        while (!chunk.labelLines.empty() && chunk.labelLines.back() >= lineIndex)
+            chunk.labelLines.pop_back();
+        while (chunk.offsets.size() > 1 && chunk.offsets.back().line > lineIndex)
+            chunk.offsets.pop_back();
+    }
+    chunk.linesCount = lineIndex;
+}
+
+const ParallelDisassembly::Chunk* ParallelDisassembly::FetchNext(bool wait)
+{
+    if (finished)
+        return nullptr;
+
+    auto& chunk = chunks[fetchedChunks];
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        if (wait)
+            chunkCompleted.wait(guard, [this, &chunk]() { return chunk.completed || running == 0; });
+        if (!chunk.completed) {
+            finished = running == 0; // canceled or the workers could not be initialized
+            return nullptr;
+        }
+    }
+
+    fetchedChunks++;
+    if (chunk.lastChunk || fetchedChunks == chunks.size()) {
+        stop     = true; // the chunks after the end of the listing are not needed
+        finished = true;
+    }
+    return &chunk;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "DissasmViewer.hpp"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+namespace GView::View::DissasmViewer
+{
+class ControlFlowGraph;
+
+// Linear disassembly of a big x86/x64 code zone on a pool of workers (each one with its own capstone decoder and its own view
+// of the DataCache). The zone is split in chunks that start at recovered function entries (so every chunk starts with a known
+// instruction) and every chunk gets its own line table. The UI thread fetches the chunks in order, so the first part of the
+// listing is available while the rest is still decoded.
+class ParallelDisassembly
+{
+  public:
+    static constexpr uint64 MIN_ZONE_SIZE    = 0x200000; // 2 MB -> smaller zones are decoded on the UI thread
+    static constexpr uint64 FIRST_CHUNK_SIZE = 0x10000;  // small first chunk -> the first screen is available quickly
+    static constexpr uint64 MIN_CHUNK_SIZE   = 0x80000;
+
+    struct Chunk {
+        uint64 start; // relative to the zone
+        uint64 end;
+        std::vector<AsmOffsetLine> offsets; // offsets relative to the zone, lines relative to the chunk
+        std::vector<uint32> labelLines;     // line of the instruction that contains every label of the chunk
+        uint32 firstLabel;                  // labels in [start, end)
+        uint32 linesCount;
+        bool lastChunk; // zero padding or bytes that can not be decoded -> the listing ends with this chunk
+        bool completed;
+    };
+
+  private:
+    GView::Utils::DataCache* cache;
+    uint64 zoneStart, zoneSize;
+    cs_mode mode;
+    std::vector<uint64> labels; // sorted, relative to the zone
+    std::vector<Chunk> chunks;
+    std::vector<std::thread> workers;
+    std::mutex lock;
+    std::condition_variable chunkCompleted;
+    std::atomic<uint32> nextChunk;
+    std::atomic<bool> stop;
+    uint32 running; // workers that did not exit yet (protected by lock)
+    uint32 fetchedChunks;
+    bool finished;
+
+    void Run();
+    void Decode(GView::Utils::DataCache& view, DissasmDecoder& decoder, Chunk& chunk);
+
+  public:
+    ParallelDisassembly();
+    ~ParallelDisassembly();
+
+    // the listing starts at firstInstruction (relative to the zone); labels are the zone relative offsets (sorted) whose lines are needed
+    bool Start(
+          GView::Utils::DataCache& cache,
+          const DisassemblyZone& zone,
+          int internalArchitecture,
+          const ControlFlowGraph& controlFlow,
+          uint64 firstInstruction,
+          std::vector<uint64> labels,
+          uint32 threads);
+    void Stop();
+
+    // the next chunk (in order) or nullptr if it is not decoded yet (wait = false) or if the listing has ended
+    const Chunk* FetchNext(bool wait);
+    inline bool IsFinished() const
+    {
+        return finished;
+    }
+    inline uint32 GetProgress() const // percent of fetched chunks
+    {
+        return chunks.empty() ? 100 : static_cast<uint32>(fetchedChunks * 100ULL / chunks.size());
+    }
+};
+} // namespace GView::View::DissasmViewer
@@ -26,6 +26,11 @@ void Settings::AddDisassemblyZone(uint64 zoneStart, uint64 zoneSize, uint64 zone
     INTERNAL_SETTINGS->disassemblyZones[zoneStart] = { zoneStart, zoneSize, zoneDissasmStartPoint, lang };
 }
 
+void Settings::AddCodeEntryPoint(uint64 offset)
+{
+    INTERNAL_SETTINGS->codeEntryPoints.push_back(offset);
+}
+
 void Settings::AddMemoryMapping(uint64 address, std::string_view name, MemoryMappingType mappingType)
 {
 #ifndef DISSASM_DISABLE_API_CALLS
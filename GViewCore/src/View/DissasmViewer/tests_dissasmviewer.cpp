@@ -3,6 +3,8 @@
 #include "x86_x64/DissasmX86.hpp"
 #include "DissasmFunctionUtils.hpp"
 #include <array>
+#include <filesystem>
+#include <fstream>
 
 using namespace GView::View::DissasmViewer;
 
@@ -302,6 +304,7 @@ class DissasmTestInstance
     Instance* instance;
     std::vector<GView::Object> objects;
     std::unique_ptr<DissasmCodeZone> zone;
+    DissasmDecoders decoders;
 
     DissasmTestInstance(const unsigned char* binaryData, size_t binaryDataSize)
     {
@@ -345,6 +348,7 @@ class DissasmTestInstance
         initData.maxLocationMemoryMappingSize = 6;
         initData.visibleRows                  = 53;
         initData.obj                          = obj;
+        initData.decoders                     = &decoders;
 
         const bool initZoneResult = zone->InitZone(initData);
         assert(initZoneResult);
@@ -529,6 +533,48 @@ class DissasmTestInstance
     }
 };
 
+TEST_CASE("DissasmDecoderOperands", "[Dissasm]Functions")
+{
+    DissasmDecoders decoders;
+    auto decoder = decoders.Get(CS_MODE_32);
+    REQUIRE(decoder.IsValid());
+    REQUIRE(decoders.Get(CS_MODE_32)->GetHandle() == decoder->GetHandle()); // the same decoder is reused
+
+    // call 0x20 ; call dword ptr [0x402000] ; call eax ; push ebp ; mov ebp, esp ; jmp 0x0
+    const uint8 code[] = { 0xE8, 0x1B, 0x00, 0x00, 0x00, 0xFF, 0x15, 0x00, 0x20, 0x40, 0x00, 0xFF, 0xD0, 0x55, 0x89, 0xE5, 0xEB, 0xEE };
+    const uint8* data  = code;
+    size_t size        = sizeof(code);
+    uint64 address     = 0;
+    const auto insn    = decoder->GetInstruction();
+    uint64 value       = 0;
+
+    REQUIRE(decoder->Decode(data, size, address));
+    REQUIRE(ExtractInsnBranchTarget(insn, value));
+    REQUIRE(value == 0x20);
+
+    REQUIRE(decoder->Decode(data, size, address));
+    REQUIRE(!ExtractInsnBranchTarget(insn, value));
+    REQUIRE(ExtractInsnOperandValue(insn, value, 8));
+    REQUIRE(value == 0x402000);
+    REQUIRE(ExtractInsnOperandValue(insn, value, 4));
+    REQUIRE(value == 0x2000);
+    REQUIRE(!ExtractInsnOperandValue(insn, value, 0)); // no memory mappings
+
+    REQUIRE(decoder->Decode(data, size, address));
+    REQUIRE(!ExtractInsnOperandValue(insn, value, 8));
+
+    REQUIRE(decoder->Decode(data, size, address));
+    REQUIRE(IsInsnRegisterOperand(insn, 0, X86_REG_EBP));
+
+    REQUIRE(decoder->Decode(data, size, address));
+    REQUIRE(IsInsnRegisterOperand(insn, 0, X86_REG_EBP));
+    REQUIRE(IsInsnRegisterOperand(insn, 1, X86_REG_ESP));
+
+    REQUIRE(decoder->Decode(data, size, address));
+    REQUIRE(ExtractInsnBranchTarget(insn, value));
+    REQUIRE(value == 0);
+}
+
 TEST_CASE("DissasmFunctions", "[Dissasm]Functions")
 {
     uint64 value = 0;
@@ -565,6 +611,151 @@ TEST_CASE("DissasmFunctions", "[Dissasm]Functions")
     REQUIRE(!CheckExtractInsnHexValue("mov [0x123], eax", value, 5));
 }
 
+TEST_CASE("ControlFlowGraph", "[Dissasm]Functions")
+{
+    DissasmDecoders decoders;
+    auto decoder = decoders.Get(CS_MODE_32);
+    REQUIRE(decoder.IsValid());
+
+    // 0x00: push ebp ; call 0x10 ; test eax, eax ; je 0xD
+    // 0x0A: inc eax ; jmp 0xE
+    // 0x0D: dec eax
+    // 0x0E: pop ebp ; ret
+    // 0x10: xor eax, eax ; ret      (called)
+    // 0x13: int3                    (not reached)
+    // 0x14: mov eax, 1 ; ret        (extra entry point)
+    const uint8 code[] = { 0x55, 0xE8, 0x0A, 0x00, 0x00, 0x00, 0x85, 0xC0, 0x74, 0x03, 0x40, 0xEB, 0x01, 0x48, 0x5D, 0xC3,
+                           0x31, 0xC0, 0xC3, 0xCC, 0xB8, 0x01, 0x00, 0x00, 0x00, 0xC3 };
+
+    ControlFlowGraph graph;
+    REQUIRE(graph.Build(*decoder, BufferView(code, sizeof(code)), { 0, 0x14 }));
+
+    const std::vector<std::pair<uint64, uint64>> expectedBlocks = { { 0x0, 0xA }, { 0xA, 0xD }, { 0xD, 0xE }, { 0xE, 0x10 }, { 0x10, 0x13 }, { 0x14, 0x1A } };
+    const auto& blocks = graph.GetBlocks();
+    REQUIRE(blocks.size() == expectedBlocks.size());
+    for (uint32 i = 0; i < blocks.size(); i++) {
+        REQUIRE(blocks[i].start == expectedBlocks[i].first);
+        REQUIRE(blocks[i].end == expectedBlocks[i].second);
+    }
+
+    const auto successors = graph.GetSuccessors(blocks[0]);
+    REQUIRE(std::vector<uint32>(successors.begin(), successors.end()) == std::vector<uint32>{ 2, 1 }); // jump first, then the fall through
+    REQUIRE(graph.GetSuccessors(blocks[1]).size() == 1);
+    REQUIRE(graph.GetSuccessors(blocks[1])[0] == 3);
+    REQUIRE(graph.GetSuccessors(blocks[3]).empty());
+    REQUIRE(graph.GetJumpTargets() == std::vector<uint64>{ 0xD, 0xE });
+
+    const auto& functions = graph.GetFunctions();
+    REQUIRE(functions.size() == 3);
+    REQUIRE(functions[0].entry == 0x0);
+    REQUIRE(functions[0].end == 0x10);
+    REQUIRE(functions[1].entry == 0x10);
+    REQUIRE(functions[1].end == 0x13);
+    REQUIRE(functions[2].entry == 0x14);
+    REQUIRE(functions[2].end == 0x1A);
+
+    REQUIRE(graph.FindFunction(0x0B) == 0);
+    REQUIRE(graph.FindFunction(0x11) == 1);
+    REQUIRE(graph.FindFunction(0x19) == 2);
+    REQUIRE(graph.FindFunction(0x13) == ControlFlowGraph::INVALID_INDEX);
+    REQUIRE(graph.FindBlock(0x0C) == 1);
+    REQUIRE(graph.FindBlock(0x13) == ControlFlowGraph::INVALID_INDEX);
+
+    SECTION("parallel")
+    {
+        // function i: call 2i+1 ; call 2i+2 ; je +1 ; ret ; ret -> only the first function is an entry point
+        constexpr uint32 functionsCount = 0x1000;
+        constexpr uint32 functionSize   = 14;
+        std::vector<uint8> treeCode(functionsCount * functionSize);
+        for (uint32 i = 0; i < functionsCount; i++) {
+            auto data = treeCode.data() + i * functionSize;
+            for (uint32 call = 0; call < 2; call++) {
+                const uint32 callee = std::min<uint32>(i * 2 + 1 + call, functionsCount - 1);
+                const auto relative = static_cast<int32>(callee * functionSize) - static_cast<int32>(i * functionSize + call * 5 + 5);
+                data[call * 5] = 0xE8;
+                memcpy(data + call * 5 + 1, &relative, sizeof(relative));
+            }
+            const uint8 end[] = { 0x74, 0x01, 0xC3, 0xC3 };
+            memcpy(data + 10, end, sizeof(end));
+        }
+
+        ControlFlowGraph sequentialGraph, parallelGraph;
+        REQUIRE(sequentialGraph.Build(*decoder, BufferView(treeCode.data(), treeCode.size()), { 0 }));
+        REQUIRE(parallelGraph.Build(*decoder, BufferView(treeCode.data(), treeCode.size()), { 0 }, 4));
+        REQUIRE(sequentialGraph.GetFunctions().size() == functionsCount);
+        REQUIRE(parallelGraph.GetJumpTargets() == sequentialGraph.GetJumpTargets());
+        REQUIRE(parallelGraph.GetFunctions().size() == sequentialGraph.GetFunctions().size());
+        for (uint32 i = 0; i < functionsCount; i++) {
+            REQUIRE(parallelGraph.GetFunctions()[i].entry == sequentialGraph.GetFunctions()[i].entry);
+            REQUIRE(parallelGraph.GetFunctions()[i].end == sequentialGraph.GetFunctions()[i].end);
+        }
+        const auto& sequentialBlocks = sequentialGraph.GetBlocks();
+        const auto& parallelBlocks   = parallelGraph.GetBlocks();
+        REQUIRE(parallelBlocks.size() == sequentialBlocks.size());
+        for (uint32 i = 0; i < parallelBlocks.size(); i++) {
+            REQUIRE(parallelBlocks[i].start == sequentialBlocks[i].start);
+            REQUIRE(parallelBlocks[i].end == sequentialBlocks[i].end);
+            REQUIRE(parallelBlocks[i].function == sequentialBlocks[i].function);
+            REQUIRE(parallelBlocks[i].successorsCount == sequentialBlocks[i].successorsCount);
+        }
+    }
+}
+
+TEST_CASE("ParallelDisassembly", "[Dissasm]Functions")
+{
+    // push ebp ; xor eax, eax ; pop ebp ; ret -> 4 lines for every function
+    const uint8 function[]          = { 0x55, 0x31, 0xC0, 0x5D, 0xC3 };
+    constexpr uint32 functionsCount = static_cast<uint32>(ParallelDisassembly::MIN_ZONE_SIZE / sizeof(function)) + 1;
+
+    std::vector<uint8> code;
+    std::vector<uint64> entryPoints;
+    code.reserve(functionsCount * sizeof(function));
+    for (uint32 i = 0; i < functionsCount; i++) {
+        entryPoints.push_back(code.size());
+        code.insert(code.end(), std::begin(function), std::end(function));
+    }
+
+    DissasmDecoders decoders;
+    auto decoder = decoders.Get(CS_MODE_32);
+    REQUIRE(decoder.IsValid());
+    ControlFlowGraph graph;
+    REQUIRE(graph.Build(*decoder, BufferView(code.data(), code.size()), entryPoints));
+    REQUIRE(graph.GetFunctions().size() == functionsCount);
+
+    auto memoryFile = std::make_unique<OS::MemoryFile>();
+    REQUIRE(memoryFile->Create(code.data(), code.size()));
+    GView::Utils::DataCache cache;
+    REQUIRE(cache.Init(std::move(memoryFile), 0x10000)); // smaller than the zone -> the chunks are read in pieces
+
+    DisassemblyZone zone{};
+    zone.startingZonePoint = 0;
+    zone.size              = code.size();
+    zone.language          = DisassemblyLanguage::x86;
+
+    // a function entry, an offset inside of "xor eax, eax" and the last function
+    const std::vector<uint64> labels        = { entryPoints[1], entryPoints[functionsCount / 2] + 2, entryPoints.back() };
+    const std::vector<uint32> expectedLines = { 4, (functionsCount / 2) * 4 + 1, (functionsCount - 1) * 4 };
+
+    ParallelDisassembly disassembly;
+    REQUIRE(disassembly.Start(cache, zone, CS_MODE_32, graph, 0, labels, 4));
+
+    uint32 lines = 0, labelIndex = 0;
+    uint64 chunkStart = 0;
+    while (const auto chunk = disassembly.FetchNext(true)) {
+        REQUIRE(chunk->start == chunkStart);
+        REQUIRE(chunk->offsets[0].offset == chunk->start);
+        REQUIRE(chunk->linesCount == (chunk->end - chunk->start) / sizeof(function) * 4);
+        for (const auto line : chunk->labelLines)
+            REQUIRE(lines + line == expectedLines[labelIndex++]);
+        lines += chunk->linesCount;
+        chunkStart = chunk->end;
+    }
+    REQUIRE(disassembly.IsFinished());
+    REQUIRE(chunkStart == code.size());
+    REQUIRE(lines == functionsCount * 4);
+    REQUIRE(labelIndex == labels.size());
+}
+
 TEST_CASE("AddAndCollapseCollapsibleZones", "[Dissasm]CollapsibleZones")
 {
     DissasmTestInstance dissasmInstance(exampleTest1BinaryCode, exampleTest1BinaryCodeSize);
@@ -906,4 +1097,145 @@ TEST_CASE("ValidatingComments", "[Dissasm]Comments")
         REQUIRE(dissasmInstance.RemoveComment(5));
         REQUIRE(!dissasmInstance.HasComment(5));
     }
-}
\ No newline at end of file
+}
+static bool SameInternalTypes(const DissasmCodeInternalType& first, const DissasmCodeInternalType& second)
+{
+    if (first.name != second.name || first.indexZoneStart != second.indexZoneStart || first.indexZoneEnd != second.indexZoneEnd ||
+        first.workingIndexZoneStart != second.workingIndexZoneStart || first.workingIndexZoneEnd != second.workingIndexZoneEnd ||
+        first.beforeTextLines != second.beforeTextLines || first.beforeAsmLines != second.beforeAsmLines || first.isCollapsed != second.isCollapsed)
+        return false;
+    if (first.annotations.mappings != second.annotations.mappings ||
+        first.annotations.initial_name_to_current_name != second.annotations.initial_name_to_current_name ||
+        first.annotations.current_name_to_initial_name != second.annotations.current_name_to_initial_name ||
+        first.commentsData.comments != second.commentsData.comments)
+        return false;
+    if (first.internalTypes.size() != second.internalTypes.size())
+        return false;
+    for (size_t i = 0; i < first.internalTypes.size(); i++) {
+        if (!SameInternalTypes(first.internalTypes[i], second.internalTypes[i]))
+            return false;
+    }
+    return true;
+}
+
+TEST_CASE("DissasmCacheFile", "[Dissasm]Cache")
+{
+    DissasmTestInstance dissasmInstance(exampleTest1BinaryCode, exampleTest1BinaryCodeSize);
+    auto& zone        = *dissasmInstance.zone;
+    auto& annotations = zone.dissasmType.annotations;
+    REQUIRE(!annotations.mappings.empty());
+    const auto firstAnnotation = *annotations.mappings.begin();
+    REQUIRE(annotations.add_name_change(firstAnnotation.second.first, "renamed", firstAnnotation.first));
+    REQUIRE(dissasmInstance.AddOrUpdateComment(10, "c10"));
+    REQUIRE(dissasmInstance.AddOrUpdateComment(20, "c20"));
+    REQUIRE(dissasmInstance.AddCollpasibleZone(5, 12));
+    REQUIRE(dissasmInstance.CheckCollapseOrExtendZone(10, DissasmCodeZone::CollapseExpandType::Collapse));
+    zone.extendedSize = zone.dissasmType.indexZoneEnd - 1;
+
+    const DissasmCacheContentHash contentHash = { 0x10, 0x20, 0x30, 0x40 };
+    const auto path                           = std::filesystem::temp_directory_path() / "gview_tests.dissasm.cache";
+    DissasmCacheWriter writer;
+    REQUIRE(zone.SaveToCache(writer));
+    REQUIRE(writer.Save(path, contentHash));
+
+    DissasmCache cache   = {};
+    cache.hasContentHash = true;
+    cache.contentHash    = contentHash;
+    REQUIRE(cache.LoadCacheFile(path));
+
+    DissasmCodeZone loadedZone;
+    loadedZone.zoneDetails = zone.zoneDetails;
+    uint32 totalLines      = 0;
+    REQUIRE(loadedZone.LoadFromCache(cache, totalLines));
+    REQUIRE(totalLines + 1 == zone.extendedSize);
+    REQUIRE(loadedZone.cachedCodeOffsets.size() == zone.cachedCodeOffsets.size());
+    for (size_t i = 0; i < zone.cachedCodeOffsets.size(); i++) {
+        REQUIRE(loadedZone.cachedCodeOffsets[i].offset == zone.cachedCodeOffsets[i].offset);
+        REQUIRE(loadedZone.cachedCodeOffsets[i].line == zone.cachedCodeOffsets[i].line);
+    }
+    REQUIRE(SameInternalTypes(loadedZone.dissasmType, zone.dissasmType));
+    REQUIRE(loadedZone.dissasmType.annotations.get_name_change(firstAnnotation.second.first) == "renamed");
+
+    SECTION("other zone")
+    {
+        DissasmCodeZone otherZone;
+        otherZone.zoneDetails      = zone.zoneDetails;
+        otherZone.zoneDetails.size = zone.zoneDetails.size - 1;
+        REQUIRE(!otherZone.LoadFromCache(cache, totalLines));
+    }
+
+    SECTION("listing before the entry point")
+    {
+        // the listing starts before the entry point, while a new zone only knows its entry point (as set by the instance)
+        REQUIRE(zone.cachedCodeOffsets[0].offset < zone.zoneDetails.entryPoint);
+        DissasmCodeZone initZone;
+        initZone.zoneDetails       = zone.zoneDetails;
+        initZone.cachedCodeOffsets = { { zone.zoneDetails.entryPoint, 0 } };
+
+        DissasmCodeZoneInitData initData = {};
+        initData.obj                     = &dissasmInstance.objects[0];
+        initData.decoders                = &dissasmInstance.decoders;
+        initData.visibleRows             = 53;
+        initData.cache                   = &cache;
+        REQUIRE(initZone.InitZone(initData));
+        REQUIRE(initData.adjustedZoneSize == static_cast<int32>(zone.extendedSize));
+        REQUIRE(initZone.cachedCodeOffsets[0].offset == zone.cachedCodeOffsets[0].offset);
+        REQUIRE(SameInternalTypes(initZone.dissasmType, zone.dissasmType)); // with the comments -> not analysed again
+    }
+
+    SECTION("stale or corrupted file")
+    {
+        DissasmCache staleCache   = {};
+        staleCache.hasContentHash = true;
+        staleCache.contentHash    = { 0x11 };
+        REQUIRE(!staleCache.LoadCacheFile(path));
+
+        cache.ClearCache();
+        {
+            std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekg(-1, std::ios::end);
+            const auto lastByte = static_cast<char>(file.get() ^ 0xFF);
+            file.seekp(-1, std::ios::end);
+            file.put(lastByte);
+        }
+        REQUIRE(!cache.LoadCacheFile(path));
+    }
+
+    cache.ClearCache();
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("AnnotationLinesIndex", "[Dissasm]Annotations")
+{
+    AnnotationContainer annotations;
+    std::vector<uint32> lines;
+    auto countLinesUntil = [&lines](uint32 line) { return static_cast<uint32>(std::upper_bound(lines.begin(), lines.end(), line) - lines.begin()); };
+    auto addLine         = [&annotations, &lines](uint32 line) {
+        annotations.insert({ line, { "label", line } });
+        if (!std::binary_search(lines.begin(), lines.end(), line))
+            lines.insert(std::upper_bound(lines.begin(), lines.end(), line), line);
+    };
+
+    REQUIRE(annotations.count_lines_until(100) == 0);
+    // lines added after the index was built: at the end (the index grows), before its first line (the index is rebuilt) & duplicates
+    for (uint32 line : { 500u, 501u, 563u, 564u, 640u, 10000u, 70000u, 130u, 501u, 0u, 63u, 64u, 1000000u })
+        addLine(line);
+    for (uint32 line = 0; line < 1100000; line += 7)
+        REQUIRE(annotations.count_lines_until(line) == countLinesUntil(line));
+    for (uint32 line : lines) {
+        REQUIRE(annotations.count_lines_until(line) == countLinesUntil(line));
+        if (line > 0)
+            REQUIRE(annotations.count_lines_until(line - 1) == countLinesUntil(line - 1));
+    }
+
+    AnnotationContainer other;
+    other.insert({ 20, { "other", 20 } });
+    other.insert({ 2000, { "other", 2000 } });
+    annotations.populate_annotations_from_other_storage(other);
+    lines.insert(std::upper_bound(lines.begin(), lines.end(), 20u), 20u);
+    lines.insert(std::upper_bound(lines.begin(), lines.end(), 2000u), 2000u);
+    annotations[3000] = { "new", 3000 };
+    lines.insert(std::upper_bound(lines.begin(), lines.end(), 3000u), 3000u);
+    for (uint32 line = 0; line < 5000; line++)
+        REQUIRE(annotations.count_lines_until(line) == countLinesUntil(line));
+}
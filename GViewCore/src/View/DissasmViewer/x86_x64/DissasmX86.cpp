@@ -24,9 +24,6 @@ constexpr uint32 DISSASM_ASSISTANT_MAX_BYTE_TO_SEND           = 640;
 using namespace GView::View::DissasmViewer;
 using namespace AppCUI::Input;
 
-// TODO: performance improvements
-//  consider using the same cs_insn and cs handle for all instructions that are on the same thread instead of creating new ones
-
 // Dissasm menu configuration
 constexpr uint32 addressTotalLength                 = 16;
 constexpr uint32 opCodesGroupsShown                 = 8;
@@ -269,31 +266,22 @@ inline cs_insn* GetCurrentInstructionByLine(
         return nullptr;
     }
 
-    // TODO: keep the handle open and insn open until the program ends
-    csh handle;
-    const auto resCode = cs_open(CS_ARCH_X86, static_cast<cs_mode>(zone->internalArchitecture), &handle);
-    if (resCode != CS_ERR_OK) {
+    if (!zone->decoder.IsValid()) {
         if (dli)
-            dli->WriteErrorToScreen(cs_strerror(resCode));
-        cs_close(&handle);
+            dli->WriteErrorToScreen("ERROR: the zone has no decoder!");
         return nullptr;
     }
 
-    cs_insn* insn = cs_malloc(handle);
-
     while (lineDifferences > 0) {
-        if (!cs_disasm_iter(handle, &zone->asmData, (size_t*) &zone->asmSize, &zone->asmAddress, insn)) {
+        if (!zone->decoder->Decode(zone->asmData, *(size_t*) &zone->asmSize, zone->asmAddress)) {
             if (dli)
                 dli->WriteErrorToScreen("Failed to dissasm!");
-            cs_free(insn, 1);
-            cs_close(&handle);
             return nullptr;
         }
         lineDifferences--;
     }
 
-    cs_close(&handle);
-    return insn;
+    return zone->decoder->GetInstruction();
 }
 
 inline const MemoryMappingEntry* TryExtractMemoryMapping(const Pointer<SettingsData>& settings, uint64 initialLocation, const uint64 possibleLocationAdjustment)
@@ -374,18 +362,9 @@ std::optional<uint32> DissasmGetCurrentAsmLineAndPrepareCodeZone(DissasmCodeZone
     }
 
     DissasmCodeInternalType& currentType = zone->types.back();
-    // TODO: do a faster search using a binary search using the annotations and start from there
-    // TODO: maybe use some caching here?
+    // a jump -> the lines are counted again with the annotation lines index
     if (reAdapt || levelNow < levelToReach && levelNow + 1 != levelToReach || levelNow > levelToReach && levelNow - 1 != levelToReach) {
-        currentType.textLinesPassed = 0;
-        currentType.asmLinesPassed  = 0;
-        for (uint32 i = currentType.indexZoneStart; i <= levelToReach; i++) {
-            if (currentType.annotations.contains(i)) {
-                currentType.textLinesPassed++;
-                continue;
-            }
-            currentType.asmLinesPassed++;
-        }
+        currentType.CountLinesPassed(levelToReach);
     } else {
         if (currentType.annotations.contains(levelToReach))
             currentType.textLinesPassed++;
@@ -452,7 +431,6 @@ bool DissasmAsmPreCacheLine::TryGetDataFromInsn(DissasmInsnExtractLineParams& pa
         op_str      = strdup(params.zoneName->c_str());
         op_str_size = static_cast<uint32>(params.zoneName->size());
         strncpy(mnemonic, "collapsed", std::min<uint32>(sizeof(mnemonic), 9));
-        cs_free(insn, 1);
         return true;
     }
 
@@ -475,14 +453,13 @@ bool DissasmAsmPreCacheLine::TryGetDataFromInsn(DissasmInsnExtractLineParams& pa
             op_str      = strdup(insn->op_str);
             op_str_size = static_cast<uint32>(strlen(op_str));
             // params.zone->asmPreCacheData.cachedAsmLines.push_back(std::move(asmCacheLine));
-            cs_free(insn, 1);
             return true;
         }
     }
 
     // TODO: improve efficiency by filtering instructions
     uint64 hexVal = 0;
-    if (CheckExtractInsnHexValue(insn->op_str, hexVal, params.settings->maxLocationMemoryMappingSize)) {
+    if (ExtractInsnOperandValue(insn, hexVal, params.settings->maxLocationMemoryMappingSize)) {
         hexValue = hexVal;
         if (hexVal == 0 && flags != DissasmAsmPreCacheLine::InstructionFlag::PushFlag)
             hexValue = params.zone->cachedCodeOffsets[0].offset;
@@ -559,7 +536,6 @@ bool DissasmAsmPreCacheLine::TryGetDataFromInsn(DissasmInsnExtractLineParams& pa
             op_str      = strdup(insn->op_str);
             op_str_size = static_cast<uint32>(strlen(op_str));
             // params.zone->asmPreCacheData.cachedAsmLines.push_back(std::move(asmCacheLine));
-            cs_free(insn, 1);
             return true;
         }
 
@@ -586,7 +562,6 @@ bool DissasmAsmPreCacheLine::TryGetDataFromInsn(DissasmInsnExtractLineParams& pa
         op_str_size = (uint32) strlen(op_str);
     }
     // params.zone->asmPreCacheData.cachedAsmLines.push_back(std::move(asmCacheLine));
-    cs_free(insn, 1);
     return true;
 }
 
@@ -719,8 +694,14 @@ bool Instance::DrawDissasmX86AndX64CodeZone(DrawLineInfo& dli, DissasmCodeZone*
     if (dli.textLineToDraw == 0) {
         constexpr std::string_view zoneName = "Dissasm zone";
         chars.Add(zoneName.data(), ColorMan.Colors.StructureColor);
+        if (zone->parallelDisassembly) {
+            LocalString<32> progress;
+            progress.SetFormat(" (decoding %u%%)", zone->parallelDisassembly->GetProgress());
+            chars.Add(progress, ColorMan.Colors.AsmComment);
+        }
+        const uint32 titleLength = chars.Len() - Layout.startingTextLineOffset;
 
-        HighlightSelectionAndDrawCursorText(dli, static_cast<uint32>(zoneName.size()), static_cast<uint32>(zoneName.size()) + Layout.startingTextLineOffset);
+        HighlightSelectionAndDrawCursorText(dli, titleLength, titleLength + Layout.startingTextLineOffset);
 
         dli.renderer.WriteSingleLineCharacterBuffer(0, dli.screenLineToDraw + 1u, chars, false);
 
@@ -728,22 +709,24 @@ bool Instance::DrawDissasmX86AndX64CodeZone(DrawLineInfo& dli, DissasmCodeZone*
 
         if (!zone->isInit) {
             {
+                LoadCacheData(); // the cache is looked up when the first code zone is initialized
                 DissasmCodeZoneInitData initData{};
                 initData.enableDeepScanDissasmOnStart = config.EnableDeepScanDissasmOnStart;
+                initData.enableControlFlowAnalysis    = config.EnableControlFlowAnalysis;
+                initData.codeEntryPoints              = &settings->codeEntryPoints;
                 initData.obj                          = obj;
                 initData.dli                          = &dli;
+                initData.decoders                     = &decoders;
                 initData.maxLocationMemoryMappingSize = settings->maxLocationMemoryMappingSize;
                 initData.visibleRows                  = Layout.visibleRows;
+                initData.cache                        = &cacheData;
 
                 if (!zone->InitZone(initData))
                     return false;
                 if (initData.hasAdjustedSize)
                     AdjustZoneExtendedSize(zone, initData.adjustedZoneSize);
-                if (!zone->TryLoadDataFromCache(cacheData)) {
-                    // TODO: will enable errors in the next version
-                    // dli.WriteErrorToScreen("ERROR: failed to load data from cache!");
-                    // return false;
-                }
+                // a zone decoded in the background adds them when its listing is complete (FetchParallelDisassembly)
+                zone->AddControlFlowCollapsibleZones(obj);
             }
         }
 
@@ -802,17 +785,23 @@ bool Instance::DrawDissasmX86AndX64CodeZone(DrawLineInfo& dli, DissasmCodeZone*
 
     if (!zone->isInit) {
         {
+            LoadCacheData(); // the cache is looked up when the first code zone is initialized
             DissasmCodeZoneInitData initData{};
             initData.enableDeepScanDissasmOnStart = config.EnableDeepScanDissasmOnStart;
+            initData.enableControlFlowAnalysis    = config.EnableControlFlowAnalysis;
+            initData.codeEntryPoints              = &settings->codeEntryPoints;
             initData.obj                          = obj;
             initData.dli                          = &dli;
+            initData.decoders                     = &decoders;
             initData.maxLocationMemoryMappingSize = settings->maxLocationMemoryMappingSize;
             initData.visibleRows                  = Layout.visibleRows;
+            initData.cache                        = &cacheData;
 
             if (!zone->InitZone(initData))
                 return false;
             if (initData.hasAdjustedSize)
                 AdjustZoneExtendedSize(zone, initData.adjustedZoneSize);
+            zone->AddControlFlowCollapsibleZones(obj);
         }
     }
 
@@ -912,14 +901,13 @@ void Instance::CommandExportAsmFile()
 
             f.Write("ASMZoneZone\n", sizeof("ASMZoneZone\n") - 1);
 
-            csh handle;
-            const auto resCode = cs_open(CS_ARCH_X86, CS_MODE_64, &handle);
-            if (resCode != CS_ERR_OK) {
-                f.Write(cs_strerror(resCode));
+            auto decoder = decoders.Get(CS_MODE_64);
+            if (!decoder.IsValid()) {
+                f.Write("Failed to open the dissasembler!");
                 f.Close();
+                continue;
             }
-
-            cs_insn* insn = cs_malloc(handle);
+            const cs_insn* insn = decoder->GetInstruction();
 
             const auto dissamZone      = static_cast<DissasmCodeZone*>(zone.get());
             const uint64 staringOffset = dissamZone->cachedCodeOffsets[0].offset;
@@ -937,15 +925,13 @@ void Instance::CommandExportAsmFile()
             auto data = dataBuffer.GetData();
 
             while (address < endAddress) {
-                if (!cs_disasm_iter(handle, &data, &size, &address, insn))
+                if (!decoder->Decode(data, size, address))
                     break;
 
                 string.SetFormat("0x%" PRIx64 ":     %-10s %s\n", insn->address + staringOffset, insn->mnemonic, insn->op_str);
                 f.Write(string.GetText(), string.Len());
             }
 
-            cs_free(insn, 1);
-            cs_close(&handle);
             f.Close();
             zoneIndex++;
 
@@ -981,33 +967,14 @@ void Instance::DissasmZoneProcessSpaceKey(DissasmCodeZone* zone, uint32 line, ui
             Dialogs::MessageBox::ShowNotification("Warning", "There was an error reaching that line!");
             return;
         }
-        if (insn->mnemonic[0] == 'j' || insn->mnemonic[0] == 'c' && *(uint32*) insn->mnemonic == callOP) {
-            if (insn->op_str[0] == '0' && insn->op_str[1] == 'x') {
-                char* val = &insn->op_str[2];
-
-                while (*val && *val != ',' && *val != ' ') {
-                    if (*val >= '0' && *val <= '9')
-                        computedValue = computedValue * 16 + (*val - '0');
-                    else if (*val >= 'a' && *val <= 'f')
-                        computedValue = computedValue * 16 + (*val - 'a' + 10);
-                    else {
-                        Dialogs::MessageBox::ShowNotification("Warning", "Invalid jump value!");
-                        computedValue = 0;
-                        break;
-                    }
-                    val++;
-                }
-            } else if (insn->op_str[0] >= '0' && insn->op_str[0] <= '9' && insn->op_str[1] == '\0') {
-                computedValue = zone->cachedCodeOffsets[0].offset + (insn->op_str[0] - '0');
-            } else {
-                cs_free(insn, 1);
-                return;
-            }
-            cs_free(insn, 1);
-        } else {
-            cs_free(insn, 1);
+        // only the jumps and calls with a constant target (not the ones through registers or memory)
+        if (insn->mnemonic[0] != 'j' && *(uint32*) insn->mnemonic != callOP)
             return;
-        }
+        if (!ExtractInsnBranchTarget(insn, computedValue))
+            return;
+        // same value as the one shown by the offset_/sub_ labels
+        if (computedValue < zone->cachedCodeOffsets[0].offset)
+            computedValue += zone->cachedCodeOffsets[0].offset;
     } else
         computedValue = *offsetToReach;
 
@@ -1025,7 +992,6 @@ void Instance::DissasmZoneProcessSpaceKey(DissasmCodeZone* zone, uint32 line, ui
         Dialogs::MessageBox::ShowNotification("Warning", "There was an error reaching that line!");
         return;
     }
-    cs_free(insn, 1);
 
     // diffLines++; // increased because of the menu bar
 
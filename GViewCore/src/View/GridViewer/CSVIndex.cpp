@@ -0,0 +1,281 @@
+#include "CSVIndex.hpp"
+#include "CpuFeatures.hpp"
+
+#include <bit>
+#include <cstring>
+
+#if defined(GVIEW_X86_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#    define GVIEW_CSV_SSE2
+#endif
+
+namespace GView::View::GridViewer
+{
+constexpr uint32 MAX_ROW_SIZE = 0xFFFFFFFF; // cell ends are stored relative to the start of the row on 32 bits
+
+// number of bytes from [p, p + size) before the first separator, \n or \r
+static size_t SkipField_Scalar(const uint8* p, size_t size, uint8 separator)
+{
+    for (size_t i = 0; i < size; i++) {
+        if ((p[i] == separator) || (p[i] == '\n') || (p[i] == '\r'))
+            return i;
+    }
+    return size;
+}
+
+#ifdef GVIEW_X86_SIMD
+GVIEW_TARGET("avx2") static size_t SkipField_AVX2(const uint8* p, size_t size, uint8 separator)
+{
+    const auto lf  = _mm256_set1_epi8('\n');
+    const auto cr  = _mm256_set1_epi8('\r');
+    const auto sep = _mm256_set1_epi8(static_cast<char>(separator));
+    size_t i       = 0;
+    for (; i + 64 <= size; i += 64) {
+        const auto a     = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        const auto b     = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 32));
+        const auto stopA = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(a, lf), _mm256_cmpeq_epi8(a, cr)), _mm256_cmpeq_epi8(a, sep));
+        const auto stopB = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(b, lf), _mm256_cmpeq_epi8(b, cr)), _mm256_cmpeq_epi8(b, sep));
+        const auto bits  = static_cast<uint64>(static_cast<uint32>(_mm256_movemask_epi8(stopA))) |
+                          (static_cast<uint64>(static_cast<uint32>(_mm256_movemask_epi8(stopB))) << 32);
+        if (bits)
+            return i + static_cast<size_t>(std::countr_zero(bits));
+    }
+    return i + SkipField_Scalar(p + i, size - i, separator);
+}
+#endif
+
+#ifdef GVIEW_CSV_SSE2
+static size_t SkipField_SSE2(const uint8* p, size_t size, uint8 separator)
+{
+    const auto lf  = _mm_set1_epi8('\n');
+    const auto cr  = _mm_set1_epi8('\r');
+    const auto sep = _mm_set1_epi8(static_cast<char>(separator));
+    size_t i       = 0;
+    for (; i + 32 <= size; i += 32) {
+        const auto a     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        const auto b     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 16));
+        const auto stopA = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(a, lf), _mm_cmpeq_epi8(a, cr)), _mm_cmpeq_epi8(a, sep));
+        const auto stopB = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(b, lf), _mm_cmpeq_epi8(b, cr)), _mm_cmpeq_epi8(b, sep));
+        const auto bits  = static_cast<uint32>(_mm_movemask_epi8(stopA)) | (static_cast<uint32>(_mm_movemask_epi8(stopB)) << 16);
+        if (bits)
+            return i + static_cast<size_t>(std::countr_zero(bits));
+    }
+    return i + SkipField_Scalar(p + i, size - i, separator);
+}
+#endif
+
+static size_t SkipField(const uint8* p, size_t size, uint8 separator)
+{
+#ifdef GVIEW_X86_SIMD
+    if (GView::Utils::CPU::GetFeatures().avx2)
+        return SkipField_AVX2(p, size, separator);
+#endif
+#ifdef GVIEW_CSV_SSE2
+    return SkipField_SSE2(p, size, separator);
+#else
+    return SkipField_Scalar(p, size, separator);
+#endif
+}
+
+//======================================================================[CSVTokenizer]==================
+CSVTokenizer::CSVTokenizer()
+{
+    Reset(',');
+}
+void CSVTokenizer::Reset(char _separator)
+{
+    this->separator  = _separator;
+    this->state      = State::FieldStart;
+    this->rowStarted = false;
+    this->skipLF     = false;
+}
+void CSVTokenizer::Scan(BufferView buffer, uint64 offset, CSVIndex& index)
+{
+    const auto* start = buffer.GetData();
+    const auto* p     = start;
+    const auto* e     = start + buffer.GetLength();
+
+    while (p < e) {
+        switch (state) {
+        case State::Quoted: {
+            // memchr is already vectorised
+            const auto* quote = static_cast<const uint8*>(memchr(p, '"', static_cast<size_t>(e - p)));
+            if (quote == nullptr) {
+                p = e;
+            } else {
+                p     = quote + 1;
+                state = State::QuoteInQuoted;
+            }
+            continue;
+        }
+        case State::QuoteInQuoted:
+            if ((*p) == '"') {
+                // escaped quote
+                p++;
+                state = State::Quoted;
+            } else {
+                // end of the quoted part (whatever follows belongs to the same field)
+                state = State::Unquoted;
+            }
+            continue;
+        case State::Unquoted:
+            p += SkipField(p, static_cast<size_t>(e - p), static_cast<uint8>(separator));
+            if (p >= e)
+                continue;
+            break;
+        case State::FieldStart:
+            break;
+        }
+
+        // a byte outside of a quoted field: separator, line break or the first byte of a field
+        const auto ch  = *p;
+        const auto pos = offset + static_cast<uint64>(p - start);
+        p++;
+        if (skipLF) {
+            skipLF = false;
+            if (ch == '\n')
+                continue;
+        }
+        if ((ch == '\n') || (ch == '\r')) {
+            // empty lines are skipped
+            if (rowStarted)
+                index.AddCell(pos);
+            rowStarted = false;
+            skipLF     = ch == '\r';
+            state      = State::FieldStart;
+            continue;
+        }
+        if (!rowStarted) {
+            index.AddRow(pos);
+            rowStarted = true;
+        }
+        if (ch == static_cast<uint8>(separator)) {
+            index.AddCell(pos);
+            state = State::FieldStart;
+            continue;
+        }
+        state = ((ch == '"') && (state == State::FieldStart)) ? State::Quoted : State::Unquoted;
+    }
+}
+void CSVTokenizer::Finish(uint64 endOffset, CSVIndex& index)
+{
+    if (rowStarted)
+        index.AddCell(endOffset);
+    rowStarted = false;
+    skipLF     = false;
+    state      = State::FieldStart;
+}
+
+//======================================================================[CSVIndex]======================
+CSVIndex::CSVIndex() : columnsCount(0), rowTooLarge(false)
+{
+}
+void CSVIndex::Clear()
+{
+    rowStarts.clear();
+    rowFirstCell.clear();
+    cellEnds.clear();
+    columnsCount = 0;
+    rowTooLarge  = false;
+}
+void CSVIndex::AddRow(uint64 start)
+{
+    rowStarts.push_back(start);
+    rowFirstCell.push_back(cellEnds.size());
+}
+void CSVIndex::AddCell(uint64 end)
+{
+    auto relative = end - rowStarts.back();
+    if (relative > MAX_ROW_SIZE) {
+        rowTooLarge = true;
+        relative    = MAX_ROW_SIZE;
+    }
+    cellEnds.push_back(static_cast<uint32>(relative));
+    columnsCount = std::max<>(columnsCount, static_cast<uint32>(cellEnds.size() - rowFirstCell.back()));
+}
+bool CSVIndex::Build(GView::Utils::DataCache& cache, char separator)
+{
+    Clear();
+
+    const auto size      = cache.GetSize();
+    const auto chunkSize = static_cast<uint64>(cache.GetCacheSize());
+    uint64 offset        = 0;
+
+    // skip the UTF-8 BOM
+    if (size >= 3) {
+        const auto bom = cache.Get(0, 3, true);
+        if ((bom.IsValid()) && (memcmp(bom.GetData(), "\xEF\xBB\xBF", 3) == 0))
+            offset = 3;
+    }
+
+    CSVTokenizer tokenizer;
+    tokenizer.Reset(separator);
+    while (offset < size) {
+        const auto buf = cache.Get(offset, static_cast<uint32>(std::min<>(chunkSize, size - offset)), false);
+        CHECK(buf.IsValid(), false, "Unable to read from %llu offset", offset);
+        tokenizer.Scan(buf, offset, *this);
+        offset += buf.GetLength();
+    }
+    tokenizer.Finish(offset, *this);
+
+    rowStarts.shrink_to_fit();
+    rowFirstCell.shrink_to_fit();
+    cellEnds.shrink_to_fit();
+    CHECK(rowTooLarge == false, false, "Rows bigger than 4GB are not supported");
+    return true;
+}
+uint32 CSVIndex::GetCellsCount(uint64 row) const
+{
+    if (row >= rowStarts.size())
+        return 0;
+    const auto end = row + 1 < rowStarts.size() ? rowFirstCell[row + 1] : cellEnds.size();
+    return static_cast<uint32>(end - rowFirstCell[row]);
+}
+bool CSVIndex::GetCell(uint64 row, uint32 column, uint64& start, uint64& end) const
+{
+    CHECK(column < GetCellsCount(row), false, "");
+    const auto first = rowFirstCell[row];
+    start            = rowStarts[row] + (column == 0 ? 0 : static_cast<uint64>(cellEnds[first + column - 1]) + 1);
+    end              = rowStarts[row] + cellEnds[first + column];
+    return true;
+}
+bool CSVIndex::GetCellText(GView::Utils::DataCache& cache, uint64 row, uint32 column, std::string& text) const
+{
+    uint64 start, end;
+    CHECK(GetCell(row, column, start, end), false, "");
+    text.clear();
+    if (start == end)
+        return true;
+
+    const auto size = static_cast<uint32>(end - start);
+    Buffer copy;
+    BufferView buf;
+    if (size <= cache.GetCacheSize()) {
+        buf = cache.Get(start, size, true);
+    } else {
+        copy = cache.CopyToBuffer(start, size);
+        buf  = copy;
+    }
+    CHECK(buf.IsValid(), false, "Unable to read %u bytes from %llu offset", size, start);
+
+    std::string_view value{ reinterpret_cast<const char*>(buf.GetData()), buf.GetLength() };
+    if ((value.empty()) || (value.front() != '"')) {
+        text = value;
+        return true;
+    }
+    // quoted field (whatever follows the closing quote is kept as it is)
+    text.reserve(value.size());
+    auto quoted = true;
+    for (size_t i = 1; i < value.size(); i++) {
+        if ((quoted) && (value[i] == '"')) {
+            if ((i + 1 < value.size()) && (value[i + 1] == '"'))
+                i++;
+            else {
+                quoted = false;
+                continue;
+            }
+        }
+        text.push_back(value[i]);
+    }
+    return true;
+}
+} // namespace GView::View::GridViewer
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Internal.hpp"
+
+namespace GView::View::GridViewer
+{
+// Rows and cells of a CSV/TSV text.
+// Every row keeps its offset and the index of its first cell; a cell keeps only its end, relative to the start of its row
+// (the next cell starts right after the separator) -> 16 bytes per row + 4 bytes per cell.
+class CSVIndex
+{
+    std::vector<uint64> rowStarts;
+    std::vector<uint64> rowFirstCell;
+    std::vector<uint32> cellEnds;
+    uint32 columnsCount;
+    bool rowTooLarge;
+
+  public:
+    CSVIndex();
+
+    void Clear();
+    // splits the entire object (with the tokenizer below), buffer by buffer
+    bool Build(GView::Utils::DataCache& cache, char separator);
+
+    // used by the tokenizer
+    void AddRow(uint64 start);
+    void AddCell(uint64 end);
+
+    inline uint64 GetRowsCount() const
+    {
+        return rowStarts.size();
+    }
+    // cells of the widest row
+    inline uint32 GetColumnsCount() const
+    {
+        return columnsCount;
+    }
+    uint32 GetCellsCount(uint64 row) const;
+    // [start, end) of a cell (with the quotes, if the field is quoted)
+    bool GetCell(uint64 row, uint32 column, uint64& start, uint64& end) const;
+    // content of a cell without the enclosing quotes and with the escaped quotes ("") replaced
+    bool GetCellText(GView::Utils::DataCache& cache, uint64 row, uint32 column, std::string& text) const;
+};
+
+// Streaming CSV tokenizer (RFC 4180): a field that starts with a quote can contain separators, line breaks and escaped
+// quotes (""); rows end with \n, \r or \r\n and the empty lines are skipped.
+// Outside the quoted fields the buffer is searched (vectorised) for the next separator/line break, inside them for the
+// next quote, so only these bytes are processed one by one.
+class CSVTokenizer
+{
+    enum class State : uint8 {
+        FieldStart,
+        Unquoted,
+        Quoted,
+        QuoteInQuoted, // a quote inside a quoted field: either an escaped quote or the end of the field
+    };
+    State state;
+    char separator;
+    bool rowStarted;
+    bool skipLF; // the last row ended with \r
+
+  public:
+    CSVTokenizer();
+    void Reset(char separator);
+    // buffer is located at 'offset' (the buffers must be consecutive)
+    void Scan(BufferView buffer, uint64 offset, CSVIndex& index);
+    // ends the last row (if the text does not end with a line break)
+    void Finish(uint64 endOffset, CSVIndex& index);
+};
+} // namespace GView::View::GridViewer
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Internal.hpp"
+#include "CSVIndex.hpp"
 #include <array>
 namespace GView
 {
@@ -41,8 +42,7 @@ namespace View
         struct SettingsData
         {
             String name;
-            std::map<uint64, std::pair<uint64, uint64>> lines;
-            std::map<uint64, std::vector<std::pair<uint64, uint64>>> tokens;
+            CSVIndex index;
             char separator[2]{ "," };
             uint64 rows           = 0;
             uint64 cols           = 0;
@@ -218,17 +218,21 @@ void Instance::OnStart()
 
 void Instance::PopulateGrid()
 {
-    const auto& content = settings->tokens;
-    auto it             = content.begin();
-
-    if (settings->firstRowAsHeader) {
-        const auto& header = it->second;
+    const auto& index = settings->index;
+    auto& cache       = obj->GetData();
+    std::string text;
+    uint64 row = 0;
+
+    if (settings->firstRowAsHeader && index.GetRowsCount() > 0) {
+        std::vector<std::string> header(index.GetCellsCount(0));
+        for (uint32 column = 0; column < header.size(); column++) {
+            index.GetCellText(cache, 0, column, header[column]);
+        }
         std::vector<AppCUI::Utils::ConstString> headerCS;
-        for (const auto& [start, end] : header) {
-            const auto token = obj->GetData().Get(start, static_cast<uint32>(end - start), false);
-            headerCS.push_back(token);
+        for (const auto& value : header) {
+            headerCS.push_back(std::string_view{ value });
         }
-        std::advance(it, 1);
+        row = 1;
         grid->UpdateHeaderValues(headerCS);
     } else {
         grid->SetDefaultHeaderValues();
@@ -239,16 +243,14 @@ void Instance::PopulateGrid()
         grid->SetGridDimensions({ static_cast<uint32>(settings->cols), static_cast<uint32>(settings->rows - settings->firstRowAsHeader) });
     }
 
-    while (it != content.end()) {
-        const auto i    = it->first;
-        const auto& row = it->second;
-        for (auto itRow = row.begin(); itRow != row.end(); itRow++) {
-            const auto j     = row.size() - std::abs(std::distance(row.end(), itRow));
-            const auto token = obj->GetData().Get(itRow->first, static_cast<uint32>(itRow->second - itRow->first), false);
-            const ConstString value{ token };
-            grid->UpdateCell(static_cast<uint32>(j), static_cast<uint32>(i - settings->firstRowAsHeader), value);
+    // the cells are read straight from the cache (through the row/cell offsets)
+    for (; row < index.GetRowsCount(); row++) {
+        const auto cellsCount = index.GetCellsCount(row);
+        for (uint32 column = 0; column < cellsCount; column++) {
+            if (index.GetCellText(cache, row, column, text) == false)
+                continue;
+            grid->UpdateCell(column, static_cast<uint32>(row - settings->firstRowAsHeader), ConstString{ std::string_view{ text } });
         }
-        std::advance(it, 1);
     }
 
     grid->Sort();
@@ -256,84 +258,11 @@ void Instance::PopulateGrid()
 
 void GView::View::GridViewer::Instance::ProcessContent()
 {
-    // TODO: this function should be a state machine with using cache as a stream-like structure!
-    // the implementation below is wrong if a "row" contains more bytes than the cache size!
-
-    std::map<uint64, std::pair<uint64, uint64>> lines;
-    std::map<uint64, std::vector<std::pair<uint64, uint64>>> tokens;
-
-    const auto oSize = obj->GetData().GetSize();
-    const auto cSize = static_cast<uint64>(obj->GetData().GetCacheSize());
-
-    auto oSizeProcessed = 0ULL;
-    auto lineStart      = 0ULL;
-    auto currentLine    = 0ULL;
-
-    do {
-        const auto dataSize = oSizeProcessed >= oSize ? 0 : std::min<uint64>(oSize - oSizeProcessed, cSize);
-        const auto buf      = obj->GetData().Get(oSizeProcessed, static_cast<uint32>(dataSize), false);
-        const std::string_view data{ reinterpret_cast<const char*>(buf.GetData()), buf.GetLength() };
-
-        auto nPos       = data.find_first_of('\n', 0);
-        const auto rPos = data.find_first_of('\r', 0);
-
-        const auto oldOSizeProcessed = oSizeProcessed;
-
-        if (nPos < rPos) {
-            if (nPos + 1 < data.size() && data[nPos + 1] == '\r') {
-                oSizeProcessed += nPos + 2;
-            } else {
-                oSizeProcessed += nPos + 1;
-            }
-        } else if (nPos > rPos) {
-            if (rPos + 1 < data.size() && data[rPos + 1] == '\n') {
-                oSizeProcessed += rPos + 2;
-            } else {
-                oSizeProcessed += rPos + 1;
-            }
-        } else if (nPos == rPos && nPos == std::string::npos) {
-            nPos = data.size();
-            oSizeProcessed += nPos + 1;
-        }
-
-        lines.insert({ currentLine, { lineStart + oldOSizeProcessed, nPos + oldOSizeProcessed } });
-        const std::string_view line{ reinterpret_cast<const char*>(buf.GetData() + lineStart), nPos };
-
-        std::vector<uint64> separators;
-        {
-            size_t pos = line.find(settings->separator[0]);
-            while (pos != std::string::npos) {
-                separators.push_back(pos + oldOSizeProcessed);
-                pos = line.find(settings->separator[0], pos + 1);
-            }
-        }
-
-        std::vector<std::pair<uint64, uint64>> lTokens;
-        if (separators.empty()) {
-            lTokens.push_back({ lineStart + oldOSizeProcessed, nPos + oldOSizeProcessed });
-        }
-
-        {
-            auto tStart = oldOSizeProcessed;
-            auto tEnd   = oldOSizeProcessed;
-            for (const auto& i : separators) {
-                tEnd = i;
-                lTokens.push_back({ tStart, tEnd });
-                tStart = tEnd + 1;
-            }
-            lTokens.push_back({ tEnd + 1, oSizeProcessed });
-        }
-
-        tokens.insert({ currentLine, std::move(lTokens) });
-
-        currentLine++;
-
-    } while (oSizeProcessed < oSize);
-
-    settings->rows   = lines.size();
-    settings->cols   = tokens.size() > 0 ? tokens.begin()->second.size() : 0;
-    settings->lines  = std::move(lines);
-    settings->tokens = std::move(tokens);
+    if (settings->index.Build(obj->GetData(), settings->separator[0]) == false) {
+        settings->index.Clear();
+    }
+    settings->rows = settings->index.GetRowsCount();
+    settings->cols = settings->index.GetColumnsCount();
 }
 
 void GView::View::GridViewer::Instance::PaintCursorInformationWidth(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y)
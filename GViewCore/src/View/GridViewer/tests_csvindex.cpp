@@ -0,0 +1,140 @@
+#include <catch.hpp>
+#include "CSVIndex.hpp"
+#include <random>
+
+using namespace GView::View::GridViewer;
+
+// character by character parser -> the text of every cell of every row
+static std::vector<std::vector<std::string>> ParseNaive(const std::string& data, char separator)
+{
+    std::vector<std::vector<std::string>> rows;
+    std::vector<std::string> row;
+    std::string cell;
+    bool inRow = false, quoted = false, fieldStart = true;
+    for (size_t i = 0; i < data.size(); i++) {
+        const auto ch = data[i];
+        if (quoted) {
+            if (ch != '"') {
+                cell.push_back(ch);
+            } else if ((i + 1 < data.size()) && (data[i + 1] == '"')) {
+                cell.push_back('"');
+                i++;
+            } else {
+                quoted = false;
+            }
+            continue;
+        }
+        if ((ch == '\n') || (ch == '\r')) {
+            if (inRow) {
+                row.push_back(cell);
+                rows.push_back(row);
+            }
+            row.clear();
+            cell.clear();
+            inRow      = false;
+            fieldStart = true;
+            if ((ch == '\r') && (i + 1 < data.size()) && (data[i + 1] == '\n'))
+                i++;
+            continue;
+        }
+        inRow = true;
+        if (ch == separator) {
+            row.push_back(cell);
+            cell.clear();
+            fieldStart = true;
+            continue;
+        }
+        if ((ch == '"') && (fieldStart))
+            quoted = true;
+        else
+            cell.push_back(ch);
+        fieldStart = false;
+    }
+    if (inRow) {
+        row.push_back(cell);
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+static std::string CreateCSV(std::mt19937& gen, char separator, size_t size)
+{
+    static const std::vector<std::string> words = { "a", "text", "12.5", "\"quoted\"", "\"with \"\" quote\"", "\"multi\r\nline\"", "\"a,b\tc\"",
+                                                    "x\"y", "\n", "\r\n", "\r", "\n\n" };
+    std::string data;
+    while (data.size() < size) {
+        const auto& word = words[gen() % words.size()];
+        if (gen() % 100 == 0)
+            data.append(std::string(300 + gen() % 5000, 'z')); // long cell
+        data.append(word);
+        if ((word[0] != '\n') && (word[0] != '\r') && (gen() % 3 != 0))
+            data.push_back(separator);
+    }
+    return data;
+}
+
+static void RequireSameCells(const CSVIndex& index, const std::string& data, const std::vector<std::vector<std::string>>& expected)
+{
+    REQUIRE(index.GetRowsCount() == expected.size());
+    size_t columns = 0;
+    for (uint64 row = 0; row < expected.size(); row++) {
+        REQUIRE(index.GetCellsCount(row) == expected[row].size());
+        columns = std::max<>(columns, expected[row].size());
+        for (uint32 column = 0; column < expected[row].size(); column++) {
+            uint64 start, end;
+            REQUIRE(index.GetCell(row, column, start, end));
+            REQUIRE(start <= end);
+            REQUIRE(end <= data.size());
+        }
+    }
+    REQUIRE(index.GetColumnsCount() == columns);
+}
+
+TEST_CASE("CSVTokenizer", "[GridViewer]CSV")
+{
+    std::mt19937 gen(0x43535649);
+    for (auto separator : { ',', '\t', ';' }) {
+        const auto data     = CreateCSV(gen, separator, 0x30000 + gen() % 64);
+        const auto expected = ParseNaive(data, separator);
+
+        // random buffer sizes -> quotes, escaped quotes and \r\n are split between buffers
+        CSVTokenizer tokenizer;
+        CSVIndex index;
+        tokenizer.Reset(separator);
+        uint64 offset = 0;
+        while (offset < data.size()) {
+            const auto size = std::min<uint64>(1 + gen() % 3000, data.size() - offset);
+            tokenizer.Scan(BufferView(data.data() + offset, static_cast<size_t>(size)), offset, index);
+            offset += size;
+        }
+        tokenizer.Finish(offset, index);
+        RequireSameCells(index, data, expected);
+    }
+}
+
+TEST_CASE("CSVIndex", "[GridViewer]CSV")
+{
+    std::mt19937 gen(0x43535658);
+    const auto data     = "\xEF\xBB\xBF" + CreateCSV(gen, ',', 0x100000);
+    const auto expected = ParseNaive(data.substr(3), ',');
+
+    GView::Utils::DataCache cache;
+    auto memoryFile = std::make_unique<AppCUI::OS::MemoryFile>();
+    REQUIRE(memoryFile->Create(reinterpret_cast<const uint8*>(data.data()), data.size()));
+    REQUIRE(cache.Init(std::move(memoryFile), 0x10000));
+
+    CSVIndex index;
+    REQUIRE(index.Build(cache, ','));
+    RequireSameCells(index, data, expected);
+
+    // the text of the cells (without quotes & with the escaped quotes replaced)
+    std::string text;
+    for (uint64 row = 0; row < expected.size(); row++) {
+        for (uint32 column = 0; column < expected[row].size(); column++) {
+            REQUIRE(index.GetCellText(cache, row, column, text));
+            REQUIRE(text == expected[row][column]);
+        }
+    }
+    REQUIRE(index.GetCellText(cache, expected.size(), 0, text) == false);
+    REQUIRE(index.GetCellText(cache, 0, static_cast<uint32>(expected[0].size()), text) == false);
+}
@@ -111,6 +111,7 @@ void Instance::RecomputeTokenPositions()
         PrettyFormat();
     else
         ComputeOriginalPositions();
+    this->rowIndex.Build(this->tokens);
     EnsureCurrentItemIsVisible();
 }
 void Instance::UpdateTokensInformation()
@@ -725,6 +726,7 @@ void Instance::Parse()
 
     this->tokens.clear();
     this->blocks.clear();
+    this->rowIndex.Clear();
     this->selection.Clear();
 
     if (this->settings->parser)
@@ -803,9 +805,9 @@ bool Instance::RebuildTextFromTokens(TextEditor& editor)
             editor.Delete(it->start, it->end - it->start);
             continue;
         }
-        if (it->value.Len() > 0)
+        if (it->HasValue())
         {
-            if (!editor.Replace(it->start, it->end - it->start, it->value.ToStringView()))
+            if (!editor.Replace(it->start, it->end - it->start, it->GetValue()))
                 return false;
             continue;
         }
@@ -833,6 +835,7 @@ void Instance::RestoreTokensPositionsFromBackup()
         index++;
     }
     backupedTokenPositionList.clear();
+    this->rowIndex.Build(this->tokens);
 }
 
 void Instance::FillBlockSpace(Graphics::Renderer& renderer, const BlockObject& block)
@@ -1025,25 +1028,23 @@ void Instance::Paint(Graphics::Renderer& renderer)
     const int32 scroll_right  = Scroll.x + (int32) this->GetWidth() - 1;
     const int32 scroll_bottom = Scroll.y + (int32) this->GetHeight() - 1;
     uint32 idx                = 0;
+    uint32 end                = 0;
     int32 lastY               = -1;
 
-    for (auto& t : this->tokens)
+    // only the tokens from the visible rows
+    this->rowIndex.GetRange(Scroll.y, scroll_bottom, idx, end);
+    for (; idx < end; idx++)
     {
+        const auto& t = this->tokens[idx];
         // skip hidden and current token
         if ((!t.IsVisible()) || (idx == this->currentTokenIndex))
-        {
-            idx++;
             continue;
-        }
         const auto tk_right  = t.pos.x + (int32) t.pos.width - 1;
         const auto tk_bottom = t.pos.y + (int32) t.pos.height - 1;
 
         // if token not in visible screen => skip it
         if ((t.pos.x > scroll_right) || (t.pos.y > scroll_bottom) || (tk_right < Scroll.x) || (tk_bottom < Scroll.y))
-        {
-            idx++;
             continue;
-        }
         renderer.SetClipMargins(this->lineNrWidth, 0, 0, 0);
         PaintToken(renderer, t, idx);
         if (t.pos.y != lastY)
@@ -1053,7 +1054,6 @@ void Instance::Paint(Graphics::Renderer& renderer)
             renderer.WriteText(num.ToDec(t.lineNo), params);
             lastY = t.pos.y;
         }
-        idx++;
     }
     renderer.ResetClip();
     foldColumn.Paint(renderer, this->lineNrWidth - 1, this);
@@ -1152,121 +1152,77 @@ void Instance::MoveRight(bool selected, bool stopAfterFirst)
     }
     MoveToToken(lastValidIdx, selected, false);
 }
+uint32 Instance::FindClosestTokenOnRow(int32 row, int32 posX)
+{
+    uint32 idx    = 0;
+    uint32 end    = 0;
+    auto found    = Token::INVALID_INDEX;
+    auto bestDist = 0;
+    this->rowIndex.GetRowRange(row, idx, end);
+    for (; idx < end; idx++)
+    {
+        const auto& tok = this->tokens[idx];
+        if ((tok.IsVisible() == false) || (tok.pos.y != row))
+            continue;
+        auto dist = ComputeXDist(tok.pos.x, posX);
+        if ((found == Token::INVALID_INDEX) || (dist < bestDist))
+        {
+            found    = idx;
+            bestDist = dist;
+        }
+    }
+    return found;
+}
 void Instance::MoveUp(uint32 times, bool selected)
 {
     if ((noItemsVisible) || (times == 0))
         return;
     if (this->currentTokenIndex == 0)
         return;
-    uint32 idx = this->currentTokenIndex - 1;
-    auto lastY = this->tokens[this->currentTokenIndex].pos.y;
-    auto posX  = this->tokens[this->currentTokenIndex].pos.x;
+    auto row  = this->tokens[this->currentTokenIndex].pos.y;
+    auto posX = this->tokens[this->currentTokenIndex].pos.x;
     while (times > 0)
     {
-        while ((idx > 0) && (this->tokens[idx].pos.y == lastY))
-            idx--;
-
-        while ((idx > 0) && ((!this->tokens[idx].IsVisible()) || (this->tokens[idx].pos.y == lastY)))
-            idx--;
-
-        if (idx == 0)
+        auto prevRow = this->rowIndex.GetPreviousRow(row);
+        if (prevRow < 0)
         {
-            if (this->tokens[0].IsVisible())
-            {
-                if (this->tokens[idx].pos.y == lastY)
-                {
-                    // already on the first line --> move to first token
-                    MoveToToken(0, selected, false);
-                    return;
-                }
-                // otherwise do nothing --> just decrease the times count
-            }
-            else
-            {
-                // move to first visible item
-                MoveToClosestVisibleToken(0, selected);
-                return;
-            }
+            // already on the first line --> move to first token
+            MoveToClosestVisibleToken(0, selected);
+            return;
         }
-        lastY = this->tokens[idx].pos.y;
+        row = prevRow;
         times--;
     }
     // found the line that I am interested in --> now search the closest token in terms of position
-    auto found     = idx;
-    auto best_dist = ComputeXDist(this->tokens[found].pos.x, posX);
-    while ((idx > 0) && (best_dist > 0))
-    {
-        if (this->tokens[idx].IsVisible() == false)
-        {
-            idx--;
-            continue;
-        }
-        if (this->tokens[idx].pos.y != lastY)
-            break;
-        auto dist = ComputeXDist(this->tokens[idx].pos.x, posX);
-        if (dist < best_dist)
-        {
-            found     = idx;
-            best_dist = dist;
-        }
-        idx--;
-    }
-    if ((idx == 0) && (this->tokens[idx].IsVisible()))
-    {
-        // it is possible that the first token is the closest --> so test this
-        auto dist = ComputeXDist(this->tokens[idx].pos.x, posX);
-        if (dist < best_dist)
-        {
-            found     = idx;
-            best_dist = dist;
-        }
-    }
-    MoveToToken(found, selected, false);
+    auto found = FindClosestTokenOnRow(row, posX);
+    if (found != Token::INVALID_INDEX)
+        MoveToToken(found, selected, false);
 }
 void Instance::MoveDown(uint32 times, bool selected)
 {
     if ((noItemsVisible) || (times == 0))
         return;
     uint32 cnt = (uint32) this->tokens.size();
-    uint32 idx = this->currentTokenIndex + 1;
-    auto lastY = this->tokens[this->currentTokenIndex].pos.y;
-    auto posX  = this->tokens[this->currentTokenIndex].pos.x;
-    if (idx >= cnt)
+    if (this->currentTokenIndex + 1 >= cnt)
         return;
+    auto row  = this->tokens[this->currentTokenIndex].pos.y;
+    auto posX = this->tokens[this->currentTokenIndex].pos.x;
     while (times > 0)
     {
-        while ((idx < cnt) && ((!this->tokens[idx].IsVisible()) || (this->tokens[idx].pos.y == lastY)))
-            idx++;
-        if (idx >= cnt)
+        auto nextRow = this->rowIndex.GetNextRow(row);
+        if (nextRow < 0)
         {
             // already on the last line --> move to last token
             MoveToClosestVisibleToken(cnt - 1, selected);
             return;
         }
-        lastY = this->tokens[idx].pos.y;
+        row = nextRow;
         times--;
     }
     // found the line that I am interested in --> now search the closest token in terms of position
-    auto found     = idx;
-    auto best_dist = ComputeXDist(this->tokens[found].pos.x, posX);
-    while ((idx < cnt) && (best_dist > 0))
-    {
-        if (this->tokens[idx].IsVisible() == false)
-        {
-            idx++;
-            continue;
-        }
-        if (this->tokens[idx].pos.y != lastY)
-            break;
-        auto dist = ComputeXDist(this->tokens[idx].pos.x, posX);
-        if (dist < best_dist)
-        {
-            found     = idx;
-            best_dist = dist;
-        }
-        idx++;
-    }
-    MoveToToken(found, selected, false);
+    auto found = FindClosestTokenOnRow(row, posX);
+    if (found != Token::INVALID_INDEX)
+        MoveToToken(found, selected, false);
 }
 void Instance::MoveToNextSimilarToken(int32 direction)
 {
@@ -1462,10 +1418,10 @@ void Instance::ShowRefactorDialog(TokenObject& tok)
         for (auto idx = start; idx < end; idx++)
         {
             if (tokens[idx].hash == tok.hash)
-                tokens[idx].value = dlg.GetNewValue();
+                tokens[idx].GetExtraData().value = dlg.GetNewValue();
         }
         // Update the original as well
-        tok.value = dlg.GetNewValue();
+        tok.GetExtraData().value = dlg.GetNewValue();
         if (dlg.ShouldReparse())
         {
             this->Reparse(false);
@@ -1487,9 +1443,9 @@ void Instance::EditCurrentToken()
     auto& tok = this->tokens[this->currentTokenIndex];
     if (!tok.IsVisible())
         return;
-    if (tok.error.Len() > 0)
+    if (tok.HasError())
     {
-        AppCUI::Dialogs::MessageBox::ShowError("Error", tok.error);
+        AppCUI::Dialogs::MessageBox::ShowError("Error", tok.extra->error);
     }
     if (tok.dataType == TokenDataType::String)
         ShowStringOpDialog(tok);
@@ -1987,21 +1943,21 @@ void Instance::ShowFindAllDialog()
 //======================================================================[Mouse coords]========================
 uint32 Instance::MousePositionToTokenID(int x, int y)
 {
-    auto idx = 0U;
-    for (const auto& tok : this->tokens)
+    uint32 idx = 0;
+    uint32 end = 0;
+    // only the tokens that intersect the row under the mouse
+    this->rowIndex.GetRange(y + Scroll.y, y + Scroll.y, idx, end);
+    for (; idx < end; idx++)
     {
+        const auto& tok = this->tokens[idx];
         if (tok.IsVisible() == false)
-        {
-            idx++;
             continue;
-        }
         auto tokLeft   = tok.pos.x + lineNrWidth - Scroll.x;
         auto tokTop    = tok.pos.y - Scroll.y;
         auto tokRight  = tokLeft + static_cast<int32>(tok.pos.width);
         auto tokBottom = tokTop + static_cast<int32>(tok.pos.height);
         if ((x >= tokLeft) && (x < tokRight) && (y >= tokTop) && (y < tokBottom))
             return idx;
-        idx++;
     }
     return Token::INVALID_INDEX;
 }
@@ -2138,8 +2094,8 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, uint32 widt
         xPoz = this->WriteCursorInfo(r, xPoz, 0, 16, "Line:", tmp.Format("%d/%d", tok.lineNo, this->lastLineNumber));
         xPoz = this->WriteCursorInfo(r, xPoz, 0, 9, "Col:", tmp.Format("%d", tok.pos.x + 1));
         xPoz = this->WriteCursorInfo(r, xPoz, 0, 18, "Char ofs:", tmp.Format("%u", tok.start));
-        if (tok.error.Len() > 0)
-            xPoz = PrintError(tok.error, xPoz, 0, 50, r);
+        if (tok.HasError())
+            xPoz = PrintError(tok.extra->error, xPoz, 0, 50, r);
         else
             xPoz = this->PrintTokenTypeInfo(tok.type, xPoz, 0, 30, r);
         break;
@@ -2153,8 +2109,8 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, uint32 widt
         this->WriteCursorInfo(r, xPoz, 0, 18, "Char ofs: ", tmp.Format("%u", tok.start));
         xPoz = this->WriteCursorInfo(r, xPoz, 1, 18, "Tokens  : ", tmp.Format("%u", (size_t) tokens.size()));
         this->WriteCursorInfo(r, xPoz, 0, 35, "Token     : ", tok.GetText(this->text.text));
-        if (tok.error.Len() > 0)
-            xPoz = PrintError(tok.error, xPoz, 1, 35, r);
+        if (tok.HasError())
+            xPoz = PrintError(tok.extra->error, xPoz, 1, 35, r);
         else
             xPoz = this->PrintTokenTypeInfo(tok.type, xPoz, 1, 35, r);
         break;
@@ -2167,8 +2123,8 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, uint32 widt
         xPoz = this->WriteCursorInfo(r, xPoz, 2, 16, "Col : ", tmp.Format("%d", tok.pos.x + 1));
         this->WriteCursorInfo(r, xPoz, 0, 35, "Token     : ", tok.GetText(this->text.text));
         this->PrintTokenTypeInfo(tok.type, xPoz, 1, 35, r);
-        if (tok.error.Len() > 0)
-            xPoz = PrintError(tok.error, xPoz, 2, 35, r);
+        if (tok.HasError())
+            xPoz = PrintError(tok.extra->error, xPoz, 2, 35, r);
         else
             xPoz = this->PrintDataTypeInfo(tok.dataType, xPoz, 2, 35, r);
         break;
@@ -2188,8 +2144,8 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, uint32 widt
         this->WriteCursorInfo(r, xPoz, 0, 40, "Token     : ", tok.GetText(this->text.text));
         this->WriteCursorInfo(r, xPoz, 1, 40, "Original  : ", tok.GetOriginalText(this->text.text));
         this->PrintTokenTypeInfo(tok.type, xPoz, 2, 40, r);
-        if (tok.error.Len() > 0)
-            xPoz = PrintError(tok.error, xPoz, 3, 40, r);
+        if (tok.HasError())
+            xPoz = PrintError(tok.extra->error, xPoz, 3, 40, r);
         else
             xPoz = this->PrintDataTypeInfo(tok.dataType, xPoz, 3, 40, r);
 
@@ -130,11 +130,15 @@ namespace View
             uint32 width, height;
             TokenStatus status;
         };
-        struct TokenObject
+        struct TokenExtraData
         {
             UnicodeStringBuilder value;
             UnicodeStringBuilder error;
+        };
+        struct TokenObject
+        {
             uint64 hash;
+            Pointer<TokenExtraData> extra; // only for the tokens that were edited or have an error
             uint32 start, end, type;
             uint32 blockID; // for blocks
             uint32 lineNo;
@@ -198,6 +202,26 @@ namespace View
             {
                 return blockID != BlockObject::INVALID_ID;
             }
+            inline bool HasValue() const
+            {
+                return (extra) && (extra->value.Len() > 0);
+            }
+            inline bool HasError() const
+            {
+                return (extra) && (extra->error.Len() > 0);
+            }
+            inline u16string_view GetValue() const
+            {
+                if (extra)
+                    return extra->value.ToStringView();
+                return {};
+            }
+            inline TokenExtraData& GetExtraData()
+            {
+                if (!extra)
+                    extra.reset(new TokenExtraData());
+                return *extra;
+            }
             inline void SetDisableSimilartyHighlightFlag()
             {
                 pos.status = static_cast<TokenStatus>(
@@ -211,10 +235,10 @@ namespace View
                     this->hash = 0;
                     return;
                 }
-                if (this->value.Len() == 0)
+                if (!HasValue())
                     this->hash = TextParser::ComputeHash64({ text + start, (size_t) (end - start) }, ignoreCase);
                 else
-                    this->hash = TextParser::ComputeHash64(this->value.ToStringView(), ignoreCase);
+                    this->hash = TextParser::ComputeHash64(this->extra->value.ToStringView(), ignoreCase);
             }
             inline u16string_view GetOriginalText(const char16* text) const
             {
@@ -222,10 +246,10 @@ namespace View
             }
             inline u16string_view GetText(const char16* text) const
             {
-                if (this->value.Len() == 0)
+                if (!HasValue())
                     return { text + start, (size_t) (end - start) };
                 else
-                    return this->value.ToStringView();
+                    return this->extra->value.ToStringView();
             }
         };
 
@@ -290,6 +314,30 @@ namespace View
                 return BlockObject::INVALID_ID;
             }
         };
+        // Visible tokens grouped by the row (y) where they start. Tokens are laid out in order, so the ones that start on a
+        // row are (almost) a contiguous range of indexes -> painting, hit-testing and moving up/down only touch the tokens
+        // of the rows they need. Has to be rebuilt every time the token positions are recomputed.
+        class RowIndex
+        {
+            struct Row
+            {
+                uint32 first, last; // smallest and biggest index of a visible token that starts on this row
+                int32 coveredFrom;  // first row of the tallest token that covers this row (the row itself if none)
+            };
+            std::vector<Row> rows;
+
+          public:
+            void Build(const std::vector<TokenObject>& tokens);
+            void Clear();
+
+            // [start, end) contains all the tokens that intersect rows [top, bottom]
+            bool GetRange(int32 top, int32 bottom, uint32& start, uint32& end) const;
+            // [start, end) contains all the tokens that start on 'row'
+            bool GetRowRange(int32 row, uint32& start, uint32& end) const;
+            // closest row (below/above) where at least one token starts or -1 if there isn't one
+            int32 GetNextRow(int32 row) const;
+            int32 GetPreviousRow(int32 row) const;
+        };
         struct PrettyFormatLayoutManager
         {
             int x, y, lastY;
@@ -299,6 +347,7 @@ namespace View
         class Instance : public View::ViewControl
         {
             FoldColumn foldColumn;
+            RowIndex rowIndex;
             Utils::Selection selection;
             Pointer<SettingsData> settings;
             Reference<GView::Object> obj;
@@ -344,6 +393,7 @@ namespace View
             void MoveRight(bool selected, bool stopAfterFirst);
             void MoveUp(uint32 times, bool selected);
             void MoveDown(uint32 times, bool selected);
+            uint32 FindClosestTokenOnRow(int32 row, int32 posX);
             void MoveToNextSimilarToken(int32 direction);
 
             void SetFoldStatus(uint32 index, FoldStatus foldStatus, bool recursive);
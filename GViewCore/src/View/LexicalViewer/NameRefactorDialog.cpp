@@ -13,7 +13,7 @@ NameRefactorDialog::NameRefactorDialog(TokenObject& _tok, const char16* text, bo
     Factory::Label::Create(this, "Original text", "x:1,y:1,w:30");
     Factory::TextArea::Create(this, tok.GetOriginalText(text), "x:1,y:2,w:65,h:4", TextAreaFlags::Readonly | TextAreaFlags::ShowLineNumbers);
     Factory::Label::Create(this, "&New value (an empty field means using the original text)", "x:1,y:7,w:60");
-    this->txNewValue = Factory::TextField::Create(this, tok.value.ToStringView(), "x:1,y:8,w:65,h:1");
+    this->txNewValue = Factory::TextField::Create(this, tok.GetValue(), "x:1,y:8,w:65,h:1");
     this->txNewValue->SetHotKey('N');
 
     // apply methods
@@ -0,0 +1,93 @@
+#include "LexicalViewer.hpp"
+
+namespace GView::View::LexicalViewer
+{
+void RowIndex::Clear()
+{
+    this->rows.clear();
+}
+void RowIndex::Build(const std::vector<TokenObject>& tokens)
+{
+    this->rows.clear();
+    auto idx = 0U;
+    for (const auto& tok : tokens)
+    {
+        if ((tok.IsVisible()) && (tok.pos.y >= 0))
+        {
+            const auto bottom = tok.pos.y + std::max<>(1, static_cast<int32>(tok.pos.height));
+            while (static_cast<int32>(this->rows.size()) < bottom)
+            {
+                const auto y = static_cast<int32>(this->rows.size());
+                this->rows.push_back({ Token::INVALID_INDEX, Token::INVALID_INDEX, y });
+            }
+            // indexes are visited in ascending order
+            auto& row = this->rows[tok.pos.y];
+            if (row.first == Token::INVALID_INDEX)
+                row.first = idx;
+            row.last = idx;
+            for (auto y = tok.pos.y + 1; y < bottom; y++)
+                this->rows[y].coveredFrom = std::min<>(this->rows[y].coveredFrom, tok.pos.y);
+        }
+        idx++;
+    }
+}
+bool RowIndex::GetRange(int32 top, int32 bottom, uint32& start, uint32& end) const
+{
+    start  = 0;
+    end    = 0;
+    top    = std::max<>(top, 0);
+    bottom = std::min<>(bottom, static_cast<int32>(this->rows.size()) - 1);
+    if (top > bottom)
+        return false;
+    // a multi-line token that starts above 'top' can still be visible
+    auto from = top;
+    for (auto y = top; y <= bottom; y++)
+        from = std::min<>(from, this->rows[y].coveredFrom);
+
+    start = Token::INVALID_INDEX;
+    for (auto y = from; y <= bottom; y++)
+    {
+        const auto& row = this->rows[y];
+        if (row.first == Token::INVALID_INDEX)
+            continue;
+        start = std::min<>(start, row.first);
+        end   = std::max<>(end, row.last + 1);
+    }
+    if (start >= end)
+    {
+        start = end = 0;
+        return false;
+    }
+    return true;
+}
+bool RowIndex::GetRowRange(int32 row, uint32& start, uint32& end) const
+{
+    if ((row < 0) || (row >= static_cast<int32>(this->rows.size())) || (this->rows[row].first == Token::INVALID_INDEX))
+    {
+        start = end = 0;
+        return false;
+    }
+    start = this->rows[row].first;
+    end   = this->rows[row].last + 1;
+    return true;
+}
+int32 RowIndex::GetNextRow(int32 row) const
+{
+    const auto count = static_cast<int32>(this->rows.size());
+    for (auto y = std::max<>(row + 1, 0); y < count; y++)
+    {
+        if (this->rows[y].first != Token::INVALID_INDEX)
+            return y;
+    }
+    return -1;
+}
+int32 RowIndex::GetPreviousRow(int32 row) const
+{
+    for (auto y = std::min<>(row, static_cast<int32>(this->rows.size())) - 1; y >= 0; y--)
+    {
+        if (this->rows[y].first != Token::INVALID_INDEX)
+            return y;
+    }
+    return -1;
+}
+} // namespace GView::View::LexicalViewer
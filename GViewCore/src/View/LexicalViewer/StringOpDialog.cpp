@@ -115,8 +115,9 @@ void StringOpDialog::UpdateTokenValue()
         return;
     }
     // all good --> set value to token
-    tok.value.Set(output);
-    tok.error.Clear();
+    auto& extra = tok.GetExtraData();
+    extra.value.Set(output);
+    extra.error.Clear();
     Exit(Dialogs::Result::Ok);
 }
 bool StringOpDialog::OnEvent(Reference<Control> control, Event eventType, int ID)
@@ -167,13 +167,13 @@ bool Token::DisableSimilartyHighlight()
 bool Token::SetText(const ConstString& text)
 {
     CREATE_TOKENREF(false);
-    return tok.value.Set(text);
+    return tok.GetExtraData().value.Set(text);
 }
 bool Token::SetError(const ConstString& error)
 {
     CREATE_TOKENREF(false);
     tok.color = TokenColor::Error;
-    return tok.error.Set(error);
+    return tok.GetExtraData().error.Set(error);
 }
 bool Token::Delete()
 {
@@ -196,10 +196,10 @@ void TokenObject::UpdateSizes(const char16* text)
 {
     const char16* p = text + start;
     const char16* e = text + end;
-    if (this->value.Len() > 0)
+    if (HasValue())
     {
-        p = this->value.GetString();
-        e = this->value.GetString() + this->value.Len();
+        p = this->extra->value.GetString();
+        e = this->extra->value.GetString() + this->extra->value.Len();
     }
     auto nrLines = 1U;
     auto w       = 0U;
@@ -3,21 +3,26 @@
 using namespace GView::View::TextViewer;
 using namespace AppCUI::Input;
 
+constexpr uint64 DEFAULT_SPARSE_LINE_INDEX_SIZE = 0x10000000; // 256 MB
+
 void Config::Update(IniSection sect)
 {
     sect.UpdateValue("Key.WrapMethod", Key::F2, true);
+    sect.UpdateValue("Config.SparseLineIndexSize", DEFAULT_SPARSE_LINE_INDEX_SIZE, true);
 }
 void Config::Initialize()
 {
     auto ini = AppCUI::Application::GetAppSettings();
     if (ini)
     {
-        auto sect           = ini->GetSection("View.Text");
-        this->Keys.WordWrap = sect.GetValue("Key.WrapMethod").ToKey(Key::F2);
+        auto sect                 = ini->GetSection("View.Text");
+        this->Keys.WordWrap       = sect.GetValue("Key.WrapMethod").ToKey(Key::F2);
+        this->SparseLineIndexSize = sect.GetValue("Config.SparseLineIndexSize").ToUInt64(DEFAULT_SPARSE_LINE_INDEX_SIZE);
     }
     else
     {
-        this->Keys.WordWrap = Key::F2;
+        this->Keys.WordWrap       = Key::F2;
+        this->SparseLineIndexSize = DEFAULT_SPARSE_LINE_INDEX_SIZE;
     }
 
     this->Loaded = true;
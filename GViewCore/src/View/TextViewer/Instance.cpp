@@ -197,7 +197,7 @@ uint8 GetCharGroup(char16 ch)
 class DataCharacterStream
 {
     GView::Utils::DataCache& dataCache;
-    std::vector<LineInfo>& lines;
+    LineIndex& lines;
     Reference<SettingsData> settings;
     uint32 linesCount;
     uint32 charIndex;
@@ -206,17 +206,19 @@ class DataCharacterStream
     bool ConvertLine(uint32 lineNo)
     {
         CHECK(lineNo < linesCount, false, "");
-        auto buf = dataCache.Get(lines[lineNo].offset, lines[lineNo].size, false);
+        LineInfo li;
+        CHECK(lines.Get(lineNo, li), false, "");
+        auto buf = dataCache.Get(li.offset, li.size, false);
         CHECK(tempLine.Create(buf, settings), false, "");
         currentLine = lineNo;
         return true;
     }
 
   public:
-    DataCharacterStream(std::vector<LineInfo>& li, Reference<SettingsData> _settings, GView::Utils::DataCache& cache)
+    DataCharacterStream(LineIndex& li, Reference<SettingsData> _settings, GView::Utils::DataCache& cache)
         : settings(_settings), dataCache(cache), lines(li)
     {
-        linesCount  = static_cast<uint32>(li.size());
+        linesCount  = li.GetCount();
         currentLine = 0;
         charIndex   = 0;
     }
@@ -288,7 +290,8 @@ Instance::Instance(Reference<GView::Object> _obj, Settings* _settings)
     if (config.Loaded == false)
         config.Initialize();
 
-    this->lineNumberWidth = 0;
+    this->lineNumberWidth     = 0;
+    this->estimatedLinesCount = 0;
     this->SubLines.entries.reserve(256); // reserve 256 sub-lines
     this->SubLines.lineNo  = INVALID_LINE_NUMBER;
     this->ViewPort.scrollX = 0;
@@ -327,104 +330,49 @@ void Instance::RecomputeLineIndexes()
     // first --> simple estimation
     auto buf        = this->obj->GetData().Get(0, 4096, false);
     auto sz         = this->obj->GetData().GetSize();
-    auto csz        = this->obj->GetData().GetCacheSize() & 0xFFFFFFF0; // make sure that csz is odd
     auto crlf_count = (uint64) 1;
 
     for (auto ch : buf)
         if ((ch == '\n') || (ch == '\r'))
             crlf_count++;
 
-    auto estimated_count = ((crlf_count * sz) / buf.GetLength()) + 16;
+    this->estimatedLinesCount = buf.Empty() ? 0 : ((crlf_count * sz) / buf.GetLength()) + 16;
 
-    this->lines.clear();
-    this->lines.reserve(estimated_count);
+    // huge texts only keep a checkpoint every LineIndex::CHECKPOINT_LINES lines
+    const auto sparse = sz >= config.SparseLineIndexSize;
+    this->lines.Reset(this->obj->GetData(), this->settings->encoding, sparse, this->estimatedLinesCount);
 
-    uint64 offset    = this->sizeOfBOM;
-    uint64 start     = this->sizeOfBOM;
-    uint32 charCount = 0;
-    char16 lastChar  = 0;
-
-    CharacterEncoding::ExpandedCharacter ch;
-
-    while (offset < sz)
+    // the lines are indexed on a background thread --> only wait for the first screen
+    if (this->lineIndexer.Start(this->obj->GetData(), this->settings->encoding, this->sizeOfBOM, sparse))
+        this->lineIndexer.WaitForLines(MAX_LINES_TO_VIEW);
+    this->lineIndexer.Fetch(this->lines);
+    UpdateLineNumberWidth();
+}
+bool Instance::FetchLineIndexes()
+{
+    const auto previousCount = this->lines.GetCount();
+    if (!this->lineIndexer.Fetch(this->lines))
+        return false;
+    UpdateLineNumberWidth();
+    // the view port was computed with the lines known at that moment --> if it reached the last one it has to be recomputed
+    if (this->ViewPort.End.lineNo + 1 >= previousCount)
     {
-        buf = this->obj->GetData().Get(offset, csz, false);
-        if (buf.Empty())
-            return;
-        // process the buffer
-        auto* p       = buf.begin();
-        auto* e       = buf.end();
-        auto* loopEnd = buf.end();
-        if (((offset + buf.GetLength()) < sz) && (buf.GetLength() > 16))
-        {
-            // if this is a partial part of the file and it has more then 16 bytes, deduct 8 bytes to make sure that any possible conversion
-            // will be made
-            loopEnd -= 8;
-        }
-        while (p < loopEnd)
-        {
-            if (ch.FromEncoding(this->settings->encoding, p, e))
-            {
-                p += ch.Length();
-                auto chr = ch.GetChar();
-                if (((chr == '\n') && (lastChar != '\r')) || ((chr == '\r') && (lastChar != '\n')))
-                {
-                    // end of the current line
-                    lines.emplace_back(start, charCount, (uint32) (offset - start));
-                    offset += ch.Length();
-                    start     = offset;
-                    charCount = 0;
-                    lastChar  = chr;
-                    continue;
-                }
-
-                // combined CRLF or LFCR
-                if (((chr == '\n') && (lastChar == '\r')) || ((chr == '\r') && (lastChar == '\n')))
-                {
-                    // just advanced one extra char (no new line found)
-                    offset += ch.Length();
-                    start     = offset;
-                    charCount = 0;
-                    lastChar  = 0; // important as the CRLF or LFCR has ended
-                    continue;
-                }
-
-                // other character
-                lastChar = 0; // don't care
-                charCount++;
-                offset += ch.Length();
-                if (charCount > 2000)
-                {
-                    // limit line to 2000 characters
-                    lines.emplace_back(start, charCount, (uint32) (offset - start));
-                    start     = offset;
-                    charCount = 0;
-                }
-            }
-            else
-            {
-                // need to treat conversion error
-                // consider one character (binary format)
-                charCount++;
-                offset++;
-                p++;
-                if (charCount > 2000)
-                {
-                    // limit line to 2000 characters
-                    lines.emplace_back(start, charCount, (uint32) (offset - start));
-                    start     = offset;
-                    charCount = 0;
-                }
-            }
-        }
-        if (charCount > 0)
-        {
-            // last line
-            lines.emplace_back(start, charCount, (uint32) (offset - start));
-        }
+        this->ComputeViewPort(this->ViewPort.Start.lineNo, this->ViewPort.Start.subLineNo, Direction::TopToBottom);
+        this->UpdateViewPort();
     }
-
-    auto linesCount = this->lines.size() + 1;
+    return true;
+}
+void Instance::WaitForLineIndexes(uint64 offset)
+{
+    this->lineIndexer.WaitForOffset(offset);
+    FetchLineIndexes();
+}
+void Instance::UpdateLineNumberWidth()
+{
+    // while indexing, the estimation is used so that the width does not change with every new batch of lines
+    auto linesCount = static_cast<uint64>(this->lines.GetCount()) + 1;
+    if (!this->lineIndexer.IsDone())
+        linesCount = std::max<>(linesCount, this->estimatedLinesCount);
     if (linesCount < 10)
         this->lineNumberWidth = 2;
     else if (linesCount < 100)
@@ -437,24 +385,25 @@ void Instance::RecomputeLineIndexes()
         this->lineNumberWidth = 6;
     else if (linesCount < 1000000)
         this->lineNumberWidth = 7;
-    else
+    else if (linesCount < 10000000)
         this->lineNumberWidth = 8;
+    else if (linesCount < 100000000)
+        this->lineNumberWidth = 9;
+    else
+        this->lineNumberWidth = 10;
 }
 bool Instance::GetLineInfo(uint32 lineNo, LineInfo& li)
 {
-    if (lineNo >= this->lines.size())
-        return false;
-    li = this->lines[lineNo];
-    return true;
+    return this->lines.Get(lineNo, li);
 }
 LineInfo Instance::GetLineInfo(uint32 lineNo)
 {
-    const auto sz = this->lines.size();
-    if (lineNo < sz)
-        return this->lines[lineNo];
+    LineInfo li;
+    if (this->lines.Get(lineNo, li))
+        return li;
     // if its outside --> always return the last line
-    if (sz > 0)
-        return this->lines[sz - 1];
+    if (!this->lines.Empty())
+        return this->lines.GetLast();
     // otherwise return an empty line
     return LineInfo(0, 0, 0);
 }
@@ -631,10 +580,10 @@ void Instance::CommputeViewPort_NoWrap(uint32 lineNo, Direction dir)
     }
 
     ViewPort.Reset();
-    if (this->lines.empty())
+    if (this->lines.Empty())
         return;
 
-    uint32 lastLineNo = static_cast<uint32>(this->lines.size() - 1); // lines.size() will alway be bigger than 1
+    uint32 lastLineNo = this->lines.GetCount() - 1; // lines.GetCount() will alway be bigger than 1
 
     // sets the view port
     ViewPort.Start.lineNo    = start;
@@ -662,7 +611,7 @@ void Instance::CommputeViewPort_Wrap(uint32 lineNo, uint32 subLineNo, Direction
     auto h = (std::min<>(static_cast<uint32>(std::max<>(this->GetHeight(), 1)), MAX_LINES_TO_VIEW));
 
     ViewPort.Reset();
-    if (this->lines.empty())
+    if (this->lines.Empty())
         return;
     if (dir == Direction::TopToBottom)
     {
@@ -675,7 +624,7 @@ void Instance::CommputeViewPort_Wrap(uint32 lineNo, uint32 subLineNo, Direction
         auto* l                  = ViewPort.Lines;
         const auto* l_max        = l + h;
 
-        while ((l < l_max) && (start < this->lines.size()))
+        while ((l < l_max) && (start < this->lines.GetCount()))
         {
             auto lineInfo = GetLineInfo(start);
             ComputeSubLineIndexes(start);
@@ -755,14 +704,14 @@ void Instance::MoveTo(uint32 lineNo, uint32 charIndex, bool select)
     if (select)
         sidx = this->selection.BeginSelection(this->Cursor.pos);
     // sanity checks
-    if (this->lines.size() == 0)
+    if (this->lines.GetCount() == 0)
     {
         lineNo = 0;
     }
     else
     {
-        if (lineNo >= static_cast<uint32>(this->lines.size()))
-            lineNo = static_cast<uint32>(this->lines.size() - 1);
+        if (lineNo >= this->lines.GetCount())
+            lineNo = this->lines.GetCount() - 1;
     }
     LineInfo li = GetLineInfo(lineNo);
     if (charIndex >= li.charsCount)
@@ -792,8 +741,8 @@ void Instance::MoveTo(uint32 lineNo, uint32 charIndex, bool select)
 }
 void Instance::MoveToStartOfLine(uint32 lineNo, bool select)
 {
-    if (lineNo >= this->lines.size())
-        MoveToEndOfLine(static_cast<uint32>(this->lines.size() - 1), select); // last position
+    if (lineNo >= this->lines.GetCount())
+        MoveToEndOfLine(this->lines.GetCount() - 1, select); // last position
     else
         MoveTo(lineNo, 0, select);
 }
@@ -807,9 +756,10 @@ void Instance::MoveToEndOfLine(uint32 lineNo, bool select)
 }
 void Instance::MoveToEndOfFile(bool select)
 {
-    if (this->lines.empty())
+    WaitForLineIndexes(INVALID_OFFSET);
+    if (this->lines.Empty())
         return;
-    MoveTo(static_cast<uint32>(this->lines.size() - 1), 0xFFFFFFFF, select);
+    MoveTo(this->lines.GetCount() - 1, 0xFFFFFFFF, select);
 }
 void Instance::MoveLeft(bool select)
 {
@@ -847,9 +797,9 @@ void Instance::MoveToNextWord(bool select)
 }
 void Instance::MoveDown(uint32 noOfTimes, bool select)
 {
-    if (this->lines.size() == 0)
+    if (this->lines.GetCount() == 0)
         return; // safety check
-    uint32 lastLine = static_cast<uint32>(this->lines.size() - 1);
+    uint32 lastLine = this->lines.GetCount() - 1;
     if (HasWordWrap())
     {
         auto lineNo = this->Cursor.lineNo;
@@ -1255,6 +1205,7 @@ void Instance::Paint(Graphics::Renderer& renderer)
     auto lineNo      = INVALID_LINE_NUMBER;
     const auto focus = this->HasFocus();
 
+    FetchLineIndexes();
     if (this->ViewPort.linesCount == 0)
     {
         this->ComputeViewPort(0, 0, Direction::TopToBottom);
@@ -1291,6 +1242,7 @@ bool Instance::OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar)
 }
 bool Instance::OnKeyEvent(AppCUI::Input::Key keyCode, char16 characterCode)
 {
+    FetchLineIndexes();
     switch (keyCode)
     {
     case Key::Left:
@@ -1420,11 +1372,13 @@ bool Instance::OnEvent(Reference<Control>, Event eventType, int ID)
 }
 void Instance::OnUpdateScrollBars()
 {
-    if (this->lines.size() > 0)
+    if (this->lines.GetCount() > 0)
     {
-        const auto& fistLine = this->lines[0];
-        const auto& lastLine = this->lines[this->lines.size() - 1];
-        const auto maxOfs    = lastLine.offset + lastLine.size;
+        const auto fistLine  = GetLineInfo(0);
+        const auto& lastLine = this->lines.GetLast();
+        auto maxOfs          = lastLine.offset + lastLine.size;
+        if (!this->lineIndexer.IsDone())
+            maxOfs = std::max<>(maxOfs, this->obj->GetData().GetSize()); // not indexed yet
         auto pos             = std::max<>(this->Cursor.pos, fistLine.offset);
         this->UpdateVScrollBar(std::min<>(pos, maxOfs), maxOfs);
     }
@@ -1444,14 +1398,8 @@ void Instance::SetWrapMethod(WrapMethod method)
 }
 bool Instance::GoTo(uint64 offset)
 {
-    auto lineNo = 0U;
-    for (lineNo = 0U; lineNo < this->lines.size(); lineNo++)
-    {
-        if (offset < this->lines[lineNo].offset)
-            break;
-    }
-    if (lineNo > 0)
-        lineNo--;
+    WaitForLineIndexes(offset);
+    auto lineNo = this->lines.OffsetToLine(offset);
     auto li     = GetLineInfo(lineNo);
     auto cIndex = 0U;
     CharacterStream cs(this->obj->GetData().Get(li.offset, li.size, false), 0, this->settings.ToReference());
@@ -1470,7 +1418,8 @@ bool Instance::Select(uint64 offset, uint64 size)
 }
 bool Instance::ShowGoToDialog()
 {
-    GoToDialog dlg(this->Cursor.pos, this->obj->GetData().GetSize(), this->Cursor.lineNo + 1U, static_cast<uint32>(this->lines.size()));
+    WaitForLineIndexes(INVALID_OFFSET); // the dialog needs the number of lines
+    GoToDialog dlg(this->Cursor.pos, this->obj->GetData().GetSize(), this->Cursor.lineNo + 1U, this->lines.GetCount());
     if (dlg.Show() == Dialogs::Result::Ok)
     {
         if (dlg.ShouldGoToLine())
@@ -1671,7 +1620,8 @@ int Instance::PrintSelectionInfo(uint32 selectionID, int x, int y, uint32 width,
 void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, uint32 width, uint32 height)
 {
     LocalString<128> tmp;
-    auto xPoz = 0;
+    auto xPoz              = 0;
+    const auto linesSuffix = this->lineIndexer.IsDone() ? "" : "+"; // still indexing
     if (height == 1)
     {
         xPoz = PrintSelectionInfo(0, 0, 0, 16, r);
@@ -1681,7 +1631,7 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, uint32 widt
             xPoz = PrintSelectionInfo(2, xPoz, 0, 16, r);
             xPoz = PrintSelectionInfo(3, xPoz, 0, 16, r);
         }
-        xPoz = this->WriteCursorInfo(r, xPoz, 0, 20, "Line:", tmp.Format("%d/%d", Cursor.lineNo + 1, (uint32) lines.size()));
+        xPoz = this->WriteCursorInfo(r, xPoz, 0, 20, "Line:", tmp.Format("%d/%d%s", Cursor.lineNo + 1, lines.GetCount(), linesSuffix));
         xPoz = this->WriteCursorInfo(r, xPoz, 0, 10, "Col:", tmp.Format("%d", Cursor.charIndex + 1));
         xPoz = this->WriteCursorInfo(r, xPoz, 0, 20, "File ofs: ", tmp.Format("%llu", Cursor.pos));
     }
@@ -1691,7 +1641,7 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, uint32 widt
         xPoz = PrintSelectionInfo(2, 0, 1, 16, r);
         PrintSelectionInfo(1, xPoz, 0, 16, r);
         xPoz = PrintSelectionInfo(3, xPoz, 1, 16, r);
-        this->WriteCursorInfo(r, xPoz, 0, 20, "Line:", tmp.Format("%d/%d", Cursor.lineNo + 1, (uint32) lines.size()));
+        this->WriteCursorInfo(r, xPoz, 0, 20, "Line:", tmp.Format("%d/%d%s", Cursor.lineNo + 1, lines.GetCount(), linesSuffix));
         xPoz = this->WriteCursorInfo(r, xPoz, 1, 20, "Col:", tmp.Format("%d", Cursor.charIndex + 1));
         xPoz = this->WriteCursorInfo(r, xPoz, 0, 20, "File ofs: ", tmp.Format("%llu", Cursor.pos));
     }
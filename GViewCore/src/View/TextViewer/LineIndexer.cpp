@@ -0,0 +1,491 @@
+#include "LineIndexer.hpp"
+#include "CpuFeatures.hpp"
+
+#include <bit>
+#include <cstring>
+
+#if defined(GVIEW_X86_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#    define GVIEW_LINES_SSE2
+#endif
+
+namespace GView::View::TextViewer
+{
+using namespace GView::Utils::CharacterEncoding;
+
+constexpr uint32 INVALID_BLOCK    = 0xFFFFFFFF;
+constexpr uint32 BLOCK_CHUNK_SIZE = 0x10000; // a block of lines is usually much smaller
+
+// number of bytes from [p, p + size) before the first \n or \r (or before the first byte >= 0x80 if stopOnNonAscii is set)
+static size_t SkipBytes_Scalar(const uint8* p, size_t size, bool stopOnNonAscii)
+{
+    const uint8 mask = stopOnNonAscii ? 0x80 : 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        if ((p[i] == '\n') || (p[i] == '\r') || (p[i] & mask))
+            return i;
+    }
+    return size;
+}
+
+// number of bytes from [p, p + 2 * units) before the first 16 bit unit equal to lf or cr (both in the byte order of the text)
+static size_t SkipUnits_Scalar(const uint8* p, size_t units, uint16 lf, uint16 cr)
+{
+    for (size_t i = 0; i < units; i++)
+    {
+        uint16 unit;
+        memcpy(&unit, p + i * 2, sizeof(unit));
+        if ((unit == lf) || (unit == cr))
+            return i * 2;
+    }
+    return units * 2;
+}
+
+#ifdef GVIEW_X86_SIMD
+// 64 bytes per step (the movemask of (byte & 0x80) flags the non-ASCII bytes)
+GVIEW_TARGET("avx2") static size_t SkipBytes_AVX2(const uint8* p, size_t size, bool stopOnNonAscii)
+{
+    const auto lf   = _mm256_set1_epi8('\n');
+    const auto cr   = _mm256_set1_epi8('\r');
+    const auto high = _mm256_set1_epi8(stopOnNonAscii ? static_cast<char>(0x80) : 0);
+    size_t i        = 0;
+    for (; i + 64 <= size; i += 64)
+    {
+        const auto a     = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        const auto b     = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 32));
+        const auto stopA = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(a, lf), _mm256_cmpeq_epi8(a, cr)), _mm256_and_si256(a, high));
+        const auto stopB = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(b, lf), _mm256_cmpeq_epi8(b, cr)), _mm256_and_si256(b, high));
+        const auto bits  = static_cast<uint64>(static_cast<uint32>(_mm256_movemask_epi8(stopA))) |
+                          (static_cast<uint64>(static_cast<uint32>(_mm256_movemask_epi8(stopB))) << 32);
+        if (bits)
+            return i + static_cast<size_t>(std::countr_zero(bits));
+    }
+    return i + SkipBytes_Scalar(p + i, size - i, stopOnNonAscii);
+}
+
+GVIEW_TARGET("avx2") static size_t SkipUnits_AVX2(const uint8* p, size_t units, uint16 lf, uint16 cr)
+{
+    const auto vlf = _mm256_set1_epi16(static_cast<short>(lf));
+    const auto vcr = _mm256_set1_epi16(static_cast<short>(cr));
+    const auto size = units * 2;
+    size_t i        = 0;
+    for (; i + 64 <= size; i += 64)
+    {
+        const auto a     = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        const auto b     = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 32));
+        const auto stopA = _mm256_or_si256(_mm256_cmpeq_epi16(a, vlf), _mm256_cmpeq_epi16(a, vcr));
+        const auto stopB = _mm256_or_si256(_mm256_cmpeq_epi16(b, vlf), _mm256_cmpeq_epi16(b, vcr));
+        const auto bits  = static_cast<uint64>(static_cast<uint32>(_mm256_movemask_epi8(stopA))) |
+                          (static_cast<uint64>(static_cast<uint32>(_mm256_movemask_epi8(stopB))) << 32);
+        if (bits)
+            return i + static_cast<size_t>(std::countr_zero(bits)); // both bytes of a unit are set -> already even
+    }
+    return i + SkipUnits_Scalar(p + i, (size - i) / 2, lf, cr);
+}
+#endif
+
+#ifdef GVIEW_LINES_SSE2
+static size_t SkipBytes_SSE2(const uint8* p, size_t size, bool stopOnNonAscii)
+{
+    const auto lf   = _mm_set1_epi8('\n');
+    const auto cr   = _mm_set1_epi8('\r');
+    const auto high = _mm_set1_epi8(stopOnNonAscii ? static_cast<char>(0x80) : 0);
+    size_t i        = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        const auto a     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        const auto b     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 16));
+        const auto stopA = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(a, lf), _mm_cmpeq_epi8(a, cr)), _mm_and_si128(a, high));
+        const auto stopB = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(b, lf), _mm_cmpeq_epi8(b, cr)), _mm_and_si128(b, high));
+        const auto bits  = static_cast<uint32>(_mm_movemask_epi8(stopA)) | (static_cast<uint32>(_mm_movemask_epi8(stopB)) << 16);
+        if (bits)
+            return i + static_cast<size_t>(std::countr_zero(bits));
+    }
+    return i + SkipBytes_Scalar(p + i, size - i, stopOnNonAscii);
+}
+
+static size_t SkipUnits_SSE2(const uint8* p, size_t units, uint16 lf, uint16 cr)
+{
+    const auto vlf  = _mm_set1_epi16(static_cast<short>(lf));
+    const auto vcr  = _mm_set1_epi16(static_cast<short>(cr));
+    const auto size = units * 2;
+    size_t i        = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        const auto a     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        const auto b     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 16));
+        const auto stopA = _mm_or_si128(_mm_cmpeq_epi16(a, vlf), _mm_cmpeq_epi16(a, vcr));
+        const auto stopB = _mm_or_si128(_mm_cmpeq_epi16(b, vlf), _mm_cmpeq_epi16(b, vcr));
+        const auto bits  = static_cast<uint32>(_mm_movemask_epi8(stopA)) | (static_cast<uint32>(_mm_movemask_epi8(stopB)) << 16);
+        if (bits)
+            return i + static_cast<size_t>(std::countr_zero(bits));
+    }
+    return i + SkipUnits_Scalar(p + i, (size - i) / 2, lf, cr);
+}
+#endif
+
+static size_t SkipBytes(const uint8* p, size_t size, bool stopOnNonAscii)
+{
+#ifdef GVIEW_X86_SIMD
+    if (GView::Utils::CPU::GetFeatures().avx2)
+        return SkipBytes_AVX2(p, size, stopOnNonAscii);
+#endif
+#ifdef GVIEW_LINES_SSE2
+    return SkipBytes_SSE2(p, size, stopOnNonAscii);
+#else
+    return SkipBytes_Scalar(p, size, stopOnNonAscii);
+#endif
+}
+
+static size_t SkipUnits(const uint8* p, size_t units, uint16 lf, uint16 cr)
+{
+#ifdef GVIEW_X86_SIMD
+    if (GView::Utils::CPU::GetFeatures().avx2)
+        return SkipUnits_AVX2(p, units, lf, cr);
+#endif
+#ifdef GVIEW_LINES_SSE2
+    return SkipUnits_SSE2(p, units, lf, cr);
+#else
+    return SkipUnits_Scalar(p, units, lf, cr);
+#endif
+}
+
+static uint16 MakeUnit(uint8 first, uint8 second)
+{
+    const uint8 bytes[2] = { first, second };
+    uint16 unit;
+    memcpy(&unit, bytes, sizeof(unit));
+    return unit;
+}
+
+//======================================================================[LineScanner]==================
+LineScanner::LineScanner()
+{
+    Reset(Encoding::Binary, 0);
+}
+void LineScanner::Reset(Encoding _encoding, uint64 startOffset)
+{
+    this->encoding  = _encoding;
+    this->lineStart = startOffset;
+    this->charCount = 0;
+    this->lastChar  = 0;
+}
+uint64 LineScanner::Scan(BufferView buffer, uint64 offset, bool lastBuffer, std::vector<LineInfo>& lines)
+{
+    const auto* start   = buffer.begin();
+    const auto* p       = buffer.begin();
+    const auto* e       = buffer.end();
+    const auto* loopEnd = buffer.end();
+    if ((!lastBuffer) && (buffer.GetLength() > 16))
+    {
+        // if this is a partial part of the file and it has more then 16 bytes, deduct 8 bytes to make sure that any possible conversion
+        // will be made
+        loopEnd -= 8;
+    }
+
+    const auto utf16          = (encoding == Encoding::Unicode16LE) || (encoding == Encoding::Unicode16BE);
+    const auto stopOnNonAscii = encoding == Encoding::UTF8;
+    const auto lf             = encoding == Encoding::Unicode16BE ? MakeUnit(0, '\n') : MakeUnit('\n', 0);
+    const auto cr             = encoding == Encoding::Unicode16BE ? MakeUnit(0, '\r') : MakeUnit('\r', 0);
+    ExpandedCharacter ch;
+
+    while (p < loopEnd)
+    {
+        if ((!stopOnNonAscii) || ((*p) < 0x80))
+        {
+            // skip (without decoding) the characters up to the next line break
+            const auto maxChars = static_cast<size_t>(MAX_LINE_CHARACTERS - charCount);
+            size_t skipped;
+            if (utf16)
+            {
+                skipped = SkipUnits(p, std::min<size_t>((loopEnd - p) / 2, maxChars), lf, cr);
+                charCount += static_cast<uint32>(skipped / 2);
+            }
+            else
+            {
+                skipped = SkipBytes(p, std::min<size_t>(loopEnd - p, maxChars), stopOnNonAscii);
+                charCount += static_cast<uint32>(skipped);
+            }
+            if (skipped > 0)
+            {
+                p += skipped;
+                lastChar = 0;
+                if (charCount >= MAX_LINE_CHARACTERS)
+                {
+                    const auto pos = offset + (p - start);
+                    lines.emplace_back(lineStart, charCount, static_cast<uint32>(pos - lineStart));
+                    lineStart = pos;
+                    charCount = 0;
+                }
+                continue;
+            }
+        }
+
+        // line break, non-ASCII UTF-8 character or decoding error
+        const auto pos = offset + (p - start);
+        if (ch.FromEncoding(encoding, p, e))
+        {
+            p += ch.Length();
+            const auto chr = ch.GetChar();
+            if (((chr == '\n') && (lastChar != '\r')) || ((chr == '\r') && (lastChar != '\n')))
+            {
+                // end of the current line
+                lines.emplace_back(lineStart, charCount, static_cast<uint32>(pos - lineStart));
+                lineStart = offset + (p - start);
+                charCount = 0;
+                lastChar  = chr;
+                continue;
+            }
+            // combined CRLF or LFCR
+            if (((chr == '\n') && (lastChar == '\r')) || ((chr == '\r') && (lastChar == '\n')))
+            {
+                lineStart = offset + (p - start);
+                lastChar  = 0; // important as the CRLF or LFCR has ended
+                continue;
+            }
+        }
+        else
+        {
+            // conversion error -> consider one character (binary format)
+            p++;
+        }
+        lastChar = 0;
+        charCount++;
+        if (charCount >= MAX_LINE_CHARACTERS)
+        {
+            const auto end = offset + (p - start);
+            lines.emplace_back(lineStart, charCount, static_cast<uint32>(end - lineStart));
+            lineStart = end;
+            charCount = 0;
+        }
+    }
+    return offset + (p - start);
+}
+void LineScanner::Finish(uint64 endOffset, std::vector<LineInfo>& lines)
+{
+    if (charCount > 0)
+    {
+        lines.emplace_back(lineStart, charCount, static_cast<uint32>(endOffset - lineStart));
+        lineStart = endOffset;
+        charCount = 0;
+    }
+}
+
+//======================================================================[LineIndex]====================
+LineIndex::LineIndex()
+    : lastLine(0, 0, 0), count(0), accessTick(0), cache(nullptr), encoding(Encoding::Binary), sparse(false)
+{
+    for (auto& b : blocks)
+    {
+        b.index      = INVALID_BLOCK;
+        b.lastAccess = 0;
+    }
+}
+void LineIndex::Reset(GView::Utils::DataCache& _cache, Encoding _encoding, bool _sparse, uint64 estimatedCount)
+{
+    this->cache      = &_cache;
+    this->encoding   = _encoding;
+    this->sparse     = _sparse;
+    this->count      = 0;
+    this->lastLine   = LineInfo(0, 0, 0);
+    this->accessTick = 0;
+    lines.clear();
+    checkpoints.clear();
+    for (auto& b : blocks)
+    {
+        b.index = INVALID_BLOCK;
+        b.lines.clear();
+    }
+    if (sparse)
+        checkpoints.reserve(static_cast<size_t>(estimatedCount / CHECKPOINT_LINES + 1));
+    else
+        lines.reserve(static_cast<size_t>(estimatedCount));
+}
+void LineIndex::Append(const std::vector<LineInfo>& newLines, uint32 newCount, const LineInfo& newLastLine)
+{
+    if (sparse)
+    {
+        for (const auto& li : newLines)
+            checkpoints.push_back(li.offset);
+        // the last block might have been loaded while it was incomplete
+        for (auto& b : blocks)
+            if ((b.index != INVALID_BLOCK) && (b.index >= count / CHECKPOINT_LINES))
+                b.index = INVALID_BLOCK;
+    }
+    else
+    {
+        lines.insert(lines.end(), newLines.begin(), newLines.end());
+    }
+    this->count    = newCount;
+    this->lastLine = newLastLine;
+}
+const LineIndex::Block& LineIndex::LoadBlock(uint32 blockIndex)
+{
+    accessTick++;
+    Block* result = &blocks[0];
+    for (auto& b : blocks)
+    {
+        if (b.index == blockIndex)
+        {
+            b.lastAccess = accessTick;
+            return b;
+        }
+        if (b.lastAccess < result->lastAccess)
+            result = &b;
+    }
+
+    // rescan the lines of the block from its checkpoint (through the cache of the object)
+    const auto linesCount = std::min<uint32>(CHECKPOINT_LINES, count - blockIndex * CHECKPOINT_LINES);
+    const auto size       = cache->GetSize();
+    const auto chunkSize  = std::min<uint32>(BLOCK_CHUNK_SIZE, cache->GetCacheSize() & 0xFFFFFFF0);
+    auto offset           = checkpoints[blockIndex];
+    result->index         = blockIndex;
+    result->lastAccess    = accessTick;
+    result->lines.clear();
+    scanner.Reset(encoding, offset);
+    while ((result->lines.size() < linesCount) && (offset < size))
+    {
+        auto buf = cache->Get(offset, chunkSize, false);
+        if (buf.Empty())
+            break;
+        offset = scanner.Scan(buf, offset, offset + buf.GetLength() >= size, result->lines);
+    }
+    if (result->lines.size() < linesCount)
+        scanner.Finish(offset, result->lines);
+    result->lines.resize(linesCount, lastLine);
+    return *result;
+}
+bool LineIndex::Get(uint32 lineNo, LineInfo& li)
+{
+    if (lineNo >= count)
+        return false;
+    if (!sparse)
+    {
+        li = lines[lineNo];
+        return true;
+    }
+    li = LoadBlock(lineNo / CHECKPOINT_LINES).lines[lineNo % CHECKPOINT_LINES];
+    return true;
+}
+uint32 LineIndex::OffsetToLine(uint64 offset)
+{
+    if (count == 0)
+        return 0;
+    if (!sparse)
+    {
+        auto it = std::upper_bound(lines.begin(), lines.end(), offset, [](uint64 value, const LineInfo& li) { return value < li.offset; });
+        return it == lines.begin() ? 0U : static_cast<uint32>((it - lines.begin()) - 1);
+    }
+    // first the block (last checkpoint before the offset) and then the line inside the block
+    auto it = std::upper_bound(checkpoints.begin(), checkpoints.end(), offset);
+    if (it == checkpoints.begin())
+        return 0;
+    const auto blockIndex = static_cast<uint32>((it - checkpoints.begin()) - 1);
+    const auto& block     = LoadBlock(blockIndex).lines;
+    auto lit = std::upper_bound(block.begin(), block.end(), offset, [](uint64 value, const LineInfo& li) { return value < li.offset; });
+    return blockIndex * CHECKPOINT_LINES + static_cast<uint32>((lit - block.begin()) - 1);
+}
+
+//======================================================================[LineIndexer]==================
+LineIndexer::LineIndexer()
+    : lastLine(0, 0, 0), publishedCount(0), fetchedCount(0), startOffset(0), size(0), stop(false), running(false), done(true), sparse(false)
+{
+}
+LineIndexer::~LineIndexer()
+{
+    Stop();
+}
+bool LineIndexer::Start(GView::Utils::DataCache& cache, Encoding encoding, uint64 _startOffset, bool _sparse)
+{
+    Stop();
+    if (view.GetCacheSize() == 0)
+    {
+        CHECK(view.InitView(cache, cache.GetCacheSize()), false, "Fail to create a view for the line indexer");
+    }
+
+    published.clear();
+    scanner.Reset(encoding, _startOffset);
+    this->lastLine       = LineInfo(_startOffset, 0, 0);
+    this->publishedCount = 0;
+    this->fetchedCount   = 0;
+    this->startOffset    = _startOffset;
+    this->size           = cache.GetSize();
+    this->sparse         = _sparse;
+    this->stop           = false;
+    this->done           = false;
+    this->running        = true;
+    worker               = std::thread(&LineIndexer::Run, this);
+    return true;
+}
+void LineIndexer::Stop()
+{
+    if (!running)
+        return;
+    stop = true;
+    worker.join();
+    running = false;
+    std::lock_guard<std::mutex> l(lock);
+    done = true;
+}
+void LineIndexer::Publish(std::vector<LineInfo>& lines, bool finished)
+{
+    {
+        std::lock_guard<std::mutex> l(lock);
+        for (const auto& li : lines)
+        {
+            // in sparse mode only the first line of every block is kept
+            if ((!sparse) || ((publishedCount % LineIndex::CHECKPOINT_LINES) == 0))
+                published.push_back(li);
+            publishedCount++;
+        }
+        if (!lines.empty())
+            lastLine = lines.back();
+        done = finished;
+    }
+    cv.notify_all();
+    lines.clear();
+}
+void LineIndexer::Run()
+{
+    std::vector<LineInfo> lines;
+    const auto cacheSize = view.GetCacheSize() & 0xFFFFFFF0;
+    auto chunkSize       = std::min<uint32>(FIRST_CHUNK_SIZE, cacheSize);
+    auto offset          = startOffset;
+
+    while ((offset < size) && (!stop))
+    {
+        auto buf = view.Get(offset, chunkSize, false);
+        if (buf.Empty())
+            break;
+        offset = scanner.Scan(buf, offset, offset + buf.GetLength() >= size, lines);
+        Publish(lines, false);
+        chunkSize = cacheSize;
+    }
+    scanner.Finish(offset, lines);
+    Publish(lines, true);
+}
+bool LineIndexer::Fetch(LineIndex& index)
+{
+    std::lock_guard<std::mutex> l(lock);
+    if (publishedCount == fetchedCount)
+        return false;
+    index.Append(published, static_cast<uint32>(publishedCount), lastLine);
+    published.clear();
+    fetchedCount = publishedCount;
+    return true;
+}
+void LineIndexer::WaitForOffset(uint64 offset)
+{
+    std::unique_lock<std::mutex> l(lock);
+    cv.wait(l, [this, offset] { return done || ((offset != INVALID_OFFSET) && (lastLine.offset + lastLine.size > offset)); });
+}
+void LineIndexer::WaitForLines(uint64 count)
+{
+    std::unique_lock<std::mutex> l(lock);
+    cv.wait(l, [this, count] { return done || (publishedCount >= count); });
+}
+bool LineIndexer::IsDone()
+{
+    std::lock_guard<std::mutex> l(lock);
+    return done;
+}
+} // namespace GView::View::TextViewer
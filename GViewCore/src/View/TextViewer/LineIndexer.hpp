@@ -0,0 +1,146 @@
+#pragma once
+
+#include "Internal.hpp"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+namespace GView::View::TextViewer
+{
+struct LineInfo
+{
+    uint64 offset;
+    uint32 charsCount;
+    uint32 size;
+    LineInfo()
+    {
+    }
+    LineInfo(uint64 _offset, uint32 _charsCount, uint32 _size) : offset(_offset), charsCount(_charsCount), size(_size)
+    {
+    }
+};
+
+// Splits a text in lines (a line ends with \n, \r, \r\n or \n\r and it has at most MAX_LINE_CHARACTERS characters).
+// The text is given buffer by buffer; ASCII, UTF-8 and UTF-16 texts are scanned with vectorised compares and only the
+// line breaks and the non-ASCII UTF-8 sequences are decoded character by character.
+class LineScanner
+{
+  public:
+    static constexpr uint32 MAX_LINE_CHARACTERS = 2000;
+
+  private:
+    GView::Utils::CharacterEncoding::Encoding encoding;
+    uint64 lineStart;
+    uint32 charCount;
+    char16 lastChar;
+
+  public:
+    LineScanner();
+    void Reset(GView::Utils::CharacterEncoding::Encoding encoding, uint64 startOffset);
+
+    // buffer is located at 'offset' in the file; if it is not the last one, its last 8 bytes are left for the next
+    // buffer (a character may continue there) -> returns the offset from where the next buffer has to be read
+    uint64 Scan(BufferView buffer, uint64 offset, bool lastBuffer, std::vector<LineInfo>& lines);
+    // adds the last line (if the text does not end with a line break)
+    void Finish(uint64 endOffset, std::vector<LineInfo>& lines);
+};
+
+// Positions of the lines of a text.
+// Dense mode keeps every line. Sparse mode (for huge texts) keeps only the offset of every CHECKPOINT_LINES-th line and
+// rescans a block of lines from its checkpoint when one of its lines is requested (the last blocks are cached).
+// A line always starts after a complete line break, so the scan can be restarted from any line.
+class LineIndex
+{
+  public:
+    static constexpr uint32 CHECKPOINT_LINES = 256;
+    static constexpr uint32 CACHED_BLOCKS    = 8;
+
+  private:
+    struct Block
+    {
+        uint32 index;
+        uint64 lastAccess;
+        std::vector<LineInfo> lines;
+    };
+
+    std::vector<LineInfo> lines;     // dense mode
+    std::vector<uint64> checkpoints; // sparse mode: offset of the line (i * CHECKPOINT_LINES)
+    Block blocks[CACHED_BLOCKS];
+    LineInfo lastLine;
+    uint32 count;
+    uint64 accessTick;
+    GView::Utils::DataCache* cache;
+    LineScanner scanner;
+    GView::Utils::CharacterEncoding::Encoding encoding;
+    bool sparse;
+
+    const Block& LoadBlock(uint32 blockIndex);
+
+  public:
+    LineIndex();
+
+    void Reset(GView::Utils::DataCache& cache, GView::Utils::CharacterEncoding::Encoding encoding, bool sparse, uint64 estimatedCount);
+    // newLines are all the new lines (dense mode) or only the new checkpoint lines (sparse mode)
+    void Append(const std::vector<LineInfo>& newLines, uint32 newCount, const LineInfo& newLastLine);
+
+    bool Get(uint32 lineNo, LineInfo& li);
+    // index of the last line that starts before (or at) offset
+    uint32 OffsetToLine(uint64 offset);
+
+    inline uint32 GetCount() const
+    {
+        return count;
+    }
+    inline bool Empty() const
+    {
+        return count == 0;
+    }
+    inline const LineInfo& GetLast() const
+    {
+        return lastLine;
+    }
+    inline bool IsSparse() const
+    {
+        return sparse;
+    }
+};
+
+// Indexes the lines of an object on a background thread (through its own view of the DataCache).
+// The lines are published every chunk and the UI thread collects them with Fetch.
+class LineIndexer
+{
+    static constexpr uint32 FIRST_CHUNK_SIZE = 0x10000; // small first chunk -> the first screen is available quickly
+
+    GView::Utils::DataCache view;
+    LineScanner scanner;
+    std::thread worker;
+    std::mutex lock;
+    std::condition_variable cv;
+    std::vector<LineInfo> published; // lines (or checkpoints in sparse mode) found by the worker that were not fetched yet
+    LineInfo lastLine;               // last published line
+    uint64 publishedCount, fetchedCount;
+    uint64 startOffset, size;
+    std::atomic<bool> stop;
+    bool running, done, sparse;
+
+    void Run();
+    void Publish(std::vector<LineInfo>& lines, bool finished);
+
+  public:
+    LineIndexer();
+    ~LineIndexer();
+
+    bool Start(GView::Utils::DataCache& cache, GView::Utils::CharacterEncoding::Encoding encoding, uint64 startOffset, bool sparse);
+    void Stop();
+
+    // adds the lines published since the last call to 'index' -> true if there were new lines
+    bool Fetch(LineIndex& index);
+    // blocks until the line that contains 'offset' was published (or the entire text for INVALID_OFFSET)
+    void WaitForOffset(uint64 offset);
+    // blocks until at least 'count' lines were found (or the text is entirely indexed)
+    void WaitForLines(uint64 count);
+    bool IsDone();
+};
+} // namespace GView::View::TextViewer
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Internal.hpp"
+#include "LineIndexer.hpp"
 
 namespace GView
 {
@@ -31,23 +32,12 @@ namespace View
             {
                 AppCUI::Input::Key WordWrap;
             } Keys;
+            uint64 SparseLineIndexSize; // texts bigger than this keep only a checkpoint every LineIndex::CHECKPOINT_LINES lines
             bool Loaded;
 
             static void Update(IniSection sect);
             void Initialize();
         };
-        struct LineInfo
-        {
-            uint64 offset;
-            uint32 charsCount;
-            uint32 size;
-            LineInfo()
-            {
-            }
-            LineInfo(uint64 _offset, uint32 _charsCount, uint32 _size) : offset(_offset), charsCount(_charsCount), size(_size)
-            {
-            }
-        };
         struct SubLineInfo
         {
             uint32 relativeOffset;
@@ -72,7 +62,9 @@ namespace View
                 Text,
                 Border
             };
-            std::vector<LineInfo> lines;      
+            LineIndex lines; // lines indexed so far (the rest are published by lineIndexer)
+            LineIndexer lineIndexer;
+            uint64 estimatedLinesCount;
             Utils::Selection selection;
             Pointer<SettingsData> settings;
             Reference<GView::Object> obj;
@@ -125,6 +117,9 @@ namespace View
             void OpenCurrentSelection();
 
             void RecomputeLineIndexes();
+            bool FetchLineIndexes();
+            void WaitForLineIndexes(uint64 offset);
+            void UpdateLineNumberWidth();
             void CommputeViewPort_NoWrap(uint32 lineNo, Direction dir);
             void CommputeViewPort_Wrap(uint32 lineNo, uint32 subLineNo, Direction dir);
             void ComputeViewPort(uint32 lineNo, uint32 subLineNo, Direction dir);
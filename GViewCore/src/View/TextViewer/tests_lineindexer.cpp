@@ -0,0 +1,192 @@
+#include <catch.hpp>
+#include "LineIndexer.hpp"
+#include <random>
+
+using namespace GView::View::TextViewer;
+using namespace GView::Utils::CharacterEncoding;
+
+// decodes every character (the way the lines were computed before the vectorised scanner)
+static std::vector<LineInfo> SplitLinesNaive(const std::vector<uint8>& data, Encoding encoding, uint64 startOffset)
+{
+    std::vector<LineInfo> lines;
+    ExpandedCharacter ch;
+    const auto* p   = data.data() + startOffset;
+    const auto* e   = data.data() + data.size();
+    uint64 start    = startOffset;
+    uint32 count    = 0;
+    char16 lastChar = 0;
+    while (p < e)
+    {
+        const auto offset = static_cast<uint64>(p - data.data());
+        if (ch.FromEncoding(encoding, p, e))
+        {
+            p += ch.Length();
+            const auto chr = ch.GetChar();
+            if (((chr == '\n') && (lastChar != '\r')) || ((chr == '\r') && (lastChar != '\n')))
+            {
+                lines.emplace_back(start, count, static_cast<uint32>(offset - start));
+                start    = p - data.data();
+                count    = 0;
+                lastChar = chr;
+                continue;
+            }
+            if (((chr == '\n') && (lastChar == '\r')) || ((chr == '\r') && (lastChar == '\n')))
+            {
+                start    = p - data.data();
+                lastChar = 0;
+                continue;
+            }
+        }
+        else
+            p++;
+        lastChar = 0;
+        if (++count >= LineScanner::MAX_LINE_CHARACTERS)
+        {
+            lines.emplace_back(start, count, static_cast<uint32>((p - data.data()) - start));
+            start = p - data.data();
+            count = 0;
+        }
+    }
+    if (count > 0)
+        lines.emplace_back(start, count, static_cast<uint32>(data.size() - start));
+    return lines;
+}
+
+static std::vector<uint8> CreateText(std::mt19937& gen, Encoding encoding, size_t size)
+{
+    // short & long lines, all the line break combinations, non-ASCII characters and broken UTF-8 sequences
+    static const std::vector<std::u16string> words = { u"a", u"text", u"\r", u"\n", u"\r\n", u"\n\r", u"\n\n", u"\x00e9", u"\x4e2d\x6587" };
+    std::vector<uint8> data;
+    while (data.size() < size)
+    {
+        const auto& word = words[gen() % words.size()];
+        const auto repeat = (gen() % 50 == 0) ? 500 + gen() % 2000 : 1;
+        for (uint32 r = 0; r < repeat; r++)
+        {
+            for (auto ch : word)
+            {
+                switch (encoding)
+                {
+                case Encoding::Unicode16LE:
+                    data.push_back(ch & 0xFF);
+                    data.push_back(ch >> 8);
+                    break;
+                case Encoding::Unicode16BE:
+                    data.push_back(ch >> 8);
+                    data.push_back(ch & 0xFF);
+                    break;
+                case Encoding::UTF8:
+                    if (ch < 0x80)
+                        data.push_back(static_cast<uint8>(ch));
+                    else if (ch < 0x800)
+                    {
+                        data.push_back(static_cast<uint8>(0xC0 | (ch >> 6)));
+                        data.push_back(static_cast<uint8>(0x80 | (ch & 0x3F)));
+                    }
+                    else
+                    {
+                        data.push_back(static_cast<uint8>(0xE0 | (ch >> 12)));
+                        data.push_back(static_cast<uint8>(0x80 | ((ch >> 6) & 0x3F)));
+                        data.push_back(static_cast<uint8>(0x80 | (ch & 0x3F)));
+                    }
+                    break;
+                default:
+                    data.push_back(static_cast<uint8>(ch));
+                    break;
+                }
+            }
+        }
+        if (gen() % 200 == 0)
+            data.push_back(0xC3); // truncated sequence
+    }
+    return data;
+}
+
+static void RequireSameLines(const std::vector<LineInfo>& lines, const std::vector<LineInfo>& expected)
+{
+    REQUIRE(lines.size() == expected.size());
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+        REQUIRE(lines[i].offset == expected[i].offset);
+        REQUIRE(lines[i].size == expected[i].size);
+        REQUIRE(lines[i].charsCount == expected[i].charsCount);
+    }
+}
+
+TEST_CASE("LineScanner", "[TextViewer]Lines")
+{
+    std::mt19937 gen(0x4C494E45);
+    for (auto encoding : { Encoding::Binary, Encoding::Ascii, Encoding::UTF8, Encoding::Unicode16LE, Encoding::Unicode16BE })
+    {
+        const auto data          = CreateText(gen, encoding, 0x30000 + gen() % 64);
+        const uint64 startOffset = (encoding == Encoding::Unicode16LE) || (encoding == Encoding::Unicode16BE) ? 2 : 3;
+        const auto expected      = SplitLinesNaive(data, encoding, startOffset);
+
+        // the buffers have random sizes -> line breaks & characters are split between buffers
+        LineScanner scanner;
+        scanner.Reset(encoding, startOffset);
+        std::vector<LineInfo> lines;
+        uint64 offset = startOffset;
+        while (offset < data.size())
+        {
+            const auto size = std::min<uint64>(17 + gen() % 5000, data.size() - offset);
+            const auto last = offset + size == data.size();
+            offset          = scanner.Scan(BufferView(data.data() + offset, static_cast<size_t>(size)), offset, last, lines);
+        }
+        scanner.Finish(offset, lines);
+        RequireSameLines(lines, expected);
+    }
+}
+
+TEST_CASE("LineIndexer", "[TextViewer]Lines")
+{
+    std::mt19937 gen(0x494E4458);
+    const auto data     = CreateText(gen, Encoding::UTF8, 0x100000);
+    const auto expected = SplitLinesNaive(data, Encoding::UTF8, 0);
+
+    GView::Utils::DataCache cache;
+    auto memoryFile = std::make_unique<AppCUI::OS::MemoryFile>();
+    REQUIRE(memoryFile->Create(data.data(), data.size()));
+    REQUIRE(cache.Init(std::move(memoryFile), 0x10000));
+
+    for (auto sparse : { false, true })
+    {
+        LineIndex index;
+        index.Reset(cache, Encoding::UTF8, sparse, 0);
+        LineIndexer indexer;
+        REQUIRE(indexer.Start(cache, Encoding::UTF8, 0, sparse));
+
+        // the lines are published while the worker advances (a partial block is rescanned once it is completed)
+        LineInfo li;
+        indexer.WaitForLines(10);
+        indexer.Fetch(index);
+        REQUIRE(index.GetCount() >= 10);
+        REQUIRE(index.Get(index.GetCount() - 1, li));
+        indexer.WaitForOffset(data.size() / 2);
+        indexer.Fetch(index);
+        REQUIRE(index.GetLast().offset + index.GetLast().size > data.size() / 2);
+
+        indexer.WaitForOffset(INVALID_OFFSET);
+        REQUIRE(indexer.IsDone());
+        indexer.Fetch(index);
+        REQUIRE(index.GetCount() == expected.size());
+        REQUIRE(index.IsSparse() == sparse);
+
+        // sequential & random lookups (sparse mode rescans the blocks)
+        std::vector<LineInfo> lines;
+        for (uint32 i = 0; i < index.GetCount(); i++)
+        {
+            REQUIRE(index.Get(i, li));
+            lines.push_back(li);
+        }
+        RequireSameLines(lines, expected);
+        for (uint32 i = 0; i < 2000; i++)
+        {
+            const auto lineNo = static_cast<uint32>(gen() % expected.size());
+            REQUIRE(index.Get(lineNo, li));
+            REQUIRE(li.offset == expected[lineNo].offset);
+            REQUIRE(index.OffsetToLine(expected[lineNo].offset + gen() % std::max<uint32>(expected[lineNo].size, 1)) == lineNo);
+        }
+        REQUIRE(index.Get(index.GetCount(), li) == false);
+    }
+}
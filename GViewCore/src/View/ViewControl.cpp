@@ -41,6 +41,21 @@ void ViewControl::WriteCusorInfoLine(AppCUI::Graphics::Renderer& renderer, int x
     }
 }
 
+bool BufferColorInterface::GetColorsForRange(uint64 offset, BufferView buffer, const ViewData& vd, ColorPair* colors)
+{
+    auto data  = vd;
+    bool found = false;
+    for (size_t i = 0; i < buffer.GetLength(); i++) {
+        data.byte = buffer[i];
+        if (GetColorForByteAt(offset + i, data, colors[i])) {
+            found = true;
+        } else {
+            colors[i] = NoColorPair;
+        }
+    }
+    return found;
+}
+
 bool ViewControl::SetBufferColorProcessorCallback(Reference<BufferColorInterface>)
 {
     return false;
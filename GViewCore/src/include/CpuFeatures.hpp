@@ -0,0 +1,56 @@
+#pragma once
+
+// Runtime detection of the SIMD extensions used by the vectorised kernels from GViewCore.
+// Kernels are compiled with GVIEW_TARGET("...") and are only called if the corresponding feature was detected.
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#    define GVIEW_X86_SIMD
+#    ifdef _MSC_VER
+#        include <intrin.h>
+#        define GVIEW_TARGET(features)
+#    else
+#        include <cpuid.h>
+#        define GVIEW_TARGET(features) __attribute__((target(features)))
+#    endif
+#    include <immintrin.h>
+#endif
+
+namespace GView::Utils::CPU
+{
+struct Features {
+    bool ssse3{ false };
+    bool sse41{ false };
+    bool pclmul{ false };
+    bool avx2{ false };
+};
+
+inline Features DetectFeatures()
+{
+    Features f;
+#if defined(GVIEW_X86_SIMD)
+#    ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    f.ssse3          = (info[2] & (1 << 9)) != 0;
+    f.sse41          = (info[2] & (1 << 19)) != 0;
+    f.pclmul         = (info[2] & (1 << 1)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    __cpuidex(info, 7, 0);
+    f.avx2 = osxsave && ((info[1] & (1 << 5)) != 0) && ((_xgetbv(0) & 6) == 6);
+#    else
+    __builtin_cpu_init();
+    f.ssse3  = __builtin_cpu_supports("ssse3");
+    f.sse41  = __builtin_cpu_supports("sse4.1");
+    f.pclmul = __builtin_cpu_supports("pclmul");
+    f.avx2   = __builtin_cpu_supports("avx2");
+#    endif
+#endif
+    return f;
+}
+
+inline const Features& GetFeatures()
+{
+    static const Features features = DetectFeatures();
+    return features;
+}
+} // namespace GView::Utils::CPU
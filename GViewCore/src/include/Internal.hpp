@@ -525,6 +525,8 @@ namespace App
         GView::Type::Plugin defaultPlugin;
         GView::Utils::ErrorList errList;
         uint32 defaultCacheSize;
+        uint64 defaultCacheBudget;
+        bool useMemoryMappedFiles;
         std::filesystem::path lastOpenedFolderLocation;
 
         bool BuildMainMenus();
@@ -611,6 +613,10 @@ namespace App
         {
             return this->defaultCacheSize;
         }
+        constexpr inline uint64 GetDefaultCacheBudget() const
+        {
+            return this->defaultCacheBudget;
+        }
 
         // property interface
         virtual bool GetPropertyValue(uint32 propertyID, PropertyValue& value) override;
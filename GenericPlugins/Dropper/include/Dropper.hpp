@@ -15,6 +15,7 @@
 #include "Images.hpp"
 #include "Archives.hpp"
 #include "Cryptographic.hpp"
+#include "Prefilter.hpp"
 
 using namespace GView::Utils;
 using namespace GView::GenericPlugins::Droppper::SpecialStrings;
@@ -37,6 +38,15 @@ struct PluginClassification {
     Subcategory subcategory{};
 };
 
+// findings of an area that was scanned on its own (by a worker thread when the scan is done in parallel)
+struct AreaScan {
+    std::vector<Finding> findings;
+    std::vector<uint64> offsets;                  // offset that produced each finding
+    std::vector<std::pair<uint64, uint64>> jumps; // [from, to) -> offsets skipped by a non recursive scan after a finding
+    uint64 exit{ 0 };                             // offset where the scan stopped
+    bool completed{ false };                      // false if the scan was canceled
+};
+
 class Instance
 {
   private:
@@ -73,10 +83,27 @@ class Instance
 
     inline static constexpr uint32 SEPARATOR_LENGTH = 80;
 
+    inline static constexpr uint64 PARALLEL_SCAN_MIN_SIZE   = 0x1000000; // 16 MB -> smaller areas are scanned on the current thread
+    inline static constexpr uint64 PARALLEL_SCAN_CHUNK_SIZE = 0x400000;  // 4 MB -> minimum size of an area scanned by a worker
+
   private:
     bool ProcessBinaryDataCharset(std::string_view include, std::string_view exclude);
     bool FillCharSetMatrix(bool binaryCharSetMatrix[BINARY_CHARSET_MATRIX_SIZE], std::string_view s, bool value);
 
+    bool ScanArea(
+          const std::vector<std::unique_ptr<IDrop>*>& plugins,
+          DataCache& cache,
+          Prefilter& prefilter,
+          uint64 offset,
+          uint64 end,
+          bool recursive,
+          ArtefactIdentificationCallback identify,
+          AreaScan& result,
+          const std::function<bool(uint64)>& onProgress);
+    bool ProcessObjectsParallel(
+          const std::vector<std::unique_ptr<IDrop>*>& plugins, uint64 offset, uint64 size, bool recursive, ArtefactIdentificationCallback identify, uint32 threads);
+    void AddFinding(const Finding& finding);
+
   public:
     Instance() = default;
 
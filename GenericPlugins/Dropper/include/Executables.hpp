@@ -18,5 +18,6 @@ class MZPE : public IDrop
     virtual bool ShouldGroupInOneFile() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
+    virtual bool GetAnchors(std::vector<std::string>& anchors) const override;
 };
 } // namespace GView::GenericPlugins::Droppper::Executables
@@ -17,6 +17,7 @@ class IFrame : public IDrop
     virtual bool ShouldGroupInOneFile() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
+    virtual bool GetAnchors(std::vector<std::string>& anchors) const override;
 };
 class PHP : public IDrop
 {
@@ -31,6 +32,7 @@ class PHP : public IDrop
     virtual bool ShouldGroupInOneFile() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
+    virtual bool GetAnchors(std::vector<std::string>& anchors) const override;
 };
 class Script : public IDrop
 {
@@ -45,6 +47,7 @@ class Script : public IDrop
     virtual bool ShouldGroupInOneFile() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
+    virtual bool GetAnchors(std::vector<std::string>& anchors) const override;
 };
 class XML : public IDrop // TODO: maybe a proper XML parser
 {
@@ -59,5 +62,6 @@ class XML : public IDrop // TODO: maybe a proper XML parser
     virtual bool ShouldGroupInOneFile() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
+    virtual bool GetAnchors(std::vector<std::string>& anchors) const override;
 };
 } // namespace GView::GenericPlugins::Droppper::HtmlObjects
@@ -20,6 +20,13 @@ class IDrop
     // prechachedBufferSize -> max 8
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) = 0;
 
+    // prefilter -> byte sequences (max MAX_PRECACHED_BUFFER_SIZE bytes) out of which one must be found at the checked offset
+    // for Check to find something; return false if Check has to be called on every offset
+    virtual bool GetAnchors(std::vector<std::string>& anchors) const
+    {
+        return false;
+    }
+
     // helpers
     inline bool IsMagicU16(BufferView precachedBuffer, uint16 magic) const
     {
@@ -49,5 +56,44 @@ class IDrop
     {
         return 0x20 <= c && c <= 0x7e;
     }
+
+    // anchors helpers
+    inline static void AddAnchor(std::vector<std::string>& anchors, std::string_view value, bool caseSensitive = true)
+    {
+        std::string anchor{ value };
+        anchors.push_back(anchor);
+        if (caseSensitive) {
+            return;
+        }
+
+        // add every upper/lower case combination
+        std::vector<size_t> letters;
+        for (size_t i = 0; i < anchor.size(); i++) {
+            if (std::isalpha(static_cast<uint8>(anchor[i]))) {
+                letters.push_back(i);
+            }
+        }
+        for (uint32 mask = 1; mask < (1U << letters.size()); mask++) {
+            for (size_t j = 0; j < letters.size(); j++) {
+                const auto c          = static_cast<uint8>(value[letters[j]]);
+                anchor[letters[j]] = static_cast<char>((mask & (1U << j)) ? (std::islower(c) ? std::toupper(c) : std::tolower(c)) : c);
+            }
+            anchors.push_back(anchor);
+        }
+    }
+
+    inline static void AddAnchorRange(std::vector<std::string>& anchors, char first, char last, std::string_view suffix = {})
+    {
+        for (auto c = static_cast<uint32>(first); c <= static_cast<uint32>(last); c++) {
+            anchors.emplace_back(1, static_cast<char>(c)).append(suffix);
+        }
+    }
+
+    template <typename T>
+    inline static void AddMagic(std::vector<std::string>& anchors, T magic)
+    {
+        // same byte order as IsMagicU16/U32/U64
+        anchors.emplace_back(reinterpret_cast<const char*>(&magic), sizeof(magic));
+    }
 };
 } // namespace GView::GenericPlugins::Droppper
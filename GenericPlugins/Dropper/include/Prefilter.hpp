@@ -0,0 +1,45 @@
+#pragma once
+
+#include "IDrop.hpp"
+
+namespace GView::GenericPlugins::Droppper
+{
+// Aho-Corasick automaton built out of the anchors (literals & magics) of a set of droppers.
+// The data is scanned once, block by block, and `Next` returns the offsets where at least one dropper could find something
+// (together with the mask of those droppers) so that `Check` is no longer called on every offset.
+class Prefilter
+{
+  public:
+    static constexpr uint32 MAX_DROPPERS = 64;
+    static constexpr uint32 BLOCK_SIZE   = 0x8000;
+
+  private:
+    struct Output {
+        uint32 length;
+        uint64 droppers;
+    };
+    struct Candidate {
+        uint64 offset;
+        uint64 droppers;
+    };
+
+    std::vector<uint32> transitions;  // 256 entries for each state
+    std::vector<uint32> outputsStart; // outputs of state i -> [outputsStart[i], outputsStart[i + 1])
+    std::vector<Output> outputs;
+    uint64 alwaysCandidates{ 0 }; // droppers without anchors
+    uint32 maxAnchorLength{ 0 };
+
+    std::vector<Candidate> candidates;
+    uint64 blockStart{ 0 };
+    uint64 blockEnd{ 0 };
+
+    bool ScanBlock(DataCache& cache, uint64 offset, uint64 end);
+
+  public:
+    bool Init(const std::vector<std::unique_ptr<IDrop>*>& droppers);
+
+    // returns the first offset (>= offset) that has to be checked and the droppers that have to be called for it;
+    // if there are no candidates left in the current block, the end of the block is returned with no droppers
+    uint64 Next(DataCache& cache, uint64 offset, uint64 end, uint64& droppers);
+};
+} // namespace GView::GenericPlugins::Droppper
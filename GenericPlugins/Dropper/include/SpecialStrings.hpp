@@ -3,6 +3,7 @@
 #include "IDrop.hpp"
 
 #include <string>
+#include <atomic>
 
 namespace GView::GenericPlugins::Droppper::SpecialStrings
 {
@@ -65,6 +66,7 @@ class IpAddress : public SpecialStrings
     virtual Subcategory GetSubcategory() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
+    virtual bool GetAnchors(std::vector<std::string>& anchors) const override;
 };
 class EmailAddress : public SpecialStrings
 {
@@ -76,6 +78,7 @@ class EmailAddress : public SpecialStrings
     virtual Subcategory GetSubcategory() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
+    virtual bool GetAnchors(std::vector<std::string>& anchors) const override;
 };
 class Filepath : public SpecialStrings
 {
@@ -87,6 +90,7 @@ class Filepath : public SpecialStrings
     virtual Subcategory GetSubcategory() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
+    virtual bool GetAnchors(std::vector<std::string>& anchors) const override;
 };
 class URL : public SpecialStrings
 {
@@ -98,11 +102,12 @@ class URL : public SpecialStrings
     virtual Subcategory GetSubcategory() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
+    virtual bool GetAnchors(std::vector<std::string>& anchors) const override;
 };
 class Wallet : public SpecialStrings
 {
   public:
-    WalletType checkResult{};
+    std::atomic<WalletType> checkResult{}; // Check can be called from multiple threads
 
   public:
     Wallet(bool caseSensitive, bool unicode);
@@ -112,6 +117,7 @@ class Wallet : public SpecialStrings
     virtual Subcategory GetSubcategory() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
+    virtual bool GetAnchors(std::vector<std::string>& anchors) const override;
 
     WalletType GetLastCheckResult() const;
 };
@@ -125,6 +131,7 @@ class Registry : public SpecialStrings
     virtual Subcategory GetSubcategory() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
+    virtual bool GetAnchors(std::vector<std::string>& anchors) const override;
 };
 
 // text class has a separate purpose
@@ -144,6 +151,7 @@ class Text : public SpecialStrings
     virtual Subcategory GetSubcategory() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
+    virtual bool GetAnchors(std::vector<std::string>& anchors) const override;
 
     bool SetMinLength(uint32 minLength);
     bool SetMaxLength(uint32 maxLength);
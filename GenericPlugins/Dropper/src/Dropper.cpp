@@ -5,6 +5,9 @@
 #include <array>
 #include <regex>
 #include <charconv>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 using namespace AppCUI;
 using namespace AppCUI::Utils;
@@ -270,8 +273,7 @@ bool Instance::DropObjects(
 bool Instance::ProcessObjects(
       const std::vector<PluginClassification>& plugins, uint64 offset, uint64 size, bool recursive, ArtefactIdentificationCallback identify)
 {
-    DataCache& cache  = object->GetData();
-    uint64 nextOffset = offset;
+    DataCache& cache = object->GetData();
 
     std::vector<std::unique_ptr<IDrop>*> whitelistedPlugins;
     whitelistedPlugins.reserve(context.objectDroppers.size());
@@ -291,24 +293,198 @@ bool Instance::ProcessObjects(
         whitelistedPlugins.push_back(&context.textDropper);
     }
 
+    const auto threads = std::thread::hardware_concurrency();
+    if (threads > 1 && offset < size && size - offset >= PARALLEL_SCAN_MIN_SIZE) {
+        return ProcessObjectsParallel(whitelistedPlugins, offset, size, recursive, identify, threads);
+    }
+
+    Prefilter prefilter;
+    CHECK(prefilter.Init(whitelistedPlugins), false, "");
+
+    ProgressStatus::Init("Searching...", size);
+    LocalString<512> ls;
+    const char* format = "[%llu/%llu] bytes... Found [%u] object(s).";
+
+    uint32 objectsCount = 0;
+    for (const auto& [_, v] : context.occurences) {
+        objectsCount += v;
+    }
+
+    AreaScan scan;
+    ScanArea(whitelistedPlugins, cache, prefilter, offset, size, recursive, identify, scan, [&](uint64 current) {
+        return ProgressStatus::Update(current, ls.Format(format, current, size, objectsCount + static_cast<uint32>(scan.findings.size()))) == false;
+    });
+
+    for (const auto& f : scan.findings) {
+        AddFinding(f);
+    }
+    objectsCount += static_cast<uint32>(scan.findings.size());
+    ProgressStatus::Update(size, ls.Format(format, size, size, objectsCount));
+
+    return true;
+}
+
+bool Instance::ProcessObjectsParallel(
+      const std::vector<std::unique_ptr<IDrop>*>& plugins, uint64 offset, uint64 size, bool recursive, ArtefactIdentificationCallback identify, uint32 threads)
+{
+    DataCache& cache = object->GetData();
+
+    // ~8 chunks for each thread -> a chunk full of objects does not keep the other threads waiting
+    const uint64 chunkSize   = std::max<uint64>(PARALLEL_SCAN_CHUNK_SIZE, (size - offset) / (threads * 8ULL));
+    const uint64 chunksCount = (size - offset + chunkSize - 1) / chunkSize;
+    threads                  = static_cast<uint32>(std::min<uint64>(threads, chunksCount));
+
+    std::vector<AreaScan> chunks(chunksCount);
+    std::atomic<uint64> nextChunk{ 0 };
+    std::atomic<uint64> scanned{ 0 };
+    std::atomic<uint32> found{ 0 };
+    std::atomic<bool> stop{ false };
+
+    std::mutex lock;
+    std::condition_variable finished;
+    uint32 running = threads;
+
+    // every worker has its own view of the cache (pages & prefilter) -> it reads the whole file so no overlap is needed between chunks
+    const auto worker = [&]() {
+        DataCache view;
+        Prefilter prefilter;
+        if (view.InitView(cache, cache.GetCacheSize()) && prefilter.Init(plugins)) {
+            while (!stop) {
+                const auto index = nextChunk++;
+                if (index >= chunksCount) {
+                    break;
+                }
+
+                const auto start = offset + index * chunkSize;
+                const auto end   = std::min<uint64>(start + chunkSize, size);
+                auto last        = start;
+                ScanArea(plugins, view, prefilter, start, end, recursive, identify, chunks[index], [&](uint64 current) {
+                    scanned += current - last;
+                    last = current;
+                    return stop == false;
+                });
+                scanned += std::min<uint64>(chunks[index].exit, end) - std::min<uint64>(last, end);
+                found += static_cast<uint32>(chunks[index].findings.size());
+            }
+        } else {
+            stop = true;
+        }
+
+        std::scoped_lock<std::mutex> guard(lock);
+        running--;
+        finished.notify_one();
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (uint32 i = 0; i < threads; i++) {
+        workers.emplace_back(worker);
+    }
+
     ProgressStatus::Init("Searching...", size);
     LocalString<512> ls;
-    const char* format          = "[%llu/%llu] bytes... Found [%u] object(s).";
+    const char* format = "[%llu/%llu] bytes... Found [%u] object(s).";
+
+    uint32 objectsCount = 0;
+    for (const auto& [_, v] : context.occurences) {
+        objectsCount += v;
+    }
+
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        while (running > 0) {
+            finished.wait_for(guard, std::chrono::milliseconds(100));
+
+            const auto current = offset + scanned.load();
+            if (ProgressStatus::Update(current, ls.Format(format, current, size, objectsCount + found.load()))) {
+                stop = true;
+            }
+        }
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+
+    // stitch the chunks -> the findings are the same as the ones of a sequential scan
+    // (a non recursive scan skips the content of an object so a chunk may start inside an object found in the previous one)
+    Prefilter prefilter;
+    CHECK(prefilter.Init(plugins), false, "");
+
+    uint64 position = offset;
+    for (uint64 i = 0; i < chunksCount && position < size; i++) {
+        const auto& chunk = chunks[i];
+        const auto end    = std::min<uint64>(offset + (i + 1) * chunkSize, size);
+        if (position >= end) {
+            continue; // skipped by an object from a previous chunk
+        }
+        CHECKBK(chunk.completed, ""); // canceled
+
+        // the chunk was scanned starting from another offset -> rescan until the two scans visit the same offset
+        while (position < end) {
+            auto it = std::upper_bound(chunk.jumps.begin(), chunk.jumps.end(), position, [](uint64 o, const auto& j) { return o < j.first + 1; });
+            if (it == chunk.jumps.begin() || position >= std::prev(it)->second) {
+                break;
+            }
+
+            AreaScan rescan;
+            ScanArea(plugins, cache, prefilter, position, std::min<uint64>(std::prev(it)->second, end), recursive, identify, rescan, [](uint64) { return true; });
+            for (const auto& f : rescan.findings) {
+                AddFinding(f);
+                objectsCount++;
+            }
+            CHECKBK(rescan.exit > position, "");
+            position = rescan.exit;
+        }
+
+        if (position < end) {
+            for (uint32 j = 0; j < chunk.findings.size(); j++) {
+                if (chunk.offsets[j] >= position) {
+                    AddFinding(chunk.findings[j]);
+                    objectsCount++;
+                }
+            }
+            position = chunk.exit;
+        }
+    }
+
+    ProgressStatus::Update(size, ls.Format(format, size, size, objectsCount));
+
+    return true;
+}
+
+bool Instance::ScanArea(
+      const std::vector<std::unique_ptr<IDrop>*>& plugins,
+      DataCache& cache,
+      Prefilter& prefilter,
+      uint64 offset,
+      uint64 end,
+      bool recursive,
+      ArtefactIdentificationCallback identify,
+      AreaScan& result,
+      const std::function<bool(uint64)>& onProgress)
+{
     constexpr uint64 CHUNK_SIZE = 10000;
-    uint64 chunks               = offset / CHUNK_SIZE;
-    uint64 toUpdate             = chunks * CHUNK_SIZE;
-    while (offset < size) {
+    uint64 toUpdate             = (offset / CHUNK_SIZE) * CHUNK_SIZE;
+    uint64 nextOffset           = offset;
+
+    result.exit      = offset;
+    result.completed = false;
+    while (offset < end) {
         if (offset >= toUpdate) {
-            uint32 objectsCount = 0;
-            for (const auto& [_, v] : context.occurences) {
-                objectsCount += v;
+            if (!onProgress(offset)) {
+                result.exit = offset;
+                return true; // canceled
             }
+            toUpdate = (offset / CHUNK_SIZE + 1) * CHUNK_SIZE;
 
-            CHECKBK(ProgressStatus::Update(offset, ls.Format(format, offset, size, objectsCount)) == false, "");
-            chunks += 1;
-            toUpdate = chunks * CHUNK_SIZE;
+            cache.Get(offset, static_cast<uint32>(std::min<uint64>(cache.GetCacheSize(), end - offset)), false); // optimization
+        }
 
-            cache.Get(offset, cache.GetCacheSize(), false); // optimization
+        // skip the offsets where none of the droppers could find something
+        uint64 candidates = 0;
+        offset            = prefilter.Next(cache, offset, end, candidates);
+        if (candidates == 0) {
+            continue;
         }
 
         auto buffer = GetPrecachedBuffer(offset, cache);
@@ -323,17 +499,18 @@ bool Instance::ProcessObjects(
                 }
             }
 
-            for (auto& dropper : whitelistedPlugins) {
-                if ((*dropper)->GetPriority() != priority) {
+            for (uint32 j = 0; j < plugins.size(); j++) {
+                auto& dropper = plugins[j];
+                if ((*dropper)->GetPriority() != priority || (candidates & (1ULL << j)) == 0) {
                     continue;
                 }
 
                 Finding finding{ .dropperName = (*dropper)->GetName(), .category = (*dropper)->GetCategory(), .subcategory = (*dropper)->GetSubcategory() };
-                const auto result = (*dropper)->Check(offset, cache, buffer, finding);
+                const auto found = (*dropper)->Check(offset, cache, buffer, finding);
 
-                if (result && finding.result != Result::NotFound) {
-                    auto& f = context.findings.emplace_back(finding);
-                    context.occurences[f.dropperName] += 1;
+                if (found && finding.result != Result::NotFound) {
+                    auto& f = result.findings.emplace_back(finding);
+                    result.offsets.push_back(offset);
 
                     if (!recursive) {
                         nextOffset = f.end;
@@ -347,7 +524,6 @@ bool Instance::ProcessObjects(
                     } else {
                         f.end += 1;
                     }
-                    context.zones.Add(f.start, f.end, OBJECT_CATEGORY_COLOR_MAP.at(f.category), f.dropperName);
 
                     if (identify != nullptr) {
                         f.artefact = identify(cache, f.subcategory, f.start, f.end, f.result);
@@ -358,18 +534,25 @@ bool Instance::ProcessObjects(
             }
         }
 
+        if (nextOffset > offset + 1) {
+            result.jumps.emplace_back(offset, nextOffset);
+        }
         offset = nextOffset;
     }
 
-    uint32 objectsCount = 0;
-    for (const auto& [_, v] : context.occurences) {
-        objectsCount += v;
-    }
-    ProgressStatus::Update(size, ls.Format(format, size, size, objectsCount));
+    result.exit      = offset;
+    result.completed = true;
 
     return true;
 }
 
+void Instance::AddFinding(const Finding& finding)
+{
+    auto& f = context.findings.emplace_back(finding);
+    context.occurences[f.dropperName] += 1;
+    context.zones.Add(f.start, f.end, OBJECT_CATEGORY_COLOR_MAP.at(f.category), f.dropperName);
+}
+
 bool Instance::SetHighlighting(bool value, bool warn)
 {
     if (value) {
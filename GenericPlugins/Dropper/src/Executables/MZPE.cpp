@@ -240,4 +240,10 @@ bool MZPE::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Fin
 
     return true;
 }
+
+bool MZPE::GetAnchors(std::vector<std::string>& anchors) const
+{
+    AddMagic(anchors, IMAGE_DOS_SIGNATURE);
+    return true;
+}
 } // namespace GView::GenericPlugins::Droppper::Executables
@@ -68,4 +68,10 @@ bool IFrame::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, F
 
     return true;
 }
+
+bool IFrame::GetAnchors(std::vector<std::string>& anchors) const
+{
+    AddAnchor(anchors, START);
+    return true;
+}
 } // namespace GView::GenericPlugins::Droppper::HtmlObjects
@@ -68,4 +68,10 @@ bool PHP::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Find
 
     return true;
 }
+
+bool PHP::GetAnchors(std::vector<std::string>& anchors) const
+{
+    AddAnchor(anchors, START);
+    return true;
+}
 } // namespace GView::GenericPlugins::Droppper::HtmlObjects
@@ -68,4 +68,10 @@ bool Script::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, F
 
     return true;
 }
+
+bool Script::GetAnchors(std::vector<std::string>& anchors) const
+{
+    AddAnchor(anchors, START);
+    return true;
+}
 } // namespace GView::GenericPlugins::Droppper::HtmlObjects
@@ -108,4 +108,10 @@ bool XML::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Find
 
     return true;
 }
+
+bool XML::GetAnchors(std::vector<std::string>& anchors) const
+{
+    AddAnchor(anchors, START);
+    return true;
+}
 } // namespace GView::GenericPlugins::Droppper::HtmlObjects
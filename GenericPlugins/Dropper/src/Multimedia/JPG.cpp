@@ -70,4 +70,10 @@ bool JPG::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Find
     return true;
 }
 
+bool JPG::GetAnchors(std::vector<std::string>& anchors) const
+{
+    AddMagic(anchors, IMAGE_JPG_MAGIC_SOI);
+    return true;
+}
+
 }
\ No newline at end of file
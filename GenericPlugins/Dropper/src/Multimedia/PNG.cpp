@@ -62,4 +62,10 @@ bool PNG::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Find
     return true;
 }
 
+bool PNG::GetAnchors(std::vector<std::string>& anchors) const
+{
+    AddMagic(anchors, IMAGE_PNG_MAGIC);
+    return true;
+}
+
 } // namespace GView::GenericPlugins::Droppper::Images
@@ -0,0 +1,183 @@
+#include "Prefilter.hpp"
+
+#include <queue>
+
+namespace GView::GenericPlugins::Droppper
+{
+constexpr uint32 INVALID_STATE = 0xFFFFFFFF;
+
+static void AddOutput(std::vector<std::vector<std::pair<uint32, uint64>>>& stateOutputs, uint32 state, uint32 length, uint64 droppers)
+{
+    for (auto& [l, d] : stateOutputs[state]) {
+        if (l == length) {
+            d |= droppers;
+            return;
+        }
+    }
+    stateOutputs[state].emplace_back(length, droppers);
+}
+
+bool Prefilter::Init(const std::vector<std::unique_ptr<IDrop>*>& droppers)
+{
+    CHECK(droppers.size() <= MAX_DROPPERS, false, "");
+
+    transitions.assign(256, INVALID_STATE);
+    outputsStart.clear();
+    outputs.clear();
+    candidates.clear();
+    alwaysCandidates = 0;
+    maxAnchorLength  = 0;
+    blockStart       = 0;
+    blockEnd         = 0;
+
+    // build the trie
+    std::vector<std::vector<std::pair<uint32, uint64>>> stateOutputs(1);
+    std::vector<std::string> anchors;
+    for (uint32 i = 0; i < droppers.size(); i++) {
+        const auto mask = 1ULL << i;
+
+        anchors.clear();
+        if (!(*droppers[i])->GetAnchors(anchors) || anchors.empty()) {
+            alwaysCandidates |= mask;
+            continue;
+        }
+
+        for (const auto& anchor : anchors) {
+            if (anchor.empty()) {
+                alwaysCandidates |= mask;
+                break;
+            }
+
+            // Check only sees MAX_PRECACHED_BUFFER_SIZE bytes -> a shorter anchor only adds candidates
+            const auto length = std::min<uint32>(static_cast<uint32>(anchor.size()), MAX_PRECACHED_BUFFER_SIZE);
+            uint32 state      = 0;
+            for (uint32 j = 0; j < length; j++) {
+                auto& next = transitions[(static_cast<size_t>(state) << 8) | static_cast<uint8>(anchor[j])];
+                if (next == INVALID_STATE) {
+                    next = static_cast<uint32>(stateOutputs.size());
+                    stateOutputs.emplace_back();
+                    transitions.resize(transitions.size() + 256, INVALID_STATE);
+                }
+                state = transitions[(static_cast<size_t>(state) << 8) | static_cast<uint8>(anchor[j])];
+            }
+            AddOutput(stateOutputs, state, length, mask);
+            maxAnchorLength = std::max<>(maxAnchorLength, length);
+        }
+    }
+
+    // failure links (breadth first) -> complete transitions table & outputs of the suffixes
+    std::vector<uint32> fail(stateOutputs.size(), 0);
+    std::queue<uint32> states;
+    for (uint32 c = 0; c < 256; c++) {
+        auto& next = transitions[c];
+        if (next == INVALID_STATE) {
+            next = 0;
+        } else {
+            states.push(next);
+        }
+    }
+    while (!states.empty()) {
+        const auto state = states.front();
+        states.pop();
+
+        for (const auto& [length, mask] : stateOutputs[fail[state]]) {
+            AddOutput(stateOutputs, state, length, mask);
+        }
+
+        for (uint32 c = 0; c < 256; c++) {
+            auto& next                = transitions[(static_cast<size_t>(state) << 8) | c];
+            const auto failTransition = transitions[(static_cast<size_t>(fail[state]) << 8) | c];
+            if (next == INVALID_STATE) {
+                next = failTransition;
+            } else {
+                fail[next] = failTransition;
+                states.push(next);
+            }
+        }
+    }
+
+    outputsStart.reserve(stateOutputs.size() + 1);
+    for (const auto& so : stateOutputs) {
+        outputsStart.push_back(static_cast<uint32>(outputs.size()));
+        for (const auto& [length, mask] : so) {
+            outputs.push_back({ length, mask });
+        }
+    }
+    outputsStart.push_back(static_cast<uint32>(outputs.size()));
+
+    return true;
+}
+
+bool Prefilter::ScanBlock(DataCache& cache, uint64 offset, uint64 end)
+{
+    const auto fileSize = cache.GetSize();
+
+    candidates.clear();
+    blockStart = offset;
+    blockEnd   = std::min<>({ end, fileSize, offset + BLOCK_SIZE });
+    CHECK(blockStart < blockEnd, false, "");
+
+    if (maxAnchorLength == 0) {
+        return true; // only droppers without anchors
+    }
+
+    // anchors starting in this block may end in the next one
+    const auto dataEnd = std::min<uint64>(fileSize, blockEnd + maxAnchorLength - 1);
+    auto buffer        = cache.Get(blockStart, static_cast<uint32>(dataEnd - blockStart), false);
+    CHECK(buffer.GetLength() > 0, false, "");
+    if (blockStart + buffer.GetLength() < dataEnd) {
+        const auto length = buffer.GetLength() > maxAnchorLength - 1 ? buffer.GetLength() - (maxAnchorLength - 1) : 1;
+        blockEnd          = std::min<uint64>(blockEnd, blockStart + length);
+    }
+
+    const auto* data = buffer.GetData();
+    const auto size  = buffer.GetLength();
+    uint32 state     = 0;
+    for (size_t i = 0; i < size; i++) {
+        state = transitions[(static_cast<size_t>(state) << 8) | data[i]];
+        for (auto o = outputsStart[state]; o < outputsStart[state + 1]; o++) {
+            const auto start = blockStart + i + 1 - outputs[o].length;
+            if (start < blockEnd) {
+                candidates.push_back({ start, outputs[o].droppers });
+            }
+        }
+    }
+
+    // matches are reported in the order they end -> sort by start & merge the droppers
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) { return a.offset < b.offset; });
+    size_t count = 0;
+    for (const auto& c : candidates) {
+        if (count > 0 && candidates[count - 1].offset == c.offset) {
+            candidates[count - 1].droppers |= c.droppers;
+        } else {
+            candidates[count++] = c;
+        }
+    }
+    candidates.resize(count);
+
+    return true;
+}
+
+uint64 Prefilter::Next(DataCache& cache, uint64 offset, uint64 end, uint64& droppers)
+{
+    droppers = 0;
+    if (offset < blockStart || offset >= blockEnd) {
+        if (!ScanBlock(cache, offset, end)) {
+            blockStart = blockEnd = 0;
+            return end;
+        }
+    }
+
+    auto it = std::lower_bound(candidates.begin(), candidates.end(), offset, [](const Candidate& c, uint64 o) { return c.offset < o; });
+    if (alwaysCandidates != 0) {
+        droppers = alwaysCandidates | ((it != candidates.end() && it->offset == offset) ? it->droppers : 0);
+        return offset;
+    }
+    if (it == candidates.end()) {
+        return blockEnd;
+    }
+
+    droppers = it->droppers;
+    return it->offset;
+}
+} // namespace GView::GenericPlugins::Droppper
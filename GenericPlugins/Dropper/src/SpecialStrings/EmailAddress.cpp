@@ -57,4 +57,16 @@ bool EmailAddress::Check(uint64 offset, DataCache& file, BufferView precachedBuf
 
     return true;
 }
+
+bool EmailAddress::GetAnchors(std::vector<std::string>& anchors) const
+{
+    AddAnchorRange(anchors, 'a', 'z');
+    AddAnchorRange(anchors, '0', '9');
+    AddAnchor(anchors, "_");
+    AddAnchor(anchors, ".");
+    if (!caseSensitive) {
+        AddAnchorRange(anchors, 'A', 'Z');
+    }
+    return true;
+}
 } // namespace GView::GenericPlugins::Droppper::SpecialStrings
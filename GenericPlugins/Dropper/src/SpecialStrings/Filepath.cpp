@@ -59,4 +59,20 @@ bool Filepath::Check(uint64 offset, DataCache& file, BufferView precachedBuffer,
 
     return true;
 }
+
+bool Filepath::GetAnchors(std::vector<std::string>& anchors) const
+{
+    // drive letter paths
+    AddAnchorRange(anchors, 'a', 'z', ":\\");
+    AddAnchorRange(anchors, 'A', 'Z', ":\\");
+    // relative & absolute unix paths
+    AddAnchor(anchors, "/");
+    AddAnchor(anchors, "..");
+    if (unicode) {
+        AddAnchorRange(anchors, 'a', 'z', std::string_view{ "\0", 1 });
+        AddAnchorRange(anchors, 'A', 'Z', std::string_view{ "\0", 1 });
+        AddAnchor(anchors, std::string_view{ ".\0.\0", 4 });
+    }
+    return true;
+}
 } // namespace GView::GenericPlugins::Droppper::SpecialStrings
@@ -59,4 +59,10 @@ bool IpAddress::Check(uint64 offset, DataCache& file, BufferView precachedBuffer
 
     return true;
 }
+
+bool IpAddress::GetAnchors(std::vector<std::string>& anchors) const
+{
+    AddAnchorRange(anchors, '0', '9'); // both ascii and unicode addresses start with a digit
+    return true;
+}
 } // namespace GView::GenericPlugins::Droppper::SpecialStrings
@@ -61,4 +61,13 @@ bool Registry::Check(uint64 offset, DataCache& file, BufferView precachedBuffer,
 
     return true;
 }
+
+bool Registry::GetAnchors(std::vector<std::string>& anchors) const
+{
+    AddAnchor(anchors, "HK", caseSensitive);
+    if (unicode) {
+        AddAnchor(anchors, std::string_view{ "H\0K\0", 4 }, caseSensitive);
+    }
+    return true;
+}
 } // namespace GView::GenericPlugins::Droppper::SpecialStrings
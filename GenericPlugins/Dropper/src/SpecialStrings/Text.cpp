@@ -83,6 +83,16 @@ bool Text::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Fin
     return true;
 }
 
+bool Text::GetAnchors(std::vector<std::string>& anchors) const
+{
+    for (uint32 c = 0x21; c <= 0x7E; c++) {
+        if (this->stringsCharSetMatrix[c]) {
+            anchors.emplace_back(1, static_cast<char>(c));
+        }
+    }
+    return true;
+}
+
 bool Text::SetMaxLength(uint32 maxLength)
 {
     CHECK(this->minLength < maxLength, false, "");
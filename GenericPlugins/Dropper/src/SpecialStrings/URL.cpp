@@ -59,4 +59,15 @@ bool URL::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Find
 
     return true;
 }
+
+bool URL::GetAnchors(std::vector<std::string>& anchors) const
+{
+    AddAnchor(anchors, "http", caseSensitive);
+    AddAnchor(anchors, "www.", caseSensitive);
+    if (unicode) {
+        AddAnchor(anchors, std::string_view{ "h\0t\0t\0p\0", 8 }, caseSensitive);
+        AddAnchor(anchors, std::string_view{ "w\0w\0w\0.\0", 8 }, caseSensitive);
+    }
+    return true;
+}
 } // namespace GView::GenericPlugins::Droppper::SpecialStrings
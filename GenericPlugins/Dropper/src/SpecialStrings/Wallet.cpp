@@ -105,6 +105,17 @@ bool Wallet::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, F
     return true;
 }
 
+bool Wallet::GetAnchors(std::vector<std::string>& anchors) const
+{
+    // only the bitcoin prefixes have the same length as the 4 bytes magic from Check
+    AddAnchor(anchors, Bitcoin_P2WPKH_MAGIC);
+    AddAnchor(anchors, Bitcoin_P2TR_MAGIC);
+    if (unicode) {
+        AddAnchor(anchors, std::string_view{ "b\0c", 3 });
+    }
+    return true;
+}
+
 WalletType Wallet::GetLastCheckResult() const
 {
     return this->checkResult;
@@ -2,6 +2,8 @@
 
 #include "GView.hpp"
 
+#include <atomic>
+
 namespace GView::GenericPlugins::EntropyVisualizer
 {
 static const SpecialChars BLOCK_SPECIAL_CHARACTER                   = SpecialChars::Block75;
@@ -23,6 +25,50 @@ static const uint32 COMBO_BOX_ITEM_RENYI_ENTROPY             = 1;
 static const uint32 COMBO_BOX_ITEM_SHANNON_ENTROPY_DATA_TYPE = 2;
 static const uint32 COMBO_BOX_ITEM_EMBEDDED_OBJECTS          = 3;
 
+// Shannon & Renyi entropy of the whole object for every block size that is a power of 2 (one level for each size).
+// The finest level is computed on a worker pool (every worker owns a view of the cache and a range of blocks) and every
+// other level is derived by merging the histograms of two blocks from the level below, so the data is read only once and
+// changing the block size / the entropy type is just a lookup.
+class EntropyPyramid
+{
+  public:
+    static constexpr uint32 MAX_BASE_BLOCKS = 1 << 18;            // the finest level is coarser than MINIMUM_BLOCK_SIZE for big objects
+    static constexpr uint64 MAX_BLOCK_SIZE  = 1ULL << 31;         // the counters of a histogram are 32 bit
+    static constexpr uint64 TASK_SIZE       = 4ULL * 1024 * 1024; // bytes processed by a worker at once
+    static constexpr uint32 WEIGHTS_COUNT   = 1 << 16;
+
+  private:
+    struct Level {
+        std::vector<float> shannon;
+        std::vector<float> renyi;
+    };
+
+    std::vector<Level> levels;
+    std::vector<double> shannonWeights; // c * log2(c) for the small counts of a byte
+    std::vector<double> renyiWeights;   // c ^ alpha for the small counts of a byte
+    uint64 size{ 0 };
+    uint32 baseBlockSize{ 0 };
+    double alpha{ 0.0 };
+
+    bool ComputeBlock(
+          Utils::DataCache& cache,
+          uint32 level,
+          uint64 index,
+          Entropy::Histogram& histogram,
+          const std::atomic<bool>& stop,
+          std::atomic<uint64>& processed);
+    void SetBlock(uint32 level, uint64 index, const Entropy::Histogram& histogram);
+
+  public:
+    bool Build(Utils::DataCache& cache, double alpha);
+    inline bool IsBuilt(bool renyi, double alpha) const
+    {
+        return levels.empty() == false && (renyi == false || this->alpha == alpha);
+    }
+    // nullptr if blockSize is not one of the levels
+    const std::vector<float>* GetLevel(uint64 blockSize, bool renyi) const;
+};
+
 enum class EntropyType {
   Shannon = 0,
   ShannonDataType = 1,
@@ -46,6 +92,8 @@ class Plugin : public Window
     uint32 blockSize  = MINIMUM_BLOCK_SIZE;
     double renyiAlpha = 0.5;
 
+    EntropyPyramid pyramid;
+
   private:
     void ResizeLegendCanvas();
     static Color ShannonEntropyValueToColor(int32 value);
@@ -0,0 +1,190 @@
+#include "EntropyVisualizer.hpp"
+
+#include <math.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace GView::GenericPlugins::EntropyVisualizer
+{
+using namespace GView::Utils;
+
+bool EntropyPyramid::Build(DataCache& cache, double alpha)
+{
+    levels.clear();
+    this->size  = cache.GetSize();
+    this->alpha = alpha;
+    CHECK(size > 0, false, "");
+
+    // evaluating the entropy of every block of every level is more expensive than counting the bytes
+    // -> the per count terms (log2 / pow) are computed once
+    shannonWeights.resize(WEIGHTS_COUNT);
+    renyiWeights.resize(WEIGHTS_COUNT);
+    for (uint32 i = 0; i < WEIGHTS_COUNT; i++) {
+        shannonWeights[i] = i > 0 ? i * log2(i) : 0.0;
+        renyiWeights[i]   = i > 0 ? pow(i, alpha) : 0.0;
+    }
+
+    baseBlockSize = MINIMUM_BLOCK_SIZE;
+    while (size / baseBlockSize > MAX_BASE_BLOCKS) {
+        baseBlockSize *= 2;
+    }
+    for (uint64 blockSize = baseBlockSize; blockSize <= MAX_BLOCK_SIZE; blockSize *= 2) {
+        const auto blocksCount = (size + blockSize - 1) / blockSize;
+        auto& level            = levels.emplace_back();
+        level.shannon.resize(blocksCount);
+        level.renyi.resize(blocksCount);
+        if (blocksCount == 1) {
+            break;
+        }
+    }
+
+    // a task is a block of the first level that covers TASK_SIZE bytes (its histogram is built from the levels below)
+    uint32 taskLevel = 0;
+    while (taskLevel + 1 < levels.size() && (static_cast<uint64>(baseBlockSize) << taskLevel) < TASK_SIZE) {
+        taskLevel++;
+    }
+    const uint64 tasksCount = levels[taskLevel].shannon.size();
+    const auto threads      = static_cast<uint32>(std::min<uint64>(std::max<uint32>(std::thread::hardware_concurrency(), 1), tasksCount));
+
+    std::vector<Entropy::Histogram> histograms(tasksCount);
+    std::atomic<uint64> nextTask{ 0 };
+    std::atomic<uint64> processed{ 0 };
+    std::atomic<bool> stop{ false };
+
+    std::mutex lock;
+    std::condition_variable finished;
+    uint32 running = threads;
+
+    const auto worker = [&]() {
+        DataCache view;
+        if (view.InitView(cache, cache.GetCacheSize())) {
+            while (!stop) {
+                const auto index = nextTask++;
+                if (index >= tasksCount) {
+                    break;
+                }
+                if (!ComputeBlock(view, taskLevel, index, histograms[index], stop, processed)) {
+                    stop = true;
+                }
+            }
+        } else {
+            stop = true;
+        }
+
+        std::scoped_lock<std::mutex> guard(lock);
+        running--;
+        finished.notify_one();
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (uint32 i = 0; i < threads; i++) {
+        workers.emplace_back(worker);
+    }
+
+    ProgressStatus::Init("Computing entropy...", size);
+    LocalString<128> ls;
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        while (running > 0) {
+            finished.wait_for(guard, std::chrono::milliseconds(100));
+
+            const auto current = processed.load();
+            if (ProgressStatus::Update(current, ls.Format("[%llu/%llu] bytes...", current, size))) {
+                stop = true;
+            }
+        }
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+
+    if (stop || processed != size) {
+        levels.clear(); // canceled or the data could not be read
+        RETURNERROR(false, "Entropy computation was not completed!");
+    }
+
+    // the levels above the tasks merge the histograms of the tasks
+    for (uint32 level = taskLevel + 1; level < levels.size(); level++) {
+        const auto blocksCount = levels[level].shannon.size();
+        for (uint64 i = 0; i < blocksCount; i++) {
+            histograms[i] = histograms[i * 2];
+            if (i * 2 + 1 < histograms.size()) {
+                histograms[i].Add(histograms[i * 2 + 1]);
+            }
+            SetBlock(level, i, histograms[i]);
+        }
+        histograms.resize(blocksCount);
+    }
+
+    return true;
+}
+
+bool EntropyPyramid::ComputeBlock(
+      DataCache& cache, uint32 level, uint64 index, Entropy::Histogram& histogram, const std::atomic<bool>& stop, std::atomic<uint64>& processed)
+{
+    if (level == 0) {
+        CHECK(stop == false, false, "");
+        histogram.Clear();
+
+        auto offset    = index * baseBlockSize;
+        const auto end = std::min<uint64>(offset + baseBlockSize, size);
+        while (offset < end) {
+            const auto buffer = cache.Get(offset, static_cast<uint32>(std::min<uint64>(end - offset, cache.GetCacheSize())), false);
+            CHECK(buffer.GetLength() > 0, false, "");
+            histogram.Add(buffer);
+            offset += buffer.GetLength();
+        }
+        processed += histogram.total;
+    } else {
+        CHECK(ComputeBlock(cache, level - 1, index * 2, histogram, stop, processed), false, "");
+        if (index * 2 + 1 < levels[level - 1].shannon.size()) {
+            Entropy::Histogram right;
+            CHECK(ComputeBlock(cache, level - 1, index * 2 + 1, right, stop, processed), false, "");
+            histogram.Add(right);
+        }
+    }
+
+    SetBlock(level, index, histogram);
+    return true;
+}
+
+void EntropyPyramid::SetBlock(uint32 level, uint64 index, const Entropy::Histogram& histogram)
+{
+    if (histogram.total == 0) {
+        levels[level].shannon[index] = 0.0f;
+        levels[level].renyi[index]   = 0.0f;
+        return;
+    }
+
+    // H = log2(n) - sum(c * log2(c)) / n
+    // H_alpha = (log2(sum(c ^ alpha)) - alpha * log2(n)) / (1 - alpha)
+    double shannonSum = 0.0;
+    double renyiSum   = 0.0;
+    for (auto c : histogram.counts) {
+        if (c < WEIGHTS_COUNT) {
+            shannonSum += shannonWeights[c];
+            renyiSum += renyiWeights[c];
+        } else {
+            shannonSum += c * log2(c);
+            renyiSum += pow(c, alpha);
+        }
+    }
+
+    const auto total             = static_cast<double>(histogram.total);
+    const auto shannon           = log2(total) - shannonSum / total;
+    levels[level].shannon[index] = static_cast<float>(shannon);
+    levels[level].renyi[index]   = static_cast<float>(alpha == 1.0 ? shannon : (log2(renyiSum) - alpha * log2(total)) / (1.0 - alpha));
+}
+
+const std::vector<float>* EntropyPyramid::GetLevel(uint64 blockSize, bool renyi) const
+{
+    for (uint32 i = 0; i < levels.size(); i++) {
+        if ((static_cast<uint64>(baseBlockSize) << i) == blockSize) {
+            return renyi ? &levels[i].renyi : &levels[i].shannon;
+        }
+    }
+    return nullptr;
+}
+} // namespace GView::GenericPlugins::EntropyVisualizer
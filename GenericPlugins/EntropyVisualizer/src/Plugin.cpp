@@ -137,10 +137,21 @@ bool Plugin::DrawEntropy(EntropyType type)
     CHECK(this->canvasEntropy.IsValid(), false, "");
     auto canvas = this->canvasEntropy->GetCanvas();
 
-    auto& cache              = object->GetData();
-    const auto size          = cache.GetSize();
-    const auto epsilon       = ComputeEpsilon(this->blockSize);
-    const uint32 blocksCount = static_cast<uint32>(size / this->blockSize + 1);
+    auto& cache        = object->GetData();
+    const auto size    = cache.GetSize();
+    const auto epsilon = ComputeEpsilon(this->blockSize);
+    const bool renyi   = type == EntropyType::Renyi;
+
+    // the pyramid has every power of 2 block size (computed once) -> other block sizes are computed on the spot
+    if (size > 0 && !this->pyramid.IsBuilt(renyi, this->renyiAlpha)) {
+        CHECK(this->pyramid.Build(cache, this->renyiAlpha), false, "");
+    }
+    const auto* level = this->pyramid.GetLevel(this->blockSize, renyi);
+    std::vector<double> computed;
+    if (level == nullptr) {
+        CHECK(GView::Entropy::ComputeBlocks(cache, 0, size, this->blockSize, computed, renyi ? this->renyiAlpha : 1.0), false, "");
+    }
+    const uint32 blocksCount = static_cast<uint32>(level != nullptr ? level->size() : computed.size());
 
     uint32 x         = 0;
     uint32 y         = 0;
@@ -151,18 +162,7 @@ bool Plugin::DrawEntropy(EntropyType type)
     canvas->ClearEntireSurface('X', color);
 
     for (uint32 i = 0; i < blocksCount; i++) {
-        auto bf    = cache.Get(i * static_cast<uint64>(this->blockSize), this->blockSize, false);
-        auto value = 0.0;
-        switch (type) {
-        case EntropyType::Shannon:
-        case EntropyType::ShannonDataType:
-            value = GView::Entropy::ShannonEntropy(bf);
-            break;
-        case EntropyType::Renyi:
-            value = GView::Entropy::RenyiEntropy(bf, this->renyiAlpha);
-        default:
-            break;
-        }
+        const auto value = level != nullptr ? static_cast<double>((*level)[i]) : computed[i];
 
         auto fColor = Color::Black;
         switch (type) {
@@ -389,17 +389,7 @@ bool Plugin::DrawEmbeddedObjectsLegend()
 
 std::optional<GView::Utils::Zone> Plugin::IsOffsetInZone(const GView::Utils::ZonesList& zones, uint64 offset) const
 {
-    const auto zonesNo = zones.GetCount();
-    for (uint32 i = 0; i < zonesNo; i++) {
-        const auto zone = zones.GetZone(i);
-        if (zone.has_value()) {
-            if (offset >= zone->interval.low && offset <= zone->interval.high) {
-                return zone;
-            }
-        }
-    }
-
-    return std::nullopt;
+    return zones.OffsetToZone(offset);
 }
 
 void Plugin::OnAfterResize(int, int)
@@ -476,7 +466,7 @@ bool Plugin::OnEvent(Reference<Control> sender, Event eventType, int controlID)
             this->blockSize = this->blockSizeSelector->GetValue();
             return drawSelectedEntropyType();
         } else if (sender == this->alphaSelector.ToBase<Control>()) {
-            this->renyiAlpha = this->alphaSelector->GetValue() / 10;
+            this->renyiAlpha = this->alphaSelector->GetValue() / 10.0;
             return drawSelectedEntropyType();
         }
         break;
@@ -615,154 +615,19 @@ static bool ComputeHash(
 
     ProgressStatus::Init("Computing...", objectSize);
 
-    Adler32 adler32{};
-    CRC16 crc16{};
-    CRC32 crc32JAMCRC0{};
-    CRC32 crc32JAMCRC{};
-    CRC64 crc64ECMA182{};
-    CRC64 crc64WE{};
-    OpenSSLHash md5(OpenSSLHashKind::Md5);
-    OpenSSLHash blake2s256(OpenSSLHashKind::Blake2s256);
-    OpenSSLHash blake2b512(OpenSSLHashKind::Blake2b512);
-    OpenSSLHash sha1(OpenSSLHashKind::Sha1);
-    OpenSSLHash sha224(OpenSSLHashKind::Sha224);
-    OpenSSLHash sha256(OpenSSLHashKind::Sha256);
-    OpenSSLHash sha384(OpenSSLHashKind::Sha384);
-    OpenSSLHash sha512(OpenSSLHashKind::Sha512);
-    OpenSSLHash sha512_224(OpenSSLHashKind::Sha512_224);
-    OpenSSLHash sha512_256(OpenSSLHashKind::Sha512_256);
-    OpenSSLHash sha3_224(OpenSSLHashKind::Sha3_224);
-    OpenSSLHash sha3_256(OpenSSLHashKind::Sha3_256);
-    OpenSSLHash sha3_384(OpenSSLHashKind::Sha3_384);
-    OpenSSLHash sha3_512(OpenSSLHashKind::Sha3_512);
-    OpenSSLHash shake128(OpenSSLHashKind::Shake128);
-    OpenSSLHash shake256(OpenSSLHashKind::Shake256);
-
-    for (const auto& hash : hashList)
+    // every selected hash is computed on its own worker thread, the data is read only once
+    MultiHash multiHash;
+    for (auto i = 0U; i < hashList.size(); i++)
     {
-        switch (static_cast<Hashes>(hashFlags & static_cast<uint32>(hash)))
+        const auto hash = hashList[i];
+        if ((hash == Hashes::None) || ((hashFlags & static_cast<uint32>(hash)) == 0))
         {
-        case Hashes::Adler32:
-            CHECK(adler32.Init(), false, "");
-            break;
-        case Hashes::CRC16:
-            CHECK(crc16.Init(), false, "");
-            break;
-        case Hashes::CRC32_JAMCRC_0:
-            CHECK(crc32JAMCRC0.Init(CRC32Type::JAMCRC_0), false, "");
-            break;
-        case Hashes::CRC32_JAMCRC:
-            CHECK(crc32JAMCRC.Init(CRC32Type::JAMCRC), false, "");
-            break;
-        case Hashes::CRC64_ECMA_182:
-            CHECK(crc64ECMA182.Init(CRC64Type::ECMA_182), false, "");
-            break;
-        case Hashes::CRC64_WE:
-            CHECK(crc64WE.Init(CRC64Type::WE), false, "");
-            break;
-        case Hashes::MD5:
-        case Hashes::BLAKE2S256:
-        case Hashes::BLAKE2B512:
-        case Hashes::SHA1:
-        case Hashes::SHA224:
-        case Hashes::SHA256:
-        case Hashes::SHA384:
-        case Hashes::SHA512:
-        case Hashes::SHA512_224:
-        case Hashes::SHA512_256:
-        case Hashes::SHA3_224:
-        case Hashes::SHA3_256:
-        case Hashes::SHA3_384:
-        case Hashes::SHA3_512:
-        case Hashes::SHAKE128:
-        case Hashes::SHAKE256:
-            /* openssl */
-            break;
-        default:
-            break;
+            continue;
         }
+        // hashList and HashKind share the same order
+        CHECK(multiHash.Add(static_cast<HashKind>(i)), false, "");
     }
 
-    const auto UpdateHashOnBuffer = [&](const Buffer& buffer)
-    {
-        for (const auto& hash : hashList)
-        {
-            switch (static_cast<Hashes>(hashFlags & static_cast<uint32>(hash)))
-            {
-            case Hashes::Adler32:
-                CHECK(adler32.Update(buffer), false, "");
-                break;
-            case Hashes::CRC16:
-                CHECK(crc16.Update(buffer), false, "");
-                break;
-            case Hashes::CRC32_JAMCRC_0:
-                CHECK(crc32JAMCRC0.Update(buffer), false, "");
-                break;
-            case Hashes::CRC32_JAMCRC:
-                CHECK(crc32JAMCRC.Update(buffer), false, "");
-                break;
-            case Hashes::CRC64_ECMA_182:
-                CHECK(crc64ECMA182.Update(buffer), false, "");
-                break;
-            case Hashes::CRC64_WE:
-                CHECK(crc64WE.Update(buffer), false, "");
-                break;
-            case Hashes::MD5:
-                CHECK(md5.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::BLAKE2S256:
-                CHECK(blake2s256.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::BLAKE2B512:
-                CHECK(blake2b512.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA1:
-                CHECK(sha1.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA224:
-                CHECK(sha224.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA256:
-                CHECK(sha256.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA384:
-                CHECK(sha384.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA512:
-                CHECK(sha512.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA512_224:
-                CHECK(sha512_224.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA512_256:
-                CHECK(sha512_256.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA3_224:
-                CHECK(sha3_224.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA3_256:
-                CHECK(sha3_256.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA3_384:
-                CHECK(sha3_384.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA3_512:
-                CHECK(sha3_512.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHAKE128:
-                CHECK(shake128.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHAKE256:
-                CHECK(shake256.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            default:
-                break;
-            }
-        }
-
-        return true;
-    };
-
     LocalString<512> ls;
 
     const char* format = "Reading [0x%.8llX/0x%.8llX] bytes...";
@@ -771,25 +636,18 @@ static bool ComputeHash(
         format = "[0x%.16llX/0x%.16llX] bytes...";
     }
 
-    const auto block = object->GetData().GetCacheSize();
-
+    auto processed = 0ULL;
     const auto UpdateHashOnBlock = [&](uint64 offset, uint64 left)
     {
-        do
-        {
-            CHECK(ProgressStatus::Update(offset, ls.Format(format, offset, objectSize)) == false, false, "");
-
-            const auto sizeToRead = (left >= block ? block : left);
-            left -= (left >= block ? block : left);
-
-            const Buffer buffer = object->GetData().CopyToBuffer(offset, static_cast<uint32>(sizeToRead), true);
-            CHECK(buffer.IsValid(), false, "");
-
-            CHECK(UpdateHashOnBuffer(buffer), false, "");
-
-            offset += sizeToRead;
-        } while (left > 0);
-
+        const auto base = processed;
+        CHECK(multiHash.Update(
+                    object->GetData(),
+                    offset,
+                    left,
+                    [&](uint64 done) { return ProgressStatus::Update(base + done, ls.Format(format, base + done, objectSize)) == false; }),
+              false,
+              "");
+        processed += left;
         return true;
     };
 
@@ -809,96 +667,14 @@ static bool ComputeHash(
         }
     }
 
-    NumericFormatter nf;
-    for (const auto& hash : hashList)
+    CHECK(multiHash.Final(), false, "");
+
+    for (auto i = 0U; i < static_cast<uint32>(HashKind::Count); i++)
     {
-        const auto flag = static_cast<Hashes>(hashFlags & static_cast<uint32>(hash));
-        switch (flag)
+        const auto kind = static_cast<HashKind>(i);
+        if (multiHash.IsSelected(kind))
         {
-        case Hashes::Adler32:
-            outputs.emplace(std::pair{ Adler32::GetName(), adler32.GetHexValue() });
-            break;
-        case Hashes::CRC16:
-            outputs.emplace(std::pair{ CRC16::GetName(), crc16.GetHexValue() });
-            break;
-        case Hashes::CRC32_JAMCRC_0:
-            outputs.emplace(std::pair{ CRC32::GetName(CRC32Type::JAMCRC_0), crc32JAMCRC0.GetHexValue() });
-            break;
-        case Hashes::CRC32_JAMCRC:
-            outputs.emplace(std::pair{ CRC32::GetName(CRC32Type::JAMCRC), crc32JAMCRC.GetHexValue() });
-            break;
-        case Hashes::CRC64_ECMA_182:
-            outputs.emplace(std::pair{ CRC64::GetName(CRC64Type::ECMA_182), crc64ECMA182.GetHexValue() });
-            break;
-        case Hashes::CRC64_WE:
-            outputs.emplace(std::pair{ CRC64::GetName(CRC64Type::WE), crc64WE.GetHexValue() });
-            break;
-        case Hashes::MD5:
-            md5.Final();
-            outputs.emplace(std::pair{ "MD5", md5.GetHexValue() });
-            break;
-        case Hashes::BLAKE2S256:
-            blake2s256.Final();
-            outputs.emplace(std::pair{ "BLAKE2S256", blake2s256.GetHexValue() });
-            break;
-        case Hashes::BLAKE2B512:
-            blake2b512.Final();
-            outputs.emplace(std::pair{ "BLAKE2B512", blake2b512.GetHexValue() });
-            break;
-        case Hashes::SHA1:
-            sha1.Final();
-            outputs.emplace(std::pair{ "SHA1", sha1.GetHexValue() });
-            break;
-        case Hashes::SHA224:
-            sha224.Final();
-            outputs.emplace(std::pair{ "SHA224", sha224.GetHexValue() });
-            break;
-        case Hashes::SHA256:
-            sha256.Final();
-            outputs.emplace(std::pair{ "SHA256", sha256.GetHexValue() });
-            break;
-        case Hashes::SHA384:
-            sha384.Final();
-            outputs.emplace(std::pair{ "SHA384", sha384.GetHexValue() });
-            break;
-        case Hashes::SHA512:
-            sha512.Final();
-            outputs.emplace(std::pair{ "SHA512", sha512.GetHexValue() });
-            break;
-        case Hashes::SHA512_224:
-            sha512_224.Final();
-            outputs.emplace(std::pair{ "SHA512_224", sha512_224.GetHexValue() });
-            break;
-        case Hashes::SHA512_256:
-            sha512_256.Final();
-            outputs.emplace(std::pair{ "SHA512_256", sha512_256.GetHexValue() });
-            break;
-        case Hashes::SHA3_224:
-            sha3_224.Final();
-            outputs.emplace(std::pair{ "SHA3_224", sha3_224.GetHexValue() });
-            break;
-        case Hashes::SHA3_256:
-            sha3_256.Final();
-            outputs.emplace(std::pair{ "SHA3_256", sha3_256.GetHexValue() });
-            break;
-        case Hashes::SHA3_384:
-            sha3_384.Final();
-            outputs.emplace(std::pair{ "SHA3_384", sha3_384.GetHexValue() });
-            break;
-        case Hashes::SHA3_512:
-            sha3_384.Final();
-            outputs.emplace(std::pair{ "SHA3_512", sha3_512.GetHexValue() });
-            break;
-        case Hashes::SHAKE128:
-            shake128.Final();
-            outputs.emplace(std::pair{ "SHAKE128", shake128.GetHexValue() });
-            break;
-        case Hashes::SHAKE256:
-            shake256.Final();
-            outputs.emplace(std::pair{ "SHAKE256", shake256.GetHexValue() });
-            break;
-        default:
-            break;
+            outputs.emplace(std::pair{ MultiHash::GetName(kind), multiHash.GetHexValue(kind) });
         }
     }
 
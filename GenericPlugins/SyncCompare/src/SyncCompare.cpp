@@ -276,6 +276,57 @@ bool Plugin::GetColorForByteAt(uint64 offset, const ViewData& vd, ColorPair& cp)
     return false;
 }
 
+bool Plugin::GetColorsForRange(uint64 offset, BufferView buffer, const ViewData& vd, ColorPair* colors)
+{
+    auto desktop         = AppCUI::Application::GetDesktop();
+    const auto windowsNo = desktop->GetChildrenCount();
+    CHECK(windowsNo > 1, false, "");
+    CHECK(vd.viewStartOffset <= offset, false, "");
+    const auto deltaOffset = offset - vd.viewStartOffset;
+
+    // the same range from every window is copied once (instead of asking every window for every byte)
+    std::vector<Buffer> ranges;
+    ranges.reserve(windowsNo);
+    for (uint32 i = 0; i < windowsNo; i++)
+    {
+        auto window    = desktop->GetChild(i);
+        auto interface = window.ToObjectRef<GView::View::WindowInterface>();
+        auto& data     = interface->GetObject()->GetData();
+
+        ViewData viewData{}; // we assume that current view is what we want (buffer view)
+        CHECK(interface->GetCurrentView()->GetViewData(viewData, GView::Utils::INVALID_OFFSET), false, "");
+
+        ranges.push_back(data.CopyToBuffer(viewData.viewStartOffset + deltaOffset, static_cast<uint32>(buffer.GetLength()), false));
+    }
+
+    bool found = false;
+    for (size_t i = 0; i < buffer.GetLength(); i++)
+    {
+        // same rules as GetColorForByteAt: all windows have the byte -> complete, at least 2 windows have it -> partial
+        const auto byte = buffer[i];
+        uint32 equal    = 0;
+        for (const auto& r : ranges)
+        {
+            if (i < r.GetLength() && r.GetData()[i] == byte)
+                equal++;
+        }
+
+        colors[i] = NoColorPair;
+        if (equal == windowsNo)
+        {
+            colors[i] = MATCH_COMPLETE;
+            found     = true;
+        }
+        else if (equal >= 2)
+        {
+            colors[i] = MATCH_PARTIAL;
+            found     = true;
+        }
+    }
+
+    return found;
+}
+
 bool Plugin::GenerateActionOnMove(Reference<Control> sender, int64 deltaStartView, const ViewData& vd)
 {
     CHECK(deltaStartView != 0, false, "");
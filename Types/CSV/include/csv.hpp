@@ -23,6 +23,7 @@ namespace Type
             unsigned int columnsNo{ 0 };
             unsigned int rowsNo{ 0 };
             char separator[2]{""};
+            GView::View::BufferViewer::LineZonesProvider lineZones;
 
             uint64_t panelsMask{ 0 };
 
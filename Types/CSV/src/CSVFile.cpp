@@ -38,58 +38,9 @@ bool GView::Type::CSV::CSVFile::HasPanel(Panels::IDs id)
 
 void GView::Type::CSV::CSVFile::UpdateBufferViewZones(GView::View::BufferViewer::Settings& settings)
 {
-    const auto color = ColorPair{ Color::Gray, Color::Transparent };
-
-    const auto oSize = obj->GetData().GetSize();
-    const auto cSize = obj->GetData().GetCacheSize();
-
-    auto oSizeProcessed = 0ULL;
-    auto currentLine    = 0ULL;
-
-    do
-    {
-        const auto buf = obj->GetData().Get(oSizeProcessed, static_cast<uint32>(cSize), false);
-        const std::string_view data{ reinterpret_cast<const char*>(buf.GetData()), buf.GetLength() };
-
-        const auto nPos = data.find_first_of('\n', 0);
-        const auto rPos = data.find_first_of('\r', 0);
-
-        const auto oldOSizeProcessed = oSizeProcessed;
-
-        if (nPos < rPos)
-        {
-            if (nPos + 1 < data.size() && data[nPos + 1] == '\r')
-            {
-                oSizeProcessed += nPos + 2;
-            }
-            else
-            {
-                oSizeProcessed += nPos + 1;
-            }
-        }
-        else if (nPos > rPos)
-        {
-            if (rPos + 1 < data.size() && data[rPos + 1] == '\n')
-            {
-                oSizeProcessed += rPos + 2;
-            }
-            else
-            {
-                oSizeProcessed += rPos + 1;
-            }
-        }
-        else // last line EOF
-        {
-            settings.AddZone(oldOSizeProcessed, oSize - oldOSizeProcessed, color, std::to_string(currentLine));
-            currentLine++;
-            break;
-        }
-
-        settings.AddZone(oldOSizeProcessed, oSizeProcessed - oldOSizeProcessed, color, std::to_string(currentLine));
-
-        currentLine++;
-
-    } while (oSizeProcessed < oSize);
+    // one zone per line, computed only when the view needs it
+    lineZones.Init(obj->GetData(), ColorPair{ Color::Gray, Color::Transparent });
+    settings.SetZonesProvider(&lineZones);
 }
 
 void GView::Type::CSV::CSVFile::UpdateGrid(GView::View::GridViewer::Settings& settings)
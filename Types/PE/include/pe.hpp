@@ -1215,6 +1215,7 @@ namespace Type
                 bool FindExecutedCode();
 
                 bool GetColorForByteAt(uint64 offset, const GView::View::ViewData& vd, ColorPair& cp) override;
+                bool GetColorsForRange(uint64 offset, BufferView buffer, const GView::View::ViewData& vd, ColorPair* colors) override;
             };
         } // namespace Commands
     }     // namespace PE
@@ -195,6 +195,26 @@ bool AreaHighlighter::GetColorForByteAt(uint64 offset, const GView::View::ViewDa
     return false;
 }
 
+bool AreaHighlighter::GetColorsForRange(uint64 offset, BufferView buffer, const GView::View::ViewData&, ColorPair* colors)
+{
+    const auto end = offset + buffer.GetLength();
+    std::fill(colors, colors + buffer.GetLength(), NoColorPair);
+
+    bool found = false;
+    for (const auto& [k, v] : addresses)
+    {
+        const auto s = std::max<uint64>(k, offset);
+        const auto e = std::min<uint64>(v, end);
+        if (s < e)
+        {
+            std::fill(colors + (s - offset), colors + (e - offset), HIGHLIGHTED_AREA);
+            found = true;
+        }
+    }
+
+    return found;
+}
+
 bool AreaHighlighter::OnEvent(Reference<Control>, Event evnt, int controlID)
 {
     switch (evnt)
@@ -143,6 +143,8 @@ void CreateDissasmView(Reference<GView::View::WindowInterface> win, Reference<PE
                 DissasmViewer::DisassemblyLanguage language = pe->hdr64 ? DissasmViewer::DisassemblyLanguage::x64 : DissasmViewer::DisassemblyLanguage::x86;
 
                 settings.AddDisassemblyZone(pe->sect[tr].PointerToRawData, pe->sect[tr].SizeOfRawData, entryPoint, language);
+                for (const auto& e : pe->exp)
+                    settings.AddCodeEntryPoint(pe->RVAToFA(e.RVA));
                 break;
             }
         }